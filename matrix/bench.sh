@@ -0,0 +1,10 @@
+#!/bin/bash
+
+set -e
+
+BENCHMARK=${1:-storage}
+
+g++ -std=c++17 -O2 -pthread $CXXFLAGS -I./ bench/$BENCHMARK.cpp src/*.cpp -o matrix_bench
+./matrix_bench "${@:2}"
+
+rm matrix_bench
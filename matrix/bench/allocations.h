@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+
+// Replaces the global allocation functions to count allocations. Include from exactly one
+// file of a benchmark binary.
+namespace bench {
+
+    inline std::atomic<size_t> allocationCounter{0};
+
+    inline size_t allocations() {
+        return allocationCounter.load(std::memory_order_relaxed);
+    }
+
+    // Allocations made by one call of f.
+    template<class F>
+    size_t allocationsPerRun(F &&f) {
+        size_t before = allocations();
+        f();
+        return allocations() - before;
+    }
+
+    inline void *countedAllocate(size_t size, size_t alignment) {
+        allocationCounter.fetch_add(1, std::memory_order_relaxed);
+        void *ptr = nullptr;
+        if (alignment <= alignof(std::max_align_t)) {
+            ptr = std::malloc(size == 0 ? 1 : size);
+        } else if (posix_memalign(&ptr, alignment, size == 0 ? 1 : size) != 0) {
+            ptr = nullptr;
+        }
+        if (ptr == nullptr) {
+            throw std::bad_alloc();
+        }
+        return ptr;
+    }
+
+}// namespace bench
+
+
+void *operator new(size_t size) {
+    return bench::countedAllocate(size, alignof(std::max_align_t));
+}
+
+void *operator new[](size_t size) {
+    return bench::countedAllocate(size, alignof(std::max_align_t));
+}
+
+void *operator new(size_t size, std::align_val_t alignment) {
+    return bench::countedAllocate(size, size_t(alignment));
+}
+
+void *operator new[](size_t size, std::align_val_t alignment) {
+    return bench::countedAllocate(size, size_t(alignment));
+}
+
+void operator delete(void *ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, size_t, std::align_val_t) noexcept {
+    std::free(ptr);
+}
@@ -0,0 +1,98 @@
+#include "bench/bench.h"
+#include "src/fixed_matrix.h"
+#include "src/kernels.h"
+#include "src/matrix.h"
+#include "src/matrix_batch.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+
+using task::FixedMatrix;
+using task::Matrix;
+using task::MatrixBatch;
+using task::SimdLevel;
+
+
+const size_t BATCH = 4096;
+
+
+template<size_t N>
+FixedMatrix<double, N, N> randomFixed() {
+    static std::mt19937 rand(42);
+    std::uniform_real_distribution<double> dist{-10., 10.};
+    FixedMatrix<double, N, N> temp;
+    for (size_t i = 0; i < N * N; ++i) {
+        temp.data()[i] = dist(rand);
+    }
+    return temp;
+}
+
+template<size_t N>
+void run() {
+    std::vector<FixedMatrix<double, N, N>> fixed;
+    std::vector<Matrix> dynamic;
+    MatrixBatch a(BATCH, N, N), b(BATCH, N, N);
+    for (size_t i = 0; i < BATCH; ++i) {
+        fixed.push_back(randomFixed<N>());
+        dynamic.push_back(fixed.back().toMatrix());
+        a.setMatrix(i, dynamic.back());
+        b.setMatrix((i + 1) % BATCH, dynamic.back());
+    }
+
+    bench::printLatencyRow("Matrix det", N, bench::secondsPerRun([&] {
+                               for (size_t i = 0; i < BATCH; ++i) {
+                                   bench::doNotOptimize(dynamic[i].det());
+                               }
+                           }),
+                           BATCH);
+    bench::printLatencyRow("FixedMatrix det", N, bench::secondsPerRun([&] {
+                               for (size_t i = 0; i < BATCH; ++i) {
+                                   bench::doNotOptimize(fixed[i].det());
+                               }
+                           }),
+                           BATCH);
+    bench::printLatencyRow("Matrix a * b", N, bench::secondsPerRun([&] {
+                               for (size_t i = 0; i < BATCH; ++i) {
+                                   bench::doNotOptimize(dynamic[i] * dynamic[(i + 1) % BATCH]);
+                               }
+                           }),
+                           BATCH);
+    bench::printLatencyRow("FixedMatrix a * b", N, bench::secondsPerRun([&] {
+                               for (size_t i = 0; i < BATCH; ++i) {
+                                   bench::doNotOptimize(fixed[i] * fixed[(i + 1) % BATCH]);
+                               }
+                           }),
+                           BATCH);
+
+    SimdLevel supported = task::detectSimdLevel();
+    for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        if (level > supported) {
+            break;
+        }
+        task::setSimdLevel(level);
+        std::string name = task::simdLevelName(level);
+        bench::printLatencyRow("MatrixBatch det, " + name, N, bench::secondsPerRun([&] {
+                                   bench::doNotOptimize(a.det());
+                               }),
+                               BATCH);
+        bench::printLatencyRow("MatrixBatch a * b, " + name, N, bench::secondsPerRun([&] {
+                                   bench::doNotOptimize(a * b);
+                               }),
+                               BATCH);
+    }
+    task::setSimdLevel(supported);
+    bench::printLatencyRow("MatrixBatch transposed", N, bench::secondsPerRun([&] {
+                               bench::doNotOptimize(a.transposed());
+                           }),
+                           BATCH);
+}
+
+
+int main() {
+    bench::printHeader("Batched small matrices: per-matrix loop vs structure-of-arrays batch", "ns/op");
+    run<3>();
+    run<4>();
+    run<8>();
+}
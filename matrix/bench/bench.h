@@ -0,0 +1,120 @@
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace bench {
+
+    template<class T>
+    void doNotOptimize(const T &value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    template<class F>
+    double secondsPerRun(F &&f, double minSeconds = 0.2, size_t minRuns = 3) {
+        using Clock = std::chrono::steady_clock;
+        f();
+        size_t runs = 0;
+        auto start = Clock::now();
+        double elapsed = 0;
+        while (runs < minRuns || elapsed < minSeconds) {
+            f();
+            ++runs;
+            elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        }
+        return elapsed / runs;
+    }
+
+    inline void printHeader(const std::string &title, const std::string &unit = "GB/s") {
+        std::printf("\n%s\n", title.c_str());
+        std::printf("%-28s %10s %14s %14s\n", "case", "size", "time, us", unit.c_str());
+    }
+
+    // amount is bytes or flops per run, reported in giga-units per second.
+    inline void printRow(const std::string &name, size_t n, double seconds, double amount) {
+        std::printf("%-28s %10zu %14.3f %14.3f\n", name.c_str(), n, seconds * 1e6, amount / seconds / 1e9);
+    }
+
+    // Reports the cost of a single operation when every run performs ops of them.
+    inline void printLatencyRow(const std::string &name, size_t n, double seconds, size_t ops) {
+        std::printf("%-28s %10zu %14.3f %14.3f\n", name.c_str(), n, seconds * 1e6, seconds / ops * 1e9);
+    }
+
+    // One case of a suite; flops, bytes and allocations are per run, zero where they do not apply.
+    struct Measurement {
+        std::string name;
+        size_t n;
+        double seconds;
+        double flops;
+        double bytes;
+        size_t allocations;
+    };
+
+    inline void printMeasurementHeader(const std::string &title) {
+        std::printf("\n%s\n", title.c_str());
+        std::printf("%-28s %10s %14s %10s %10s %8s\n", "case", "size", "time, us", "GFLOP/s", "GB/s", "allocs");
+    }
+
+    inline void printMeasurement(const Measurement &m) {
+        std::printf("%-28s %10zu %14.3f %10.3f %10.3f %8zu\n", m.name.c_str(), m.n, m.seconds * 1e6,
+                    m.flops / m.seconds / 1e9, m.bytes / m.seconds / 1e9, m.allocations);
+    }
+
+    inline std::string jsonString(const std::string &text) {
+        std::string result = "\"";
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                result += '\\';
+                result += c;
+            } else if (c == '\n') {
+                result += "\\n";
+            } else if (c == '\t') {
+                result += "\\t";
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                char buffer[8];
+                std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned char>(c));
+                result += buffer;
+            } else {
+                result += c;
+            }
+        }
+        return result + '"';
+    }
+
+    // JSON has no infinity or NaN, as a rate over zero seconds would give: those become null.
+    inline std::string jsonNumber(double value, const char *format) {
+        if (!std::isfinite(value)) {
+            return "null";
+        }
+        char buffer[64];
+        std::snprintf(buffer, sizeof(buffer), format, value);
+        return buffer;
+    }
+
+    // {"context": {key: value, ...}, "results": [...]}; context values are written as strings.
+    inline void writeJson(std::ostream &output, const std::vector<std::pair<std::string, std::string>> &context,
+                          const std::vector<Measurement> &results) {
+        output << "{\n  \"context\": {";
+        for (size_t i = 0; i < context.size(); ++i) {
+            output << (i == 0 ? "\n" : ",\n") << "    " << jsonString(context[i].first) << ": "
+                   << jsonString(context[i].second);
+        }
+        output << "\n  },\n  \"results\": [";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const Measurement &m = results[i];
+            output << (i == 0 ? "\n" : ",\n") << "    {\"name\": " << jsonString(m.name) << ", \"size\": " << m.n
+                   << ", \"seconds\": " << jsonNumber(m.seconds, "%.9g")
+                   << ", \"gflops\": " << jsonNumber(m.flops / m.seconds / 1e9, "%.6g")
+                   << ", \"gbytes_per_second\": " << jsonNumber(m.bytes / m.seconds / 1e9, "%.6g")
+                   << ", \"allocations\": " << m.allocations << "}";
+        }
+        output << "\n  ]\n}\n";
+    }
+
+}// namespace bench
@@ -0,0 +1,68 @@
+// Run as ./bench.sh counters, then as CXXFLAGS=-DMATRIX_COUNTERS=1 ./bench.sh counters to see
+// what the counters cost and what they report.
+#include "bench/bench.h"
+#include "src/lu.h"
+#include "src/matrix.h"
+#include "src/matrix_counters.h"
+
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+
+using task::Matrix;
+
+
+const size_t THREADS = 4;
+
+
+Matrix randomMatrix(size_t rows, size_t cols) {
+    static std::mt19937 rand(42);
+    std::uniform_real_distribution<double> dist{-10., 10.};
+    Matrix temp(rows, cols);
+    for (size_t i = 0; i < rows * cols; ++i) {
+        temp.data()[i] = dist(rand);
+    }
+    return temp;
+}
+
+// A mix of every counted operation: copies, an elementwise expression, a product, a transpose
+// and a solve.
+double request(const Matrix &a, const Matrix &b) {
+    Matrix c = a;
+    c += b;
+    Matrix d = c * a + b;
+    Matrix t = d.transposed();
+    return task::solve(t, b).trace();
+}
+
+
+int main() {
+    std::printf("counters %s\n", task::COUNTERS_ENABLED ? "enabled" : "disabled");
+    bench::printHeader("Instrumentation overhead, per request", "ns/op");
+    for (size_t n : {4, 16, 64, 256}) {
+        Matrix a = randomMatrix(n, n), b = randomMatrix(n, n);
+        bench::printLatencyRow("request", n, bench::secondsPerRun([&] {
+                                   bench::doNotOptimize(request(a, b));
+                               }),
+                               1);
+    }
+
+    task::resetCounters();
+    Matrix a = randomMatrix(64, 64), b = randomMatrix(64, 64);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < THREADS; ++i) {
+        threads.emplace_back([&] {
+            for (size_t r = 0; r < 100; ++r) {
+                bench::doNotOptimize(request(a, b));
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    std::printf("\n%zu threads x 100 requests, n = 64\n", THREADS);
+    task::dumpCounters(std::cout);
+}
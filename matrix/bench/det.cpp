@@ -0,0 +1,66 @@
+#include "bench/bench.h"
+#include "src/lu.h"
+#include "src/matrix.h"
+
+#include <random>
+
+
+using task::Matrix;
+
+
+Matrix randomMatrix(size_t rows, size_t cols) {
+    static std::mt19937 rand(42);
+    std::uniform_real_distribution<double> dist{-10., 10.};
+    Matrix temp(rows, cols);
+    for (size_t i = 0; i < rows * cols; ++i) {
+        temp.data()[i] = dist(rand);
+    }
+    return temp;
+}
+
+// The elimination det() used before LU: no pivoting, row by row through operator[].
+double unpivotedDet(const Matrix &matrix) {
+    Matrix arr = matrix;
+    for (size_t i = 0; i < arr.getRow() - 1; ++i) {
+        for (size_t j = i + 1; j < arr.getCol(); ++j) {
+            double coef = double(arr[j][i]) / arr[i][i];
+            for (size_t k = i; k < arr.getRow(); ++k) {
+                arr[j][k] -= arr[i][k] * coef;
+            }
+        }
+    }
+    double d = 1;
+    for (size_t i = 0; i < arr.getRow(); ++i) {
+        d *= arr[i][i];
+    }
+    return d;
+}
+
+
+int main() {
+    bench::printHeader("Determinant: unpivoted elimination vs blocked LU", "GFLOP/s");
+    for (size_t n : {16, 64, 256, 512, 1000, 2000}) {
+        Matrix a = randomMatrix(n, n);
+        double flops = 2. * n * n * n / 3;
+        if (n <= 1000) {
+            bench::printRow("unpivoted elimination", n, bench::secondsPerRun([&] {
+                                bench::doNotOptimize(unpivotedDet(a));
+                            }, 0.2, 1),
+                            flops);
+        }
+        bench::printRow("LU det()", n, bench::secondsPerRun([&] {
+                            bench::doNotOptimize(a.det());
+                        }, 0.2, 1),
+                        flops);
+    }
+
+    std::printf("\n%-28s %14s %14s %14s\n", "matrix", "expected", "unpivoted", "LU");
+    Matrix swap(2, 2);
+    swap[0][0] = 0, swap[0][1] = 1, swap[1][0] = 1, swap[1][1] = 0;
+    std::printf("%-28s %14g %14g %14g\n", "[[0 1] [1 0]]", -1., unpivotedDet(swap), swap.det());
+    Matrix tiny(3, 3);
+    tiny[0][0] = 1e-20, tiny[0][1] = 1, tiny[0][2] = 1;
+    tiny[1][0] = 1, tiny[1][1] = 1, tiny[1][2] = 0;
+    tiny[2][0] = 1, tiny[2][1] = 0, tiny[2][2] = 1;
+    std::printf("%-28s %14g %14g %14g\n", "[[1e-20 1 1] [1 1 0] [1 0 1]]", -2., unpivotedDet(tiny), tiny.det());
+}
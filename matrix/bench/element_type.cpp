@@ -0,0 +1,56 @@
+#include "bench/bench.h"
+#include "src/matrix.h"
+
+#include <complex>
+#include <cstdint>
+#include <random>
+
+
+using task::BasicMatrix;
+
+
+template<class T>
+BasicMatrix<T> randomMatrix(size_t rows, size_t cols) {
+    static std::mt19937 rand(42);
+    std::uniform_real_distribution<double> dist{-10., 10.};
+    BasicMatrix<T> temp(rows, cols);
+    for (size_t i = 0; i < rows * cols; ++i) {
+        temp.data()[i] = T(dist(rand));
+    }
+    return temp;
+}
+
+template<class T>
+void run(const char *name) {
+    bench::printHeader(std::string("Element type: ") + name);
+    for (size_t n : {256, 1024, 2048}) {
+        BasicMatrix<T> a = randomMatrix<T>(n, n), b = randomMatrix<T>(n, n), c;
+        double bytes = double(n) * n * sizeof(T);
+
+        bench::printRow("c = a + b", n, bench::secondsPerRun([&] {
+                            c = a + b;
+                        }),
+                        3 * bytes);
+        bench::printRow("a += b", n, bench::secondsPerRun([&] {
+                            a += b;
+                        }),
+                        3 * bytes);
+    }
+
+    bench::printHeader(std::string("Element type: ") + name, "GFLOP/s");
+    for (size_t n : {256, 1024}) {
+        BasicMatrix<T> a = randomMatrix<T>(n, n), b = randomMatrix<T>(n, n), c;
+        bench::printRow("c = a * b", n, bench::secondsPerRun([&] {
+                            c = a * b;
+                        }, 0.2, 1),
+                        2. * n * n * n);
+    }
+}
+
+
+int main() {
+    run<float>("float");
+    run<double>("double");
+    run<int64_t>("int64_t");
+    run<std::complex<double>>("complex<double>");
+}
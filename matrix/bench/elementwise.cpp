@@ -0,0 +1,57 @@
+#include "bench/bench.h"
+#include "src/kernels.h"
+#include "src/matrix.h"
+
+#include <random>
+
+
+using task::Matrix;
+using task::SimdLevel;
+
+
+Matrix randomMatrix(size_t rows, size_t cols) {
+    static std::mt19937 rand(42);
+    std::uniform_real_distribution<double> dist{-10., 10.};
+    Matrix temp(rows, cols);
+    for (size_t i = 0; i < rows * cols; ++i) {
+        temp.data()[i] = dist(rand);
+    }
+    return temp;
+}
+
+
+int main() {
+    SimdLevel supported = task::detectSimdLevel();
+    for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        if (level > supported) {
+            break;
+        }
+        task::setSimdLevel(level);
+        bench::printHeader(std::string("Element-wise operations, kernels: ") + task::simdLevelName(level));
+        for (size_t n : {64, 256, 1024, 4096}) {
+            Matrix a = randomMatrix(n, n), b = randomMatrix(n, n), c;
+            double bytes = double(n) * n * sizeof(double);
+
+            bench::printRow("a += b", n, bench::secondsPerRun([&] {
+                                a += b;
+                            }),
+                            3 * bytes);
+            bench::printRow("a -= b", n, bench::secondsPerRun([&] {
+                                a -= b;
+                            }),
+                            3 * bytes);
+            bench::printRow("a *= 1.0", n, bench::secondsPerRun([&] {
+                                a *= 1.0;
+                            }),
+                            2 * bytes);
+            bench::printRow("c = -a", n, bench::secondsPerRun([&] {
+                                c = -a;
+                            }),
+                            2 * bytes);
+            bench::printRow("c = 2.0 * a", n, bench::secondsPerRun([&] {
+                                c = 2.0 * a;
+                            }),
+                            2 * bytes);
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#include "bench/bench.h"
+#include "src/matrix.h"
+
+#include <random>
+
+
+using task::Matrix;
+
+
+Matrix randomMatrix(size_t rows, size_t cols) {
+    static std::mt19937 rand(42);
+    std::uniform_real_distribution<double> dist{-10., 10.};
+    Matrix temp(rows, cols);
+    for (size_t i = 0; i < rows * cols; ++i) {
+        temp.data()[i] = dist(rand);
+    }
+    return temp;
+}
+
+// What each operator did before expression templates: copy the left operand, then update it in place.
+Matrix eagerSum(const Matrix &a, const Matrix &b) {
+    Matrix temp = a;
+    return temp += b;
+}
+
+Matrix eagerDifference(const Matrix &a, const Matrix &b) {
+    Matrix temp = a;
+    return temp -= b;
+}
+
+Matrix eagerScaled(const Matrix &a, double number) {
+    Matrix temp = a;
+    return temp *= number;
+}
+
+
+int main() {
+    bench::printHeader("r = a + b - c * 2.0 + d - 0.5 * e");
+    for (size_t n : {64, 256, 1024, 2048}) {
+        Matrix a = randomMatrix(n, n), b = randomMatrix(n, n), c = randomMatrix(n, n);
+        Matrix d = randomMatrix(n, n), e = randomMatrix(n, n), r;
+        double bytes = 6. * n * n * sizeof(double);
+
+        bench::printRow("temporary per operator", n, bench::secondsPerRun([&] {
+                            r = eagerDifference(eagerSum(eagerDifference(eagerSum(a, b), eagerScaled(c, 2.0)), d),
+                                                eagerScaled(e, 0.5));
+                        }),
+                        bytes);
+        bench::printRow("expression template", n, bench::secondsPerRun([&] {
+                            r = a + b - c * 2.0 + d - 0.5 * e;
+                        }),
+                        bytes);
+        bench::printRow("expression, new matrix", n, bench::secondsPerRun([&] {
+                            Matrix fresh = a + b - c * 2.0 + d - 0.5 * e;
+                            bench::doNotOptimize(fresh.data());
+                        }),
+                        bytes);
+    }
+}
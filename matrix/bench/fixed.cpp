@@ -0,0 +1,93 @@
+#include "bench/bench.h"
+#include "src/fixed_matrix.h"
+#include "src/lu.h"
+#include "src/matrix.h"
+
+#include <random>
+#include <vector>
+
+
+using task::FixedMatrix;
+using task::Matrix;
+
+
+const size_t BATCH = 1024;
+
+
+template<size_t N>
+FixedMatrix<double, N, N> randomFixed() {
+    static std::mt19937 rand(42);
+    std::uniform_real_distribution<double> dist{-10., 10.};
+    FixedMatrix<double, N, N> temp;
+    for (size_t i = 0; i < N * N; ++i) {
+        temp.data()[i] = dist(rand);
+    }
+    return temp;
+}
+
+template<size_t N>
+void run() {
+    std::vector<FixedMatrix<double, N, N>> fixed;
+    std::vector<Matrix> dynamic;
+    for (size_t i = 0; i < BATCH; ++i) {
+        fixed.push_back(randomFixed<N>());
+        dynamic.push_back(fixed.back().toMatrix());
+    }
+
+    bench::printLatencyRow("Matrix a + b", N, bench::secondsPerRun([&] {
+                               for (size_t i = 0; i + 1 < BATCH; ++i) {
+                                   bench::doNotOptimize(Matrix(dynamic[i] + dynamic[i + 1]));
+                               }
+                           }),
+                           BATCH - 1);
+    bench::printLatencyRow("FixedMatrix a + b", N, bench::secondsPerRun([&] {
+                               for (size_t i = 0; i + 1 < BATCH; ++i) {
+                                   bench::doNotOptimize(fixed[i] + fixed[i + 1]);
+                               }
+                           }),
+                           BATCH - 1);
+    bench::printLatencyRow("Matrix a * b", N, bench::secondsPerRun([&] {
+                               for (size_t i = 0; i + 1 < BATCH; ++i) {
+                                   bench::doNotOptimize(dynamic[i] * dynamic[i + 1]);
+                               }
+                           }),
+                           BATCH - 1);
+    bench::printLatencyRow("FixedMatrix a * b", N, bench::secondsPerRun([&] {
+                               for (size_t i = 0; i + 1 < BATCH; ++i) {
+                                   bench::doNotOptimize(fixed[i] * fixed[i + 1]);
+                               }
+                           }),
+                           BATCH - 1);
+    bench::printLatencyRow("Matrix det", N, bench::secondsPerRun([&] {
+                               for (size_t i = 0; i < BATCH; ++i) {
+                                   bench::doNotOptimize(dynamic[i].det());
+                               }
+                           }),
+                           BATCH);
+    bench::printLatencyRow("FixedMatrix det", N, bench::secondsPerRun([&] {
+                               for (size_t i = 0; i < BATCH; ++i) {
+                                   bench::doNotOptimize(fixed[i].det());
+                               }
+                           }),
+                           BATCH);
+    bench::printLatencyRow("LU inverse", N, bench::secondsPerRun([&] {
+                               for (size_t i = 0; i < BATCH; ++i) {
+                                   bench::doNotOptimize(task::LU(dynamic[i]).inverse());
+                               }
+                           }),
+                           BATCH);
+    bench::printLatencyRow("FixedMatrix inverse", N, bench::secondsPerRun([&] {
+                               for (size_t i = 0; i < BATCH; ++i) {
+                                   bench::doNotOptimize(fixed[i].inverse());
+                               }
+                           }),
+                           BATCH);
+}
+
+
+int main() {
+    bench::printHeader("Small matrices: heap-backed Matrix vs FixedMatrix", "ns/op");
+    run<2>();
+    run<3>();
+    run<4>();
+}
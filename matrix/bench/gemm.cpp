@@ -0,0 +1,83 @@
+#include "bench/bench.h"
+#include "src/kernels.h"
+#include "src/matrix.h"
+
+#include <cmath>
+#include <random>
+
+
+using task::Matrix;
+
+
+Matrix randomMatrix(size_t rows, size_t cols) {
+    static std::mt19937 rand(42);
+    std::uniform_real_distribution<double> dist{-10., 10.};
+    Matrix temp(rows, cols);
+    for (size_t i = 0; i < rows * cols; ++i) {
+        temp.data()[i] = dist(rand);
+    }
+    return temp;
+}
+
+void naiveMultiply(const Matrix &a, const Matrix &b, Matrix &c) {
+    size_t n = a.getRow(), m = b.getCol(), k = a.getCol();
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < m; ++j) {
+            double s = 0;
+            for (size_t p = 0; p < k; ++p) {
+                s += a[i][p] * b[p][j];
+            }
+            c[i][j] = s;
+        }
+    }
+}
+
+double maxRelativeError(const Matrix &a, const Matrix &b) {
+    double err = 0;
+    for (size_t i = 0; i < a.getRow() * a.getCol(); ++i) {
+        err = std::max(err, std::fabs(a.data()[i] - b.data()[i]) / std::max(1., std::fabs(b.data()[i])));
+    }
+    return err;
+}
+
+
+int main() {
+    bench::printHeader("Square matrix product: naive i-j-k vs blocked gemm", "GFLOP/s");
+    for (size_t n : {16, 32, 64, 128, 256, 512, 1024, 2048}) {
+        Matrix a = randomMatrix(n, n), b = randomMatrix(n, n);
+        double flops = 2. * n * n * n;
+
+        Matrix expected(n, n);
+        if (n <= 1024) {
+            bench::printRow("naive", n, bench::secondsPerRun([&] {
+                                naiveMultiply(a, b, expected);
+                            }, 0.2, 1),
+                            flops);
+        }
+
+        Matrix c;
+        bench::printRow("operator*", n, bench::secondsPerRun([&] {
+                            c = a * b;
+                        }, 0.2, 1),
+                        flops);
+
+        if (n <= 1024) {
+            std::printf("%-28s %10zu %14.3g\n", "max relative error", n, maxRelativeError(c, expected));
+        }
+    }
+
+    bench::printHeader("Blocked gemm per micro-kernel", "GFLOP/s");
+    task::SimdLevel supported = task::detectSimdLevel();
+    size_t n = 1024;
+    Matrix a = randomMatrix(n, n), b = randomMatrix(n, n), c;
+    for (auto level : {task::SimdLevel::SCALAR, task::SimdLevel::SSE2, task::SimdLevel::AVX2, task::SimdLevel::AVX512}) {
+        if (level > supported) {
+            break;
+        }
+        task::setSimdLevel(level);
+        bench::printRow(task::simdLevelName(level), n, bench::secondsPerRun([&] {
+                            c = a * b;
+                        }, 0.2, 1),
+                        2. * n * n * n);
+    }
+}
@@ -0,0 +1,91 @@
+#include "bench/bench.h"
+#include "src/matrix.h"
+#include "src/matrix_io.h"
+
+#include <cstdio>
+#include <random>
+#include <sstream>
+
+
+using task::Matrix;
+
+
+Matrix randomMatrix(size_t rows, size_t cols) {
+    static std::mt19937 rand(42);
+    std::uniform_real_distribution<double> dist{-10., 10.};
+    Matrix temp(rows, cols);
+    for (size_t i = 0; i < rows * cols; ++i) {
+        temp.data()[i] = dist(rand);
+    }
+    return temp;
+}
+
+
+int main() {
+    const std::string binaryPath = "bench_matrix.bin";
+    const std::string textPath = "bench_matrix.txt";
+
+    for (size_t n : {256, 1024, 2048}) {
+        Matrix a = randomMatrix(n, n), b;
+        double binaryBytes = double(n) * n * sizeof(double);
+
+        std::stringstream stream;
+        stream.precision(17);
+        stream << n << ' ' << n << '\n'
+               << a;
+        std::string streamText = stream.str();
+
+        std::stringstream fast;
+        task::writeText(fast, a);
+        std::string fastText = fast.str();
+
+        bench::printHeader("Matrix I/O: text cases count characters, binary cases the payload");
+        bench::printRow("operator<<", n, bench::secondsPerRun([&] {
+                            std::stringstream out;
+                            out.precision(17);
+                            out << a;
+                            bench::doNotOptimize(out.tellp());
+                        }, 0.2, 1),
+                        double(streamText.size()));
+        bench::printRow("writeText (to_chars)", n, bench::secondsPerRun([&] {
+                            std::stringstream out;
+                            task::writeText(out, a);
+                            bench::doNotOptimize(out.tellp());
+                        }, 0.2, 1),
+                        double(fastText.size()));
+        bench::printRow("operator>>", n, bench::secondsPerRun([&] {
+                            std::stringstream in(streamText);
+                            in >> b;
+                        }, 0.2, 1),
+                        double(streamText.size()));
+        bench::printRow("parseText (from_chars)", n, bench::secondsPerRun([&] {
+                            task::parseText(fastText.data(), fastText.data() + fastText.size(), b);
+                        }, 0.2, 1),
+                        double(fastText.size()));
+        bench::printRow("saveText + loadText", n, bench::secondsPerRun([&] {
+                            task::saveText(textPath, a);
+                            b = task::loadText(textPath);
+                        }, 0.2, 1),
+                        2. * fastText.size());
+        bench::printRow("saveBinary", n, bench::secondsPerRun([&] {
+                            task::saveBinary(binaryPath, a);
+                        }, 0.2, 1),
+                        binaryBytes);
+        bench::printRow("loadBinary", n, bench::secondsPerRun([&] {
+                            b = task::loadBinary(binaryPath);
+                        }, 0.2, 1),
+                        binaryBytes);
+        bench::printRow("MappedMatrix open + sum", n, bench::secondsPerRun([&] {
+                            task::MappedMatrix mapped(binaryPath);
+                            double s = 0;
+                            for (size_t i = 0; i < n * n; ++i) {
+                                s += mapped.data()[i];
+                            }
+                            bench::doNotOptimize(s);
+                        }, 0.2, 1),
+                        binaryBytes);
+    }
+
+    std::remove(binaryPath.c_str());
+    std::remove(textPath.c_str());
+}
@@ -0,0 +1,49 @@
+#include "bench/bench.h"
+#include "src/matrix.h"
+#include "src/thread_pool.h"
+
+#include <random>
+#include <thread>
+
+
+using task::Matrix;
+
+
+Matrix randomMatrix(size_t rows, size_t cols) {
+    static std::mt19937 rand(42);
+    std::uniform_real_distribution<double> dist{-10., 10.};
+    Matrix temp(rows, cols);
+    for (size_t i = 0; i < rows * cols; ++i) {
+        temp.data()[i] = dist(rand);
+    }
+    return temp;
+}
+
+template<class F>
+void scaling(const std::string &name, size_t n, size_t maxThreads, F &&f) {
+    std::printf("\n%s, n = %zu\n", name.c_str(), n);
+    std::printf("%10s %14s %10s\n", "threads", "time, us", "speedup");
+    double base = 0;
+    for (size_t threads = 1; threads <= maxThreads; ++threads) {
+        task::setThreadCount(threads);
+        double seconds = bench::secondsPerRun(f, 0.3, 2);
+        if (threads == 1) {
+            base = seconds;
+        }
+        std::printf("%10zu %14.3f %10.2f\n", threads, seconds * 1e6, base / seconds);
+    }
+}
+
+
+int main(int argc, char **argv) {
+    size_t maxThreads = argc > 1 ? std::stoul(argv[1]) : std::thread::hardware_concurrency();
+    task::setExecutionPolicy(task::ExecutionPolicy::PARALLEL);
+
+    Matrix a = randomMatrix(1024, 1024), b = randomMatrix(1024, 1024), c;
+    scaling("operator*", 1024, maxThreads, [&] { c = a * b; });
+
+    Matrix x = randomMatrix(4096, 4096), y = randomMatrix(4096, 4096);
+    scaling("operator+=", 4096, maxThreads, [&] { x += y; });
+    scaling("operator*=(double)", 4096, maxThreads, [&] { x *= 1.0; });
+    scaling("transposed()", 4096, maxThreads, [&] { bench::doNotOptimize(x.transposed().data()); });
+}
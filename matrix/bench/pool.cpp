@@ -0,0 +1,87 @@
+#include "bench/allocations.h"
+#include "bench/bench.h"
+#include "src/matrix.h"
+#include "src/matrix_memory.h"
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+using task::Matrix;
+
+
+const size_t THREADS = 4;
+const size_t ROUNDS = 64;
+
+
+Matrix randomMatrix(size_t rows, size_t cols) {
+    static std::mt19937 rand(42);
+    std::uniform_real_distribution<double> dist{-10., 10.};
+    Matrix temp(rows, cols);
+    for (size_t i = 0; i < rows * cols; ++i) {
+        temp.data()[i] = dist(rand);
+    }
+    return temp;
+}
+
+// One request of the loop: every Matrix here is a fresh buffer, and det() copies t once more.
+double request(const Matrix &a, const Matrix &b) {
+    Matrix c = a + b;
+    Matrix d = c * a;
+    Matrix t = d.transposed();
+    t -= b;
+    return t.det();
+}
+
+void run(const std::string &resource, size_t n) {
+    Matrix a = randomMatrix(n, n), b = randomMatrix(n, n);
+    size_t rounds = std::max<size_t>(1, ROUNDS * 64 / n);
+    bench::printLatencyRow(resource + ", 1 thread", n, bench::secondsPerRun([&] {
+                               for (size_t r = 0; r < rounds; ++r) {
+                                   bench::doNotOptimize(request(a, b));
+                               }
+                           }),
+                           rounds);
+    bench::printLatencyRow(resource + ", " + std::to_string(THREADS) + " threads", n, bench::secondsPerRun([&] {
+                               std::vector<std::thread> threads;
+                               for (size_t i = 0; i < THREADS; ++i) {
+                                   threads.emplace_back([&] {
+                                       for (size_t r = 0; r < rounds; ++r) {
+                                           bench::doNotOptimize(request(a, b));
+                                       }
+                                   });
+                               }
+                               for (std::thread &thread : threads) {
+                                   thread.join();
+                               }
+                           }),
+                           rounds * THREADS);
+    std::printf("%-34s %6zu %14zu\n", (resource + ", heap allocations").c_str(), n,
+                bench::allocationsPerRun([&] { bench::doNotOptimize(request(a, b)); }));
+}
+
+
+int main() {
+    bench::printHeader("Matrix temporaries: global heap vs thread-local pool, per request", "ns/op");
+    for (size_t n : {4, 16, 64, 256}) {
+        run("new/delete", n);
+        task::setMatrixResource(task::matrixPool());
+        run("matrixPool", n);
+        task::setMatrixResource(nullptr);
+    }
+
+    task::setMatrixResource(task::matrixPool());
+    Matrix a = randomMatrix(64, 64), b = randomMatrix(64, 64);
+    task::MatrixPoolStats before = task::matrixPoolStats();
+    for (size_t r = 0; r < 1000; ++r) {
+        bench::doNotOptimize(request(a, b));
+    }
+    task::MatrixPoolStats after = task::matrixPoolStats();
+    std::printf("\nmatrixPool over 1000 requests, n = 64: %zu allocations, %zu reused, %zu bytes reused, "
+                "%zu bytes cached\n",
+                after.allocations - before.allocations, after.reused - before.reused,
+                after.bytesReused - before.bytesReused, after.cachedBytes);
+}
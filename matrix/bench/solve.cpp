@@ -0,0 +1,117 @@
+#include "bench/bench.h"
+#include "src/cholesky.h"
+#include "src/lu.h"
+#include "src/matrix.h"
+#include "src/qr.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+
+using task::Matrix;
+
+
+Matrix randomMatrix(size_t rows, size_t cols) {
+    static std::mt19937 rand(42);
+    std::uniform_real_distribution<double> dist{-10., 10.};
+    Matrix temp(rows, cols);
+    for (size_t i = 0; i < rows * cols; ++i) {
+        temp.data()[i] = dist(rand);
+    }
+    return temp;
+}
+
+// One determinant per unknown, as the callers did before solve().
+Matrix cramer(const Matrix &a, const Matrix &b) {
+    size_t n = a.getRow();
+    double d = a.det();
+    Matrix x(n, 1);
+    for (size_t j = 0; j < n; ++j) {
+        Matrix replaced = a;
+        for (size_t i = 0; i < n; ++i) {
+            replaced[i][j] = b[i][0];
+        }
+        x[j][0] = replaced.det() / d;
+    }
+    return x;
+}
+
+// Column by column through operator[], without blocking.
+Matrix unblockedCholesky(const Matrix &a) {
+    size_t n = a.getRow();
+    Matrix l = a;
+    for (size_t j = 0; j < n; ++j) {
+        for (size_t p = 0; p < j; ++p) {
+            l[j][j] -= l[j][p] * l[j][p];
+        }
+        l[j][j] = std::sqrt(l[j][j]);
+        for (size_t i = j + 1; i < n; ++i) {
+            for (size_t p = 0; p < j; ++p) {
+                l[i][j] -= l[i][p] * l[j][p];
+            }
+            l[i][j] /= l[j][j];
+        }
+    }
+    return l;
+}
+
+// |a x - b| / (|a| |x|) in the max norm.
+double residual(const Matrix &a, const Matrix &x, const Matrix &b) {
+    Matrix r = a * x - b;
+    auto norm = [](const Matrix &m) {
+        double result = 0;
+        for (size_t i = 0; i < m.getRow() * m.getCol(); ++i) {
+            result = std::max(result, std::abs(m.data()[i]));
+        }
+        return result;
+    };
+    return norm(r) / (norm(a) * norm(x));
+}
+
+
+int main() {
+    bench::printHeader("Linear solvers and decompositions", "GFLOP/s");
+    for (size_t n : {64, 256, 512, 1000, 2000}) {
+        Matrix a = randomMatrix(n, n), b = randomMatrix(n, 1);
+        Matrix spd = a * a.transposed();
+        double cube = double(n) * n * n;
+
+        if (n <= 256) {
+            bench::printRow("Cramer's rule", n, bench::secondsPerRun([&] {
+                                bench::doNotOptimize(cramer(a, b));
+                            }, 0.2, 1),
+                            2 * cube / 3);
+        }
+        bench::printRow("solve (LU)", n, bench::secondsPerRun([&] {
+                            bench::doNotOptimize(task::solve(a, b));
+                        }, 0.2, 1),
+                        2 * cube / 3);
+        bench::printRow("inverse (LU)", n, bench::secondsPerRun([&] {
+                            bench::doNotOptimize(task::inverse(a));
+                        }, 0.2, 1),
+                        2 * cube);
+        bench::printRow("QR", n, bench::secondsPerRun([&] {
+                            bench::doNotOptimize(task::QR(a));
+                        }, 0.2, 1),
+                        4 * cube / 3);
+        if (n <= 1000) {
+            bench::printRow("unblocked Cholesky", n, bench::secondsPerRun([&] {
+                                bench::doNotOptimize(unblockedCholesky(spd));
+                            }, 0.2, 1),
+                            cube / 3);
+        }
+        bench::printRow("Cholesky", n, bench::secondsPerRun([&] {
+                            bench::doNotOptimize(task::Cholesky(spd));
+                        }, 0.2, 1),
+                        cube / 3);
+    }
+
+    size_t n = 500;
+    Matrix a = randomMatrix(n, n), b = randomMatrix(n, 1);
+    Matrix spd = a * a.transposed();
+    std::printf("\n%-28s %14s\n", "relative residual, n = 500", "|Ax-b|/|A||x|");
+    std::printf("%-28s %14.3g\n", "solve (LU)", residual(a, task::solve(a, b), b));
+    std::printf("%-28s %14.3g\n", "QR solve", residual(a, task::QR(a).solve(b), b));
+    std::printf("%-28s %14.3g\n", "Cholesky solve", residual(spd, task::Cholesky(spd).solve(b), b));
+}
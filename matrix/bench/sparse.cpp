@@ -0,0 +1,61 @@
+#include "bench/bench.h"
+#include "src/matrix.h"
+#include "src/sparse_matrix.h"
+
+#include <random>
+
+
+using task::Matrix;
+using task::SparseMatrix;
+
+
+Matrix randomSparse(size_t n, double density) {
+    static std::mt19937 rand(42);
+    std::uniform_real_distribution<double> dist{-10., 10.};
+    std::bernoulli_distribution keep(density);
+    Matrix temp(n, n);
+    for (size_t i = 0; i < n * n; ++i) {
+        temp.data()[i] = keep(rand) ? dist(rand) : 0.;
+    }
+    return temp;
+}
+
+
+int main() {
+    size_t n = 2048;
+    for (double density : {0.001, 0.01}) {
+        Matrix dense = randomSparse(n, density);
+        SparseMatrix sparse(dense);
+        double useful = 2. * sparse.nonZeros();
+        std::printf("\ndensity %.3f: dense %zu KiB, CSR %zu KiB\n", density, n * n * sizeof(double) / 1024,
+                    (sparse.nonZeros() * (sizeof(double) + sizeof(size_t)) + (n + 1) * sizeof(size_t)) / 1024);
+
+        bench::printHeader("Matrix-vector product, useful flops only", "GFLOP/s");
+        Matrix x(n, 1), y;
+        std::vector<double> xs(n, 1.), ys;
+        bench::printRow("dense a * x", n, bench::secondsPerRun([&] {
+                            y = dense * x;
+                        }),
+                        useful);
+        bench::printRow("CSR a * x", n, bench::secondsPerRun([&] {
+                            ys = sparse * xs;
+                        }),
+                        useful);
+
+        bench::printHeader("Matrix-matrix product, useful flops only", "GFLOP/s");
+        Matrix c;
+        SparseMatrix sc;
+        bench::printRow("dense a * b", n, bench::secondsPerRun([&] {
+                            c = dense * dense;
+                        }, 0.2, 1),
+                        useful * sparse.nonZeros() / n);
+        bench::printRow("CSR a * dense b", n, bench::secondsPerRun([&] {
+                            c = sparse * dense;
+                        }, 0.2, 1),
+                        useful * sparse.nonZeros() / n);
+        bench::printRow("CSR a * CSR b", n, bench::secondsPerRun([&] {
+                            sc = sparse * sparse;
+                        }),
+                        useful * sparse.nonZeros() / n);
+    }
+}
@@ -0,0 +1,107 @@
+#include "bench/bench.h"
+#include "src/matrix.h"
+
+#include <numeric>
+
+
+using task::Matrix;
+
+
+class LegacyMatrix {
+public:
+    LegacyMatrix(size_t rows, size_t cols) : row(rows), col(cols) {
+        arr = new double *[row];
+        for (size_t i = 0; i < row; ++i) {
+            arr[i] = new double[col];
+            for (size_t j = 0; j < col; ++j) {
+                arr[i][j] = (i == j ? 1 : 0);
+            }
+        }
+    }
+
+    LegacyMatrix(const LegacyMatrix &copy) : row(copy.row), col(copy.col) {
+        arr = new double *[row];
+        for (size_t i = 0; i < row; ++i) {
+            arr[i] = new double[col];
+            for (size_t j = 0; j < col; ++j) {
+                arr[i][j] = copy.arr[i][j];
+            }
+        }
+    }
+
+    LegacyMatrix &operator=(const LegacyMatrix &) = delete;
+
+    ~LegacyMatrix() {
+        for (size_t i = 0; i < row; ++i) {
+            delete[] arr[i];
+        }
+        delete[] arr;
+    }
+
+    double *operator[](size_t n) const {
+        return arr[n];
+    }
+
+private:
+    double **arr;
+    size_t row, col;
+};
+
+
+template<class M>
+double sweep(const M &m, size_t n) {
+    double s = 0;
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            s += m[i][j];
+        }
+    }
+    return s;
+}
+
+
+int main() {
+    bench::printHeader("Matrix storage: double** rows vs contiguous buffer");
+    for (size_t n = 8; n <= 4096; n *= 2) {
+        double bytes = double(n) * n * sizeof(double);
+
+        bench::printRow("construct double**", n, bench::secondsPerRun([&] {
+                            LegacyMatrix m(n, n);
+                            bench::doNotOptimize(m[0][0]);
+                        }),
+                        bytes);
+        bench::printRow("construct contiguous", n, bench::secondsPerRun([&] {
+                            Matrix m(n, n);
+                            bench::doNotOptimize(m[0][0]);
+                        }),
+                        bytes);
+
+        LegacyMatrix legacy(n, n);
+        Matrix matrix(n, n);
+
+        bench::printRow("copy double**", n, bench::secondsPerRun([&] {
+                            LegacyMatrix m = legacy;
+                            bench::doNotOptimize(m[0][0]);
+                        }),
+                        2 * bytes);
+        bench::printRow("copy contiguous", n, bench::secondsPerRun([&] {
+                            Matrix m = matrix;
+                            bench::doNotOptimize(m[0][0]);
+                        }),
+                        2 * bytes);
+
+        bench::printRow("sweep double**", n, bench::secondsPerRun([&] {
+                            bench::doNotOptimize(sweep(legacy, n));
+                        }),
+                        bytes);
+        bench::printRow("sweep contiguous", n, bench::secondsPerRun([&] {
+                            bench::doNotOptimize(sweep(matrix, n));
+                        }),
+                        bytes);
+        bench::printRow("sweep contiguous data()", n, bench::secondsPerRun([&] {
+                            const double *data = matrix.data();
+                            bench::doNotOptimize(std::accumulate(data, data + n * n, 0.));
+                        }),
+                        bytes);
+    }
+}
@@ -0,0 +1,86 @@
+#include "bench/bench.h"
+#include "src/gemm.h"
+#include "src/matrix.h"
+#include "src/strassen.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <string>
+
+
+using task::BasicMatrix;
+
+
+template<class T>
+BasicMatrix<T> randomMatrix(size_t rows, size_t cols) {
+    static std::mt19937 rand(42);
+    std::uniform_real_distribution<double> dist{-10., 10.};
+    BasicMatrix<T> temp(rows, cols);
+    for (size_t i = 0; i < rows * cols; ++i) {
+        temp.data()[i] = T(dist(rand));
+    }
+    return temp;
+}
+
+template<class T>
+double maxAbs(const BasicMatrix<T> &m) {
+    double result = 0;
+    for (size_t i = 0; i < m.getRow() * m.getCol(); ++i) {
+        result = std::max(result, double(std::abs(m.data()[i])));
+    }
+    return result;
+}
+
+// max |C - reference| / (u max |A| max |B|), with the reference computed in double from the same floats.
+double floatError(const BasicMatrix<float> &a, const BasicMatrix<float> &b, const BasicMatrix<float> &c,
+                  const BasicMatrix<double> &reference) {
+    double err = 0;
+    for (size_t i = 0; i < c.getRow() * c.getCol(); ++i) {
+        err = std::max(err, std::fabs(double(c.data()[i]) - reference.data()[i]));
+    }
+    return err / (std::numeric_limits<float>::epsilon() / 2 * maxAbs(a) * maxAbs(b));
+}
+
+
+int main() {
+    bench::printHeader("Square product: classical gemm vs Strassen-Winograd by crossover, 2 n^3 flops", "GFLOP/s");
+    for (size_t n : {1024, 2048, 3000, 4096}) {
+        task::Matrix a = randomMatrix<double>(n, n), b = randomMatrix<double>(n, n), c(n, n);
+        double flops = 2. * n * n * n;
+        bench::printRow("gemm", n, bench::secondsPerRun([&] {
+                            task::gemm(n, n, n, 1., a.data(), n, b.data(), n, 0., c.data(), n);
+                            bench::doNotOptimize(c.data());
+                        }, 0.2, 1),
+                        flops);
+        for (size_t crossover : {256, 512, 1024, 2048}) {
+            if (crossover >= n) {
+                break;
+            }
+            bench::printRow("strassen, crossover " + std::to_string(crossover), n, bench::secondsPerRun([&] {
+                                task::strassen(n, n, n, a.data(), n, b.data(), n, c.data(), n, crossover);
+                                bench::doNotOptimize(c.data());
+                            }, 0.2, 1),
+                            flops);
+        }
+    }
+
+    std::printf("\n%-24s %8s %7s %14s %14s %14s\n", "float error / (u|A||B|)", "n", "levels", "gemm",
+                "strassen", "strassen bound");
+    for (size_t n : {256, 512, 1024, 2048}) {
+        BasicMatrix<float> a = randomMatrix<float>(n, n), b = randomMatrix<float>(n, n);
+        BasicMatrix<double> a64(n, n), b64(n, n), reference(n, n);
+        std::copy_n(a.data(), n * n, a64.data());
+        std::copy_n(b.data(), n * n, b64.data());
+        task::gemm(n, n, n, 1., a64.data(), n, b64.data(), n, 0., reference.data(), n);
+        BasicMatrix<float> classical(n, n);
+        task::gemm(n, n, n, 1.f, a.data(), n, b.data(), n, 0.f, classical.data(), n);
+        size_t crossover = 64;
+        std::printf("%-24s %8zu %7zu %14.3g %14.3g %14.3g\n", "crossover 64", n,
+                    task::strassenLevels(n, n, n, crossover), floatError(a, b, classical, reference),
+                    floatError(a, b, task::strassenMultiply(a, b, crossover), reference),
+                    task::strassenErrorBound(n, crossover));
+    }
+}
@@ -0,0 +1,230 @@
+#include "bench/allocations.h"
+#include "bench/bench.h"
+#include "src/kernels.h"
+#include "src/matrix.h"
+#include "src/matrix_io.h"
+#include "src/thread_pool.h"
+
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+
+using task::Matrix;
+
+
+// ./bench.sh suite [--json FILE] [--max-size N] [--filter TEXT] [--label TEXT]
+//
+// Runs every case at the sizes in SIZES up to its own limit; --max-size replaces the limits, so
+// --max-size 8192 runs everything at full size. --label tags the JSON output, e.g. with a commit.
+const size_t SIZES[] = {4, 16, 64, 256, 1024, 2048, 4096, 8192};
+
+
+Matrix randomMatrix(size_t rows, size_t cols) {
+    static std::mt19937 rand(42);
+    std::uniform_real_distribution<double> dist{-10., 10.};
+    Matrix temp(rows, cols);
+    for (size_t i = 0; i < rows * cols; ++i) {
+        temp.data()[i] = dist(rand);
+    }
+    return temp;
+}
+
+std::string toText(const Matrix &a) {
+    std::stringstream stream;
+    stream.precision(17);
+    stream << a.getRow() << ' ' << a.getCol() << '\n'
+           << a;
+    return stream.str();
+}
+
+
+struct Case {
+    std::string name;
+    // Largest size run by default.
+    size_t limit;
+    // Prepares the inputs for size n and returns one run, with its flops and bytes.
+    std::function<std::function<void()>(size_t n, double &flops, double &bytes)> prepare;
+};
+
+
+std::vector<Case> cases() {
+    std::vector<Case> result;
+    auto square = [](size_t n) {
+        return double(n) * n * sizeof(double);
+    };
+    result.push_back({"construct", 8192, [=](size_t n, double &, double &bytes) {
+                          bytes = square(n);
+                          return [n] {
+                              Matrix a(n, n);
+                              bench::doNotOptimize(a.data());
+                          };
+                      }});
+    result.push_back({"copy", 8192, [=](size_t n, double &, double &bytes) {
+                          auto a = std::make_shared<Matrix>(randomMatrix(n, n));
+                          bytes = 2 * square(n);
+                          return [a] {
+                              Matrix b(*a);
+                              bench::doNotOptimize(b.data());
+                          };
+                      }});
+    result.push_back({"c = a + b", 8192, [=](size_t n, double &flops, double &bytes) {
+                          auto a = std::make_shared<Matrix>(randomMatrix(n, n));
+                          auto b = std::make_shared<Matrix>(randomMatrix(n, n));
+                          flops = double(n) * n;
+                          bytes = 3 * square(n);
+                          return [a, b] {
+                              Matrix c = *a + *b;
+                              bench::doNotOptimize(c.data());
+                          };
+                      }});
+    result.push_back({"a += b", 8192, [=](size_t n, double &flops, double &bytes) {
+                          auto a = std::make_shared<Matrix>(randomMatrix(n, n));
+                          auto b = std::make_shared<Matrix>(randomMatrix(n, n));
+                          flops = double(n) * n;
+                          bytes = 3 * square(n);
+                          return [a, b] {
+                              *a += *b;
+                          };
+                      }});
+    result.push_back({"c = 2 * a - b", 8192, [=](size_t n, double &flops, double &bytes) {
+                          auto a = std::make_shared<Matrix>(randomMatrix(n, n));
+                          auto b = std::make_shared<Matrix>(randomMatrix(n, n));
+                          flops = 2. * n * n;
+                          bytes = 3 * square(n);
+                          return [a, b] {
+                              Matrix c = 2. * *a - *b;
+                              bench::doNotOptimize(c.data());
+                          };
+                      }});
+    result.push_back({"a * b", 2048, [=](size_t n, double &flops, double &bytes) {
+                          auto a = std::make_shared<Matrix>(randomMatrix(n, n));
+                          auto b = std::make_shared<Matrix>(randomMatrix(n, n));
+                          flops = 2. * n * n * n;
+                          bytes = 3 * square(n);
+                          return [a, b] {
+                              Matrix c = *a * *b;
+                              bench::doNotOptimize(c.data());
+                          };
+                      }});
+    result.push_back({"transposed()", 8192, [=](size_t n, double &, double &bytes) {
+                          auto a = std::make_shared<Matrix>(randomMatrix(n, n));
+                          bytes = 2 * square(n);
+                          return [a] {
+                              Matrix c = a->transposed();
+                              bench::doNotOptimize(c.data());
+                          };
+                      }});
+    result.push_back({"transpose()", 8192, [=](size_t n, double &, double &bytes) {
+                          auto a = std::make_shared<Matrix>(randomMatrix(n, n));
+                          bytes = 2 * square(n);
+                          return [a] {
+                              a->transpose();
+                          };
+                      }});
+    result.push_back({"det()", 2048, [=](size_t n, double &flops, double &bytes) {
+                          auto a = std::make_shared<Matrix>(randomMatrix(n, n));
+                          flops = 2. * n * n * n / 3;
+                          bytes = square(n);
+                          return [a] {
+                              bench::doNotOptimize(a->det());
+                          };
+                      }});
+    result.push_back({"operator<<", 2048, [=](size_t n, double &, double &bytes) {
+                          auto a = std::make_shared<Matrix>(randomMatrix(n, n));
+                          bytes = double(toText(*a).size());
+                          return [a] {
+                              std::stringstream out;
+                              out.precision(17);
+                              out << *a;
+                              bench::doNotOptimize(out.tellp());
+                          };
+                      }});
+    result.push_back({"operator>>", 2048, [=](size_t n, double &, double &bytes) {
+                          auto text = std::make_shared<std::string>(toText(randomMatrix(n, n)));
+                          bytes = double(text->size());
+                          return [text] {
+                              std::istringstream in(*text);
+                              Matrix b;
+                              in >> b;
+                              bench::doNotOptimize(b.data());
+                          };
+                      }});
+    result.push_back({"writeText", 2048, [=](size_t n, double &, double &bytes) {
+                          auto a = std::make_shared<Matrix>(randomMatrix(n, n));
+                          bytes = double(toText(*a).size());
+                          return [a] {
+                              std::stringstream out;
+                              task::writeText(out, *a);
+                              bench::doNotOptimize(out.tellp());
+                          };
+                      }});
+    result.push_back({"parseText", 2048, [=](size_t n, double &, double &bytes) {
+                          auto text = std::make_shared<std::string>(toText(randomMatrix(n, n)));
+                          bytes = double(text->size());
+                          return [text] {
+                              Matrix b;
+                              task::parseText(text->data(), text->data() + text->size(), b);
+                              bench::doNotOptimize(b.data());
+                          };
+                      }});
+    return result;
+}
+
+
+int main(int argc, char **argv) {
+    std::string jsonPath, filter, label;
+    size_t maxSize = 0;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "missing value for " << arg << '\n';
+            return 1;
+        }
+        if (arg == "--json") {
+            jsonPath = argv[++i];
+        } else if (arg == "--max-size") {
+            maxSize = std::stoul(argv[++i]);
+        } else if (arg == "--filter") {
+            filter = argv[++i];
+        } else if (arg == "--label") {
+            label = argv[++i];
+        } else {
+            std::cerr << "unknown option " << arg << '\n';
+            return 1;
+        }
+    }
+
+    std::vector<bench::Measurement> results;
+    bench::printMeasurementHeader("Matrix suite, square double matrices");
+    for (const Case &c : cases()) {
+        if (c.name.find(filter) == std::string::npos) {
+            continue;
+        }
+        for (size_t n : SIZES) {
+            if (n > (maxSize != 0 ? maxSize : c.limit)) {
+                break;
+            }
+            double flops = 0, bytes = 0;
+            std::function<void()> run = c.prepare(n, flops, bytes);
+            size_t allocations = bench::allocationsPerRun(run);
+            double seconds = bench::secondsPerRun(run, 0.2, 1);
+            results.push_back({c.name, n, seconds, flops, bytes, allocations});
+            bench::printMeasurement(results.back());
+        }
+    }
+
+    if (!jsonPath.empty()) {
+        std::ofstream output(jsonPath);
+        bench::writeJson(output,
+                         {{"label", label},
+                          {"compiler", __VERSION__},
+                          {"simd", task::simdLevelName(task::simdLevel())},
+                          {"threads", std::to_string(task::threadCount())}},
+                         results);
+        std::cout << "\nWrote " << jsonPath << '\n';
+    }
+}
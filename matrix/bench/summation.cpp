@@ -0,0 +1,125 @@
+#include "bench/bench.h"
+#include "src/matrix.h"
+#include "src/summation.h"
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+
+using task::Summation;
+
+const Summation MODES[] = {Summation::PLAIN, Summation::PAIRWISE, Summation::COMPENSATED, Summation::WIDE};
+
+
+// Magnitudes spread over 2^-20..2^20 with random signs, so long sums cancel heavily.
+template<class T>
+std::vector<T> randomValues(size_t n) {
+    static std::mt19937 rand(42);
+    std::uniform_real_distribution<double> mantissa{-1., 1.};
+    std::uniform_int_distribution<int> exponent{-20, 20};
+    std::vector<T> values(n);
+    for (T &value : values) {
+        value = T(std::ldexp(mantissa(rand), exponent(rand)));
+    }
+    return values;
+}
+
+// Neumaier in long double over exact double products of the given values.
+template<class T>
+long double referenceDot(const T *x, const T *y, size_t n) {
+    long double s = 0, c = 0;
+    for (size_t i = 0; i < n; ++i) {
+        long double p = (long double) x[i] * y[i], t = s + p;
+        c += std::fabs(s) >= std::fabs(p) ? (s - t) + p : (p - t) + s;
+        s = t;
+    }
+    return s + c;
+}
+
+template<class T>
+void dotRows(const std::string &type) {
+    for (size_t n : {1000, 100000, 10000000}) {
+        std::vector<T> x = randomValues<T>(n), y = randomValues<T>(n);
+        for (Summation mode : MODES) {
+            bench::printRow("dot " + type + ", " + task::summationName(mode), n, bench::secondsPerRun([&] {
+                                bench::doNotOptimize(task::dot(x.data(), y.data(), n, mode));
+                            }),
+                            double(n));
+        }
+    }
+}
+
+template<class T>
+void dotErrors(const std::string &type) {
+    for (size_t n : {1000, 100000, 10000000}) {
+        std::vector<T> x = randomValues<T>(n), y = randomValues<T>(n);
+        long double reference = referenceDot(x.data(), y.data(), n);
+        std::printf("%-28s %10zu", ("dot " + type).c_str(), n);
+        for (Summation mode : MODES) {
+            long double value = task::dot(x.data(), y.data(), n, mode);
+            std::printf(" %12.2Le", std::fabs(value - reference) / std::fabs(reference));
+        }
+        std::printf("\n");
+    }
+}
+
+template<class T>
+void productErrors(const std::string &type, size_t n) {
+    task::BasicMatrix<T> a(n, n), b(n, n);
+    std::vector<T> x = randomValues<T>(n * n), y = randomValues<T>(n * n);
+    std::copy(x.begin(), x.end(), a.data());
+    std::copy(y.begin(), y.end(), b.data());
+    std::vector<T> column(n);
+    std::printf("%-28s %10zu", ("a * b, " + type).c_str(), n);
+    for (Summation mode : MODES) {
+        task::setSummation(mode);
+        task::BasicMatrix<T> c = a * b;
+        double worst = 0;
+        for (size_t i = 0; i < n; i += 7) {
+            for (size_t j = 0; j < n; j += 7) {
+                for (size_t p = 0; p < n; ++p) {
+                    column[p] = b[p][j];
+                }
+                long double reference = referenceDot(a.data() + i * n, column.data(), n);
+                worst = std::max(worst, double(std::fabs(c[i][j] - reference) / std::fabs(reference)));
+            }
+        }
+        std::printf(" %12.2e", worst);
+    }
+    task::setSummation(Summation::PLAIN);
+    std::printf("\n");
+}
+
+
+int main() {
+    bench::printHeader("Accumulation modes: dot products and products, elements (or 2 n^3 flops)", "G/s");
+    dotRows<double>("double");
+    dotRows<float>("float");
+    for (size_t n : {256, 1024}) {
+        task::Matrix a(n, n), b(n, n);
+        std::vector<double> x = randomValues<double>(n * n);
+        std::copy(x.begin(), x.end(), a.data());
+        std::copy(x.rbegin(), x.rend(), b.data());
+        for (Summation mode : MODES) {
+            task::setSummation(mode);
+            bench::printRow(std::string("a * b double, ") + task::summationName(mode), n, bench::secondsPerRun([&] {
+                                bench::doNotOptimize(a * b);
+                            }, 0.2, 1),
+                            2. * n * n * n);
+        }
+        task::setSummation(Summation::PLAIN);
+    }
+
+    std::printf("\n%-28s %10s", "relative error", "n");
+    for (Summation mode : MODES) {
+        std::printf(" %12s", task::summationName(mode));
+    }
+    std::printf("\n");
+    dotErrors<double>("double");
+    dotErrors<float>("float");
+    productErrors<double>("double", 512);
+    productErrors<float>("float", 512);
+}
@@ -0,0 +1,87 @@
+#include "bench/bench.h"
+#include "src/matrix.h"
+
+#include <random>
+
+
+using task::Matrix;
+
+
+Matrix randomMatrix(size_t rows, size_t cols) {
+    static std::mt19937 rand(42);
+    std::uniform_real_distribution<double> dist{-10., 10.};
+    Matrix temp(rows, cols);
+    for (size_t i = 0; i < rows * cols; ++i) {
+        temp.data()[i] = dist(rand);
+    }
+    return temp;
+}
+
+Matrix copyBlock(const Matrix &a, size_t row, size_t col, size_t rows, size_t cols) {
+    Matrix temp(rows, cols);
+    for (size_t i = 0; i < rows; ++i) {
+        for (size_t j = 0; j < cols; ++j) {
+            temp[i][j] = a[row + i][col + j];
+        }
+    }
+    return temp;
+}
+
+
+int main() {
+    bench::printHeader("Column sums: getColumn copies vs colView", "GB/s");
+    for (size_t n : {256, 1024, 2048}) {
+        Matrix a = randomMatrix(n, n);
+        double bytes = double(n) * n * sizeof(double);
+        bench::printRow("getColumn", n, bench::secondsPerRun([&] {
+                            double s = 0;
+                            for (size_t j = 0; j < n; ++j) {
+                                for (double v : a.getColumn(j)) {
+                                    s += v;
+                                }
+                            }
+                            bench::doNotOptimize(s);
+                        }),
+                        bytes);
+        bench::printRow("colView", n, bench::secondsPerRun([&] {
+                            double s = 0;
+                            for (size_t j = 0; j < n; ++j) {
+                                task::ColView column = a.colView(j);
+                                for (size_t i = 0; i < n; ++i) {
+                                    s += column[i];
+                                }
+                            }
+                            bench::doNotOptimize(s);
+                        }),
+                        bytes);
+    }
+
+    bench::printHeader("2 x 2 blocked product C_ij += A_ik B_kj", "GFLOP/s");
+    for (size_t n : {256, 1024, 2048}) {
+        size_t h = n / 2;
+        Matrix a = randomMatrix(n, n), b = randomMatrix(n, n), c(n, n);
+        bench::printRow("copied blocks", n, bench::secondsPerRun([&] {
+                            for (size_t i = 0; i < 2; ++i) {
+                                for (size_t j = 0; j < 2; ++j) {
+                                    Matrix s = copyBlock(a, i * h, 0, h, h) * copyBlock(b, 0, j * h, h, h) +
+                                               copyBlock(a, i * h, h, h, h) * copyBlock(b, h, j * h, h, h);
+                                    for (size_t r = 0; r < h; ++r) {
+                                        for (size_t q = 0; q < h; ++q) {
+                                            c[i * h + r][j * h + q] = s[r][q];
+                                        }
+                                    }
+                                }
+                            }
+                        }, 0.2, 1),
+                        2. * n * n * n);
+        bench::printRow("views", n, bench::secondsPerRun([&] {
+                            for (size_t i = 0; i < 2; ++i) {
+                                for (size_t j = 0; j < 2; ++j) {
+                                    c.block(i * h, j * h, h, h) = a.block(i * h, 0, h, h) * b.block(0, j * h, h, h) +
+                                                                  a.block(i * h, h, h, h) * b.block(h, j * h, h, h);
+                                }
+                            }
+                        }, 0.2, 1),
+                        2. * n * n * n);
+    }
+}
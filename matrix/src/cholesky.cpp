@@ -0,0 +1,154 @@
+#include "cholesky.h"
+#include "gemm.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace task;
+
+namespace {
+
+    template<class T>
+    const BasicMatrix<T> &checkSquare(const BasicMatrix<T> &a) {
+        if (a.getRow() != a.getCol()) {
+            throw SizeMismatchException();
+        }
+        return a;
+    }
+
+}// namespace
+
+template<class T>
+BasicCholesky<T>::BasicCholesky(const BasicMatrix<T> &a) : l(checkSquare(a)) {
+    factorize();
+}
+
+template<class T>
+size_t BasicCholesky<T>::size() const {
+    return l.getRow();
+}
+
+template<class T>
+const BasicMatrix<T> &BasicCholesky<T>::factor() const {
+    return l;
+}
+
+template<class T>
+void BasicCholesky<T>::factorize() {
+    size_t n = size();
+    CounterScope counter(Operation::FACTORIZE, 0, n * n * n / 3);
+    T *a = l.data();
+    for (size_t j = 0; j < n; j += CHOLESKY_BLOCK) {
+        size_t jb = std::min(CHOLESKY_BLOCK, n - j);
+        factorizeDiagonal(j, jb);
+
+        size_t rest = n - j - jb;
+        if (rest == 0) {
+            continue;
+        }
+        // L21 = A21 L11^-H, one row at a time.
+        for (size_t r = j + jb; r < n; ++r) {
+            T *row = a + r * n;
+            for (size_t c = j; c < j + jb; ++c) {
+                T sum = row[c];
+                for (size_t p = j; p < c; ++p) {
+                    sum -= row[p] * conjugate(a[c * n + p]);
+                }
+                row[c] = sum / a[c * n + c];
+            }
+        }
+        // A22 -= L21 L21^H, only the blocks on and below the diagonal.
+        std::vector<T> adjoint(jb * rest);
+        for (size_t r = 0; r < rest; ++r) {
+            for (size_t i = 0; i < jb; ++i) {
+                adjoint[i * rest + r] = conjugate(a[(j + jb + r) * n + j + i]);
+            }
+        }
+        for (size_t r = 0; r < rest; r += CHOLESKY_BLOCK) {
+            size_t rb = std::min(CHOLESKY_BLOCK, rest - r);
+            gemm(rb, r + rb, jb, T(-1), a + (j + jb + r) * n + j, n, adjoint.data(), rest,
+                 T(1), a + (j + jb + r) * n + j + jb, n);
+        }
+    }
+    for (size_t i = 0; i < n; ++i) {
+        std::fill(a + i * n + i + 1, a + i * n + n, T(0));
+    }
+}
+
+template<class T>
+void BasicCholesky<T>::factorizeDiagonal(size_t first, size_t width) {
+    using Real = decltype(std::abs(T()));
+    size_t n = size();
+    T *a = l.data();
+    for (size_t c = first; c < first + width; ++c) {
+        T *row = a + c * n;
+        Real d = std::real(row[c]);
+        for (size_t p = first; p < c; ++p) {
+            d -= std::norm(row[p]);
+        }
+        if (!(d > Real(0))) {
+            throw NotPositiveDefiniteException();
+        }
+        T root = T(std::sqrt(d));
+        row[c] = root;
+        for (size_t r = c + 1; r < first + width; ++r) {
+            T sum = a[r * n + c];
+            for (size_t p = first; p < c; ++p) {
+                sum -= a[r * n + p] * conjugate(row[p]);
+            }
+            a[r * n + c] = sum / root;
+        }
+    }
+}
+
+template<class T>
+T BasicCholesky<T>::det() const {
+    T d = T(1);
+    for (size_t i = 0; i < size(); ++i) {
+        d *= l[i][i] * l[i][i];
+    }
+    return d;
+}
+
+template<class T>
+void BasicCholesky<T>::solveInPlace(T *x, size_t cols) const {
+    size_t n = size();
+    CounterScope counter(Operation::SOLVE, 0, 2 * n * n * cols);
+    BasicMatrix<T> adjoint(n, n);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j <= i; ++j) {
+            adjoint[j][i] = conjugate(l[i][j]);
+        }
+    }
+    solveTriangular(true, false, n, cols, l.data(), n, x, cols);
+    solveTriangular(false, false, n, cols, adjoint.data(), n, x, cols);
+}
+
+template<class T>
+BasicMatrix<T> BasicCholesky<T>::solve(const BasicMatrix<T> &b) const {
+    if (b.getRow() != size()) {
+        throw SizeMismatchException();
+    }
+    BasicMatrix<T> x(b);
+    solveInPlace(x.data(), x.getCol());
+    return x;
+}
+
+template<class T>
+std::vector<T> BasicCholesky<T>::solve(const std::vector<T> &b) const {
+    if (b.size() != size()) {
+        throw SizeMismatchException();
+    }
+    std::vector<T> x(b);
+    solveInPlace(x.data(), 1);
+    return x;
+}
+
+template<class T>
+BasicMatrix<T> BasicCholesky<T>::inverse() const {
+    return solve(BasicMatrix<T>(size(), size()));
+}
+
+template class task::BasicCholesky<float>;
+template class task::BasicCholesky<double>;
+template class task::BasicCholesky<std::complex<double>>;
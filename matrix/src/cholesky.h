@@ -0,0 +1,50 @@
+#pragma once
+
+#include "matrix.h"
+
+#include <vector>
+
+
+namespace task {
+
+    const size_t CHOLESKY_BLOCK = 64;
+
+    // A = L L^H for Hermitian positive definite A, factored CHOLESKY_BLOCK columns at a time with
+    // the trailing update done by gemm. Only the lower triangle of A is read.
+    // Instantiated for float, double and std::complex<double>.
+    template<class T>
+    class BasicCholesky {
+    public:
+        // Throws NotPositiveDefiniteException if a pivot is not positive.
+        explicit BasicCholesky(const BasicMatrix<T> &a);
+
+        size_t size() const;
+
+        T det() const;
+
+        BasicMatrix<T> solve(const BasicMatrix<T> &b) const;
+
+        std::vector<T> solve(const std::vector<T> &b) const;
+
+        BasicMatrix<T> inverse() const;
+
+        // L, zero above the diagonal.
+        const BasicMatrix<T> &factor() const;
+
+    private:
+        BasicMatrix<T> l;
+
+        void factorize();
+
+        void factorizeDiagonal(size_t first, size_t width);
+
+        void solveInPlace(T *x, size_t cols) const;
+    };
+
+    using Cholesky = BasicCholesky<double>;
+
+    extern template class BasicCholesky<float>;
+    extern template class BasicCholesky<double>;
+    extern template class BasicCholesky<std::complex<double>>;
+
+}// namespace task
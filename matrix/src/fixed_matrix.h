@@ -0,0 +1,119 @@
+#pragma once
+
+#include "matrix.h"
+
+#include <cstddef>
+#include <initializer_list>
+
+
+namespace task {
+
+    // Matrix with compile-time dimensions and inline storage, meant for small transforms.
+    // Size checks happen at compile time; det() and inverse() are closed-form for N <= 4.
+    template<class T, size_t R, size_t C>
+    class FixedMatrix {
+        static_assert(R > 0 && C > 0, "FixedMatrix dimensions must be positive");
+
+    public:
+        using value_type = T;
+
+        // Identity, like Matrix(rows, cols).
+        constexpr FixedMatrix();
+
+        // Row-major values; throws SizeMismatchException unless exactly R * C are given.
+        constexpr FixedMatrix(std::initializer_list<T> list);
+
+        // Throws SizeMismatchException if matrix is not R x C.
+        explicit FixedMatrix(const BasicMatrix<T> &matrix);
+
+        operator BasicMatrix<T>() const;
+
+        BasicMatrix<T> toMatrix() const;
+
+        static constexpr size_t getRow() {
+            return R;
+        }
+
+        static constexpr size_t getCol() {
+            return C;
+        }
+
+        constexpr T *operator[](size_t n) {
+            return values + n * C;
+        }
+
+        constexpr const T *operator[](size_t n) const {
+            return values + n * C;
+        }
+
+        constexpr T *data() {
+            return values;
+        }
+
+        constexpr const T *data() const {
+            return values;
+        }
+
+        constexpr T &get(size_t row, size_t col);
+
+        constexpr const T &get(size_t row, size_t col) const;
+
+        constexpr void set(size_t row, size_t col, const T &value);
+
+        constexpr FixedMatrix &operator+=(const FixedMatrix &a);
+
+        constexpr FixedMatrix &operator-=(const FixedMatrix &a);
+
+        constexpr FixedMatrix &operator*=(const FixedMatrix &a);
+
+        constexpr FixedMatrix &operator*=(const T &number);
+
+        constexpr FixedMatrix<T, C, R> transposed() const;
+
+        constexpr T trace() const;
+
+        // Closed-form up to 4 x 4, through Matrix::det() above that.
+        constexpr T det() const;
+
+        // Adjugate over det() up to 4 x 4, LU above that. Throws SingularMatrixException when det() is zero.
+        constexpr FixedMatrix inverse() const;
+
+    private:
+        T values[R * C] = {};
+    };
+
+    using Matrix2 = FixedMatrix<double, 2, 2>;
+    using Matrix3 = FixedMatrix<double, 3, 3>;
+    using Matrix4 = FixedMatrix<double, 4, 4>;
+
+    template<class T, size_t R, size_t C>
+    constexpr FixedMatrix<T, R, C> operator+(FixedMatrix<T, R, C> a, const FixedMatrix<T, R, C> &b);
+
+    template<class T, size_t R, size_t C>
+    constexpr FixedMatrix<T, R, C> operator-(FixedMatrix<T, R, C> a, const FixedMatrix<T, R, C> &b);
+
+    template<class T, size_t R, size_t C>
+    constexpr FixedMatrix<T, R, C> operator-(FixedMatrix<T, R, C> a);
+
+    template<class T, size_t R, size_t C>
+    constexpr FixedMatrix<T, R, C> operator*(FixedMatrix<T, R, C> a, typename FixedMatrix<T, R, C>::value_type number);
+
+    template<class T, size_t R, size_t C>
+    constexpr FixedMatrix<T, R, C> operator*(typename FixedMatrix<T, R, C>::value_type number, FixedMatrix<T, R, C> a);
+
+    template<class T, size_t R, size_t K, size_t C>
+    constexpr FixedMatrix<T, R, C> operator*(const FixedMatrix<T, R, K> &a, const FixedMatrix<T, K, C> &b);
+
+    template<class T, size_t R, size_t C>
+    constexpr bool operator==(const FixedMatrix<T, R, C> &a, const FixedMatrix<T, R, C> &b);
+
+    template<class T, size_t R, size_t C>
+    constexpr bool operator!=(const FixedMatrix<T, R, C> &a, const FixedMatrix<T, R, C> &b);
+
+    template<class T, size_t R, size_t C>
+    std::ostream &operator<<(std::ostream &output, const FixedMatrix<T, R, C> &matrix);
+
+}// namespace task
+
+
+#include "fixed_matrix.tpp"
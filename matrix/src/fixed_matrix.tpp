@@ -0,0 +1,275 @@
+#include "lu.h"
+
+#include <algorithm>
+#include <complex>
+#include <type_traits>
+
+namespace task {
+
+    template<class T>
+    constexpr auto magnitude(const T &value) {
+        if constexpr (std::is_arithmetic<T>::value) {
+            return value < T(0) ? -value : value;
+        } else {
+            return std::abs(value);
+        }
+    }
+
+    template<class T, size_t R, size_t C>
+    constexpr FixedMatrix<T, R, C>::FixedMatrix() {
+        for (size_t i = 0; i < std::min(R, C); ++i) {
+            values[i * C + i] = T(1);
+        }
+    }
+
+    template<class T, size_t R, size_t C>
+    constexpr FixedMatrix<T, R, C>::FixedMatrix(std::initializer_list<T> list) {
+        if (list.size() != R * C) {
+            throw SizeMismatchException();
+        }
+        size_t i = 0;
+        for (const T &value : list) {
+            values[i++] = value;
+        }
+    }
+
+    template<class T, size_t R, size_t C>
+    FixedMatrix<T, R, C>::FixedMatrix(const BasicMatrix<T> &matrix) {
+        if (matrix.getRow() != R || matrix.getCol() != C) {
+            throw SizeMismatchException();
+        }
+        std::copy_n(matrix.data(), R * C, values);
+    }
+
+    template<class T, size_t R, size_t C>
+    FixedMatrix<T, R, C>::operator BasicMatrix<T>() const {
+        return toMatrix();
+    }
+
+    template<class T, size_t R, size_t C>
+    BasicMatrix<T> FixedMatrix<T, R, C>::toMatrix() const {
+        BasicMatrix<T> temp(R, C);
+        std::copy_n(values, R * C, temp.data());
+        return temp;
+    }
+
+    template<class T, size_t R, size_t C>
+    constexpr T &FixedMatrix<T, R, C>::get(size_t row, size_t col) {
+        if (row >= R || col >= C) {
+            throw OutOfBoundsException();
+        }
+        return values[row * C + col];
+    }
+
+    template<class T, size_t R, size_t C>
+    constexpr const T &FixedMatrix<T, R, C>::get(size_t row, size_t col) const {
+        if (row >= R || col >= C) {
+            throw OutOfBoundsException();
+        }
+        return values[row * C + col];
+    }
+
+    template<class T, size_t R, size_t C>
+    constexpr void FixedMatrix<T, R, C>::set(size_t row, size_t col, const T &value) {
+        get(row, col) = value;
+    }
+
+    template<class T, size_t R, size_t C>
+    constexpr FixedMatrix<T, R, C> &FixedMatrix<T, R, C>::operator+=(const FixedMatrix &a) {
+#pragma GCC unroll 16
+        for (size_t i = 0; i < R * C; ++i) {
+            values[i] += a.values[i];
+        }
+        return *this;
+    }
+
+    template<class T, size_t R, size_t C>
+    constexpr FixedMatrix<T, R, C> &FixedMatrix<T, R, C>::operator-=(const FixedMatrix &a) {
+#pragma GCC unroll 16
+        for (size_t i = 0; i < R * C; ++i) {
+            values[i] -= a.values[i];
+        }
+        return *this;
+    }
+
+    template<class T, size_t R, size_t C>
+    constexpr FixedMatrix<T, R, C> &FixedMatrix<T, R, C>::operator*=(const FixedMatrix &a) {
+        static_assert(R == C, "in-place product needs a square matrix");
+        return *this = *this * a;
+    }
+
+    template<class T, size_t R, size_t C>
+    constexpr FixedMatrix<T, R, C> &FixedMatrix<T, R, C>::operator*=(const T &number) {
+#pragma GCC unroll 16
+        for (size_t i = 0; i < R * C; ++i) {
+            values[i] *= number;
+        }
+        return *this;
+    }
+
+    template<class T, size_t R, size_t C>
+    constexpr FixedMatrix<T, C, R> FixedMatrix<T, R, C>::transposed() const {
+        FixedMatrix<T, C, R> temp;
+#pragma GCC unroll 16
+        for (size_t i = 0; i < R; ++i) {
+#pragma GCC unroll 16
+            for (size_t j = 0; j < C; ++j) {
+                temp[j][i] = values[i * C + j];
+            }
+        }
+        return temp;
+    }
+
+    template<class T, size_t R, size_t C>
+    constexpr T FixedMatrix<T, R, C>::trace() const {
+        static_assert(R == C, "trace needs a square matrix");
+        T s = T(0);
+        for (size_t i = 0; i < R; ++i) {
+            s += values[i * C + i];
+        }
+        return s;
+    }
+
+    template<class T, size_t R, size_t C>
+    constexpr T FixedMatrix<T, R, C>::det() const {
+        static_assert(R == C, "det needs a square matrix");
+        const T *a = values;
+        if constexpr (R == 1) {
+            return a[0];
+        } else if constexpr (R == 2) {
+            return a[0] * a[3] - a[1] * a[2];
+        } else if constexpr (R == 3) {
+            return a[0] * (a[4] * a[8] - a[5] * a[7]) -
+                   a[1] * (a[3] * a[8] - a[5] * a[6]) +
+                   a[2] * (a[3] * a[7] - a[4] * a[6]);
+        } else if constexpr (R == 4) {
+            // 2 x 2 minors of the top two rows (s) and the bottom two rows (c).
+            T s0 = a[0] * a[5] - a[4] * a[1], s1 = a[0] * a[6] - a[4] * a[2], s2 = a[0] * a[7] - a[4] * a[3];
+            T s3 = a[1] * a[6] - a[5] * a[2], s4 = a[1] * a[7] - a[5] * a[3], s5 = a[2] * a[7] - a[6] * a[3];
+            T c5 = a[10] * a[15] - a[14] * a[11], c4 = a[9] * a[15] - a[13] * a[11], c3 = a[9] * a[14] - a[13] * a[10];
+            T c2 = a[8] * a[15] - a[12] * a[11], c1 = a[8] * a[14] - a[12] * a[10], c0 = a[8] * a[13] - a[12] * a[9];
+            return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+        } else {
+            return toMatrix().det();
+        }
+    }
+
+    template<class T, size_t R, size_t C>
+    constexpr FixedMatrix<T, R, C> FixedMatrix<T, R, C>::inverse() const {
+        static_assert(R == C, "inverse needs a square matrix");
+        static_assert(!std::is_integral<T>::value, "inverse needs a field element type");
+        if constexpr (R > 4) {
+            return FixedMatrix(BasicLU<T>(toMatrix()).inverse());
+        } else {
+            T d = det();
+            if (d == T(0)) {
+                throw SingularMatrixException();
+            }
+            const T *a = values;
+            FixedMatrix temp;
+            T *b = temp.values;
+            if constexpr (R == 1) {
+                b[0] = T(1);
+            } else if constexpr (R == 2) {
+                b[0] = a[3], b[1] = -a[1];
+                b[2] = -a[2], b[3] = a[0];
+            } else if constexpr (R == 3) {
+                b[0] = a[4] * a[8] - a[5] * a[7], b[1] = a[2] * a[7] - a[1] * a[8], b[2] = a[1] * a[5] - a[2] * a[4];
+                b[3] = a[5] * a[6] - a[3] * a[8], b[4] = a[0] * a[8] - a[2] * a[6], b[5] = a[2] * a[3] - a[0] * a[5];
+                b[6] = a[3] * a[7] - a[4] * a[6], b[7] = a[1] * a[6] - a[0] * a[7], b[8] = a[0] * a[4] - a[1] * a[3];
+            } else {
+                T s0 = a[0] * a[5] - a[4] * a[1], s1 = a[0] * a[6] - a[4] * a[2], s2 = a[0] * a[7] - a[4] * a[3];
+                T s3 = a[1] * a[6] - a[5] * a[2], s4 = a[1] * a[7] - a[5] * a[3], s5 = a[2] * a[7] - a[6] * a[3];
+                T c5 = a[10] * a[15] - a[14] * a[11], c4 = a[9] * a[15] - a[13] * a[11], c3 = a[9] * a[14] - a[13] * a[10];
+                T c2 = a[8] * a[15] - a[12] * a[11], c1 = a[8] * a[14] - a[12] * a[10], c0 = a[8] * a[13] - a[12] * a[9];
+                b[0] = a[5] * c5 - a[6] * c4 + a[7] * c3;
+                b[1] = -a[1] * c5 + a[2] * c4 - a[3] * c3;
+                b[2] = a[13] * s5 - a[14] * s4 + a[15] * s3;
+                b[3] = -a[9] * s5 + a[10] * s4 - a[11] * s3;
+                b[4] = -a[4] * c5 + a[6] * c2 - a[7] * c1;
+                b[5] = a[0] * c5 - a[2] * c2 + a[3] * c1;
+                b[6] = -a[12] * s5 + a[14] * s2 - a[15] * s1;
+                b[7] = a[8] * s5 - a[10] * s2 + a[11] * s1;
+                b[8] = a[4] * c4 - a[5] * c2 + a[7] * c0;
+                b[9] = -a[0] * c4 + a[1] * c2 - a[3] * c0;
+                b[10] = a[12] * s4 - a[13] * s2 + a[15] * s0;
+                b[11] = -a[8] * s4 + a[9] * s2 - a[11] * s0;
+                b[12] = -a[4] * c3 + a[5] * c1 - a[6] * c0;
+                b[13] = a[0] * c3 - a[1] * c1 + a[2] * c0;
+                b[14] = -a[12] * s3 + a[13] * s1 - a[14] * s0;
+                b[15] = a[8] * s3 - a[9] * s1 + a[10] * s0;
+            }
+            return temp *= T(1) / d;
+        }
+    }
+
+    template<class T, size_t R, size_t C>
+    constexpr FixedMatrix<T, R, C> operator+(FixedMatrix<T, R, C> a, const FixedMatrix<T, R, C> &b) {
+        return a += b;
+    }
+
+    template<class T, size_t R, size_t C>
+    constexpr FixedMatrix<T, R, C> operator-(FixedMatrix<T, R, C> a, const FixedMatrix<T, R, C> &b) {
+        return a -= b;
+    }
+
+    template<class T, size_t R, size_t C>
+    constexpr FixedMatrix<T, R, C> operator-(FixedMatrix<T, R, C> a) {
+        return a *= T(-1);
+    }
+
+    template<class T, size_t R, size_t C>
+    constexpr FixedMatrix<T, R, C> operator*(FixedMatrix<T, R, C> a, typename FixedMatrix<T, R, C>::value_type number) {
+        return a *= number;
+    }
+
+    template<class T, size_t R, size_t C>
+    constexpr FixedMatrix<T, R, C> operator*(typename FixedMatrix<T, R, C>::value_type number, FixedMatrix<T, R, C> a) {
+        return a *= number;
+    }
+
+    template<class T, size_t R, size_t K, size_t C>
+    constexpr FixedMatrix<T, R, C> operator*(const FixedMatrix<T, R, K> &a, const FixedMatrix<T, K, C> &b) {
+        FixedMatrix<T, R, C> temp;
+#pragma GCC unroll 16
+        for (size_t i = 0; i < R; ++i) {
+#pragma GCC unroll 16
+            for (size_t j = 0; j < C; ++j) {
+                T s = T(0);
+#pragma GCC unroll 16
+                for (size_t k = 0; k < K; ++k) {
+                    s += a[i][k] * b[k][j];
+                }
+                temp[i][j] = s;
+            }
+        }
+        return temp;
+    }
+
+    template<class T, size_t R, size_t C>
+    constexpr bool operator==(const FixedMatrix<T, R, C> &a, const FixedMatrix<T, R, C> &b) {
+        for (size_t i = 0; i < R * C; ++i) {
+            if (!(magnitude(a.data()[i] - b.data()[i]) <= MatrixTraits<T>::EPS)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template<class T, size_t R, size_t C>
+    constexpr bool operator!=(const FixedMatrix<T, R, C> &a, const FixedMatrix<T, R, C> &b) {
+        return !(a == b);
+    }
+
+    template<class T, size_t R, size_t C>
+    std::ostream &operator<<(std::ostream &output, const FixedMatrix<T, R, C> &matrix) {
+        for (size_t i = 0; i < R; ++i) {
+            for (size_t j = 0; j < C; ++j) {
+                output << matrix[i][j] << " ";
+            }
+            output << "\n";
+        }
+        return output;
+    }
+
+}// namespace task
@@ -0,0 +1,199 @@
+#include "gemm.h"
+#include "kernels.h"
+#include "matrix_memory.h"
+#include "summation.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <complex>
+#include <cstdint>
+#include <type_traits>
+
+using namespace task;
+
+namespace {
+
+    template<class T>
+    struct PackBuffer {
+        T *data = nullptr;
+        size_t size;
+        std::pmr::memory_resource *resource;
+
+        PackBuffer(size_t size, std::pmr::memory_resource *resource) : size(size), resource(resource) {
+            data = static_cast<T *>(resource->allocate(size * sizeof(T), 64));
+        }
+
+        PackBuffer(const PackBuffer &) = delete;
+
+        PackBuffer &operator=(const PackBuffer &) = delete;
+
+        ~PackBuffer() {
+            resource->deallocate(data, size * sizeof(T), 64);
+        }
+    };
+
+    // Packs an mc x kc block of A into GEMM_MR-row panels stored column by column.
+    template<class T>
+    void packA(size_t mc, size_t kc, const T *a, size_t lda, T *packed) {
+        for (size_t i = 0; i < mc; i += GEMM_MR) {
+            size_t rows = std::min(GEMM_MR, mc - i);
+            for (size_t p = 0; p < kc; ++p) {
+                for (size_t r = 0; r < rows; ++r) {
+                    packed[r] = a[(i + r) * lda + p];
+                }
+                for (size_t r = rows; r < GEMM_MR; ++r) {
+                    packed[r] = T(0);
+                }
+                packed += GEMM_MR;
+            }
+        }
+    }
+
+    // Packs a kc x nc block of B into GEMM_NR-column panels stored row by row.
+    template<class T>
+    void packB(size_t kc, size_t nc, const T *b, size_t ldb, T *packed) {
+        for (size_t j = 0; j < nc; j += GEMM_NR) {
+            size_t cols = std::min(GEMM_NR, nc - j);
+            for (size_t p = 0; p < kc; ++p) {
+                const T *src = b + p * ldb + j;
+                for (size_t c = 0; c < cols; ++c) {
+                    packed[c] = src[c];
+                }
+                for (size_t c = cols; c < GEMM_NR; ++c) {
+                    packed[c] = T(0);
+                }
+                packed += GEMM_NR;
+            }
+        }
+    }
+
+    template<class T>
+    void scale(size_t m, size_t n, T beta, T *c, size_t ldc) {
+        if (beta == T(1)) {
+            return;
+        }
+        for (size_t i = 0; i < m; ++i) {
+            T *row = c + i * ldc;
+            if (beta == T(0)) {
+                std::fill_n(row, n, T(0));
+            } else {
+                for (size_t j = 0; j < n; ++j) {
+                    row[j] *= beta;
+                }
+            }
+        }
+    }
+
+    // c += alpha * (row of A) . (column of B) for every element, each dot product summed in the
+    // given mode over the whole inner dimension. B is transposed GEMM_DOT_NC columns at a time.
+    template<class T>
+    void gemmDot(size_t m, size_t n, size_t k, T alpha, const T *a, size_t lda, const T *b, size_t ldb,
+                 T *c, size_t ldc, Summation mode) {
+        PackBuffer<T> packed(GEMM_DOT_NC * k, matrixResource());
+        size_t grain = std::max<size_t>(1, PARALLEL_THRESHOLD / (GEMM_DOT_NC * k));
+        for (size_t jc = 0; jc < n; jc += GEMM_DOT_NC) {
+            size_t nc = std::min(GEMM_DOT_NC, n - jc);
+            for (size_t p = 0; p < k; ++p) {
+                for (size_t j = 0; j < nc; ++j) {
+                    packed.data[j * k + p] = b[p * ldb + jc + j];
+                }
+            }
+            parallelFor(m, grain, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    for (size_t j = 0; j < nc; ++j) {
+                        c[i * ldc + jc + j] += alpha * dot(a + i * lda, packed.data + j * k, k, mode);
+                    }
+                }
+            });
+        }
+    }
+
+}// namespace
+
+template<class T>
+void task::gemm(size_t m, size_t n, size_t k, T alpha,
+                const T *a, size_t lda, const T *b, size_t ldb,
+                T beta, T *c, size_t ldc) {
+    scale(m, n, beta, c, ldc);
+    if (m == 0 || n == 0 || k == 0 || alpha == T(0)) {
+        return;
+    }
+    if constexpr (std::is_floating_point<T>::value) {
+        Summation mode = summation();
+        if (mode != Summation::PLAIN) {
+            gemmDot(m, n, k, alpha, a, lda, b, ldb, c, ldc, mode);
+            return;
+        }
+    }
+
+    // Per call, so it comes from matrixResource() like the matrices themselves.
+    PackBuffer<T> packedB(GEMM_KC * ((std::min(n, GEMM_NC) + GEMM_NR - 1) / GEMM_NR * GEMM_NR), matrixResource());
+
+    auto microKernel = kernels<T>().microKernel;
+    size_t blocks = (m + GEMM_MC - 1) / GEMM_MC;
+    for (size_t jc = 0; jc < n; jc += GEMM_NC) {
+        size_t nc = std::min(GEMM_NC, n - jc);
+        for (size_t pc = 0; pc < k; pc += GEMM_KC) {
+            size_t kc = std::min(GEMM_KC, k - pc);
+            packB(kc, nc, b + pc * ldb + jc, ldb, packedB.data);
+            size_t grain = std::max<size_t>(1, PARALLEL_THRESHOLD / (GEMM_MC * kc * nc));
+            parallelFor(blocks, grain, [&](size_t first, size_t last) {
+                thread_local PackBuffer<T> packedA(GEMM_MC * GEMM_KC, std::pmr::new_delete_resource());
+                for (size_t ic = first * GEMM_MC; ic < std::min(m, last * GEMM_MC); ic += GEMM_MC) {
+                    size_t mc = std::min(GEMM_MC, m - ic);
+                    packA(mc, kc, a + ic * lda + pc, lda, packedA.data);
+                    for (size_t jr = 0; jr < nc; jr += GEMM_NR) {
+                        for (size_t ir = 0; ir < mc; ir += GEMM_MR) {
+                            microKernel(kc, alpha, packedA.data + ir * kc, packedB.data + jr * kc,
+                                        c + (ic + ir) * ldc + jc + jr, ldc,
+                                        std::min(GEMM_MR, mc - ir), std::min(GEMM_NR, nc - jr));
+                        }
+                    }
+                }
+            });
+        }
+    }
+}
+
+template<class T>
+void task::solveTriangular(bool lower, bool unitDiagonal, size_t n, size_t cols,
+                           const T *a, size_t lda, T *b, size_t ldb) {
+    const Kernels<T> &k = kernels<T>();
+    for (size_t block = 0; block < n; block += TRSM_BLOCK) {
+        size_t rows = std::min(TRSM_BLOCK, n - block);
+        // First row of the block and the range of rows it depends on.
+        size_t first = lower ? block : n - block - rows;
+        size_t solved = lower ? 0 : first + rows;
+        gemm(rows, cols, block, T(-1), a + first * lda + solved, lda, b + solved * ldb, ldb,
+             T(1), b + first * ldb, ldb);
+        for (size_t r = 0; r < rows; ++r) {
+            size_t i = lower ? first + r : first + rows - 1 - r;
+            size_t begin = lower ? first : i + 1, end = lower ? i : first + rows;
+            for (size_t p = begin; p < end; ++p) {
+                k.axpy(b + i * ldb, -a[i * lda + p], b + p * ldb, cols);
+            }
+            if (!unitDiagonal) {
+                k.scale(b + i * ldb, T(1) / a[i * lda + i], cols);
+            }
+        }
+    }
+}
+
+template void task::gemm<float>(size_t, size_t, size_t, float, const float *, size_t,
+                                const float *, size_t, float, float *, size_t);
+template void task::gemm<double>(size_t, size_t, size_t, double, const double *, size_t,
+                                 const double *, size_t, double, double *, size_t);
+template void task::gemm<int64_t>(size_t, size_t, size_t, int64_t, const int64_t *, size_t,
+                                  const int64_t *, size_t, int64_t, int64_t *, size_t);
+template void task::gemm<std::complex<double>>(size_t, size_t, size_t, std::complex<double>,
+                                               const std::complex<double> *, size_t,
+                                               const std::complex<double> *, size_t,
+                                               std::complex<double>, std::complex<double> *, size_t);
+
+template void task::solveTriangular<float>(bool, bool, size_t, size_t, const float *, size_t, float *, size_t);
+template void task::solveTriangular<double>(bool, bool, size_t, size_t, const double *, size_t, double *, size_t);
+template void task::solveTriangular<int64_t>(bool, bool, size_t, size_t, const int64_t *, size_t,
+                                             int64_t *, size_t);
+template void task::solveTriangular<std::complex<double>>(bool, bool, size_t, size_t,
+                                                          const std::complex<double> *, size_t,
+                                                          std::complex<double> *, size_t);
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+
+
+namespace task {
+
+    const size_t GEMM_MR = 6;
+    const size_t GEMM_NR = 8;
+    const size_t GEMM_MC = 96;
+    const size_t GEMM_KC = 256;
+    const size_t GEMM_NC = 2048;
+
+    // Products with rows * cols * inner below this go through the naive loop.
+    const size_t GEMM_THRESHOLD = 32 * 32 * 32;
+
+    const size_t TRSM_BLOCK = 64;
+
+    // Columns of B transposed at a time when a summation mode other than PLAIN turns gemm into
+    // one dot product per element.
+    const size_t GEMM_DOT_NC = 16;
+
+    // C = alpha * A * B + beta * C for row-major A (m x k), B (k x n), C (m x n).
+    // float and double follow summation(). Instantiated for float, double, int64_t and
+    // std::complex<double>.
+    template<class T>
+    void gemm(size_t m, size_t n, size_t k, T alpha,
+              const T *a, size_t lda, const T *b, size_t ldb,
+              T beta, T *c, size_t ldc);
+
+    // Solves A X = B in place of B (n x cols) for triangular A (n x n), TRSM_BLOCK rows at a
+    // time: the rows already solved are subtracted from a block with one gemm call.
+    // Only the lower or upper triangle of A is read; its diagonal is taken as 1 if unitDiagonal.
+    template<class T>
+    void solveTriangular(bool lower, bool unitDiagonal, size_t n, size_t cols,
+                         const T *a, size_t lda, T *b, size_t ldb);
+
+}// namespace task
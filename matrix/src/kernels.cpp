@@ -0,0 +1,641 @@
+#include "kernels.h"
+#include "gemm.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define MATRIX_X86 1
+#include <immintrin.h>
+#endif
+
+using namespace task;
+
+namespace {
+
+    template<class T>
+    void storeTile(const T *acc, T alpha, T *c, size_t ldc, size_t rows, size_t cols) {
+        for (size_t i = 0; i < rows; ++i) {
+            for (size_t j = 0; j < cols; ++j) {
+                c[i * ldc + j] += alpha * acc[i * GEMM_NR + j];
+            }
+        }
+    }
+
+    template<class T>
+    void addScalar(T *dst, const T *src, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            dst[i] += src[i];
+        }
+    }
+
+    template<class T>
+    void subScalar(T *dst, const T *src, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            dst[i] -= src[i];
+        }
+    }
+
+    template<class T>
+    void scaleScalar(T *dst, T factor, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            dst[i] *= factor;
+        }
+    }
+
+    template<class T>
+    void axpyScalar(T *dst, T alpha, const T *src, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            dst[i] += alpha * src[i];
+        }
+    }
+
+    template<class T>
+    void multiplyAdd(T &acc, T a, T b) {
+        acc += a * b;
+    }
+
+    // Spelled out so the product skips the NaN/infinity recovery of std::complex operator*.
+    void multiplyAdd(std::complex<double> &acc, std::complex<double> a, std::complex<double> b) {
+        acc = {acc.real() + a.real() * b.real() - a.imag() * b.imag(),
+               acc.imag() + a.real() * b.imag() + a.imag() * b.real()};
+    }
+
+    template<class T>
+    void microKernelScalar(size_t kc, T alpha, const T *a, const T *b,
+                           T *c, size_t ldc, size_t rows, size_t cols) {
+        T acc[GEMM_MR * GEMM_NR] = {};
+        for (size_t p = 0; p < kc; ++p) {
+            for (size_t i = 0; i < GEMM_MR; ++i) {
+                for (size_t j = 0; j < GEMM_NR; ++j) {
+                    multiplyAdd(acc[i * GEMM_NR + j], a[i], b[j]);
+                }
+            }
+            a += GEMM_MR;
+            b += GEMM_NR;
+        }
+        storeTile(acc, alpha, c, ldc, rows, cols);
+    }
+
+#ifdef MATRIX_X86
+
+    __attribute__((target("sse2"))) void addSse2(double *dst, const double *src, size_t n) {
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            _mm_storeu_pd(dst + i, _mm_add_pd(_mm_loadu_pd(dst + i), _mm_loadu_pd(src + i)));
+            _mm_storeu_pd(dst + i + 2, _mm_add_pd(_mm_loadu_pd(dst + i + 2), _mm_loadu_pd(src + i + 2)));
+        }
+        for (; i < n; ++i) {
+            dst[i] += src[i];
+        }
+    }
+
+    __attribute__((target("sse2"))) void subSse2(double *dst, const double *src, size_t n) {
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            _mm_storeu_pd(dst + i, _mm_sub_pd(_mm_loadu_pd(dst + i), _mm_loadu_pd(src + i)));
+            _mm_storeu_pd(dst + i + 2, _mm_sub_pd(_mm_loadu_pd(dst + i + 2), _mm_loadu_pd(src + i + 2)));
+        }
+        for (; i < n; ++i) {
+            dst[i] -= src[i];
+        }
+    }
+
+    __attribute__((target("sse2"))) void scaleSse2(double *dst, double factor, size_t n) {
+        __m128d f = _mm_set1_pd(factor);
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            _mm_storeu_pd(dst + i, _mm_mul_pd(_mm_loadu_pd(dst + i), f));
+            _mm_storeu_pd(dst + i + 2, _mm_mul_pd(_mm_loadu_pd(dst + i + 2), f));
+        }
+        for (; i < n; ++i) {
+            dst[i] *= factor;
+        }
+    }
+
+    __attribute__((target("sse2"))) void axpySse2(double *dst, double alpha, const double *src, size_t n) {
+        __m128d f = _mm_set1_pd(alpha);
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            _mm_storeu_pd(dst + i, _mm_add_pd(_mm_loadu_pd(dst + i), _mm_mul_pd(f, _mm_loadu_pd(src + i))));
+            _mm_storeu_pd(dst + i + 2, _mm_add_pd(_mm_loadu_pd(dst + i + 2), _mm_mul_pd(f, _mm_loadu_pd(src + i + 2))));
+        }
+        for (; i < n; ++i) {
+            dst[i] += alpha * src[i];
+        }
+    }
+
+    // 16 xmm registers do not hold a full 6x8 tile, so the tile is computed as two 6x4 halves.
+    __attribute__((target("sse2"))) void microKernelSse2(size_t kc, double alpha, const double *a, const double *b,
+                                                         double *c, size_t ldc, size_t rows, size_t cols) {
+        alignas(16) double acc[GEMM_MR * GEMM_NR];
+        for (size_t half = 0; half < GEMM_NR; half += 4) {
+            __m128d c0[GEMM_MR], c1[GEMM_MR];
+#pragma GCC unroll 8
+            for (size_t i = 0; i < GEMM_MR; ++i) {
+                c0[i] = _mm_setzero_pd();
+                c1[i] = _mm_setzero_pd();
+            }
+            const double *pa = a;
+            const double *pb = b + half;
+            for (size_t p = 0; p < kc; ++p) {
+                __m128d b0 = _mm_load_pd(pb);
+                __m128d b1 = _mm_load_pd(pb + 2);
+#pragma GCC unroll 8
+                for (size_t i = 0; i < GEMM_MR; ++i) {
+                    __m128d ai = _mm_set1_pd(pa[i]);
+                    c0[i] = _mm_add_pd(c0[i], _mm_mul_pd(ai, b0));
+                    c1[i] = _mm_add_pd(c1[i], _mm_mul_pd(ai, b1));
+                }
+                pa += GEMM_MR;
+                pb += GEMM_NR;
+            }
+#pragma GCC unroll 8
+            for (size_t i = 0; i < GEMM_MR; ++i) {
+                _mm_store_pd(acc + i * GEMM_NR + half, c0[i]);
+                _mm_store_pd(acc + i * GEMM_NR + half + 2, c1[i]);
+            }
+        }
+        storeTile(acc, alpha, c, ldc, rows, cols);
+    }
+
+    __attribute__((target("avx2"))) void addAvx2(double *dst, const double *src, size_t n) {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            _mm256_storeu_pd(dst + i, _mm256_add_pd(_mm256_loadu_pd(dst + i), _mm256_loadu_pd(src + i)));
+            _mm256_storeu_pd(dst + i + 4, _mm256_add_pd(_mm256_loadu_pd(dst + i + 4), _mm256_loadu_pd(src + i + 4)));
+        }
+        for (; i < n; ++i) {
+            dst[i] += src[i];
+        }
+    }
+
+    __attribute__((target("avx2"))) void subAvx2(double *dst, const double *src, size_t n) {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            _mm256_storeu_pd(dst + i, _mm256_sub_pd(_mm256_loadu_pd(dst + i), _mm256_loadu_pd(src + i)));
+            _mm256_storeu_pd(dst + i + 4, _mm256_sub_pd(_mm256_loadu_pd(dst + i + 4), _mm256_loadu_pd(src + i + 4)));
+        }
+        for (; i < n; ++i) {
+            dst[i] -= src[i];
+        }
+    }
+
+    __attribute__((target("avx2"))) void scaleAvx2(double *dst, double factor, size_t n) {
+        __m256d f = _mm256_set1_pd(factor);
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            _mm256_storeu_pd(dst + i, _mm256_mul_pd(_mm256_loadu_pd(dst + i), f));
+            _mm256_storeu_pd(dst + i + 4, _mm256_mul_pd(_mm256_loadu_pd(dst + i + 4), f));
+        }
+        for (; i < n; ++i) {
+            dst[i] *= factor;
+        }
+    }
+
+    __attribute__((target("avx2,fma"))) void axpyAvx2(double *dst, double alpha, const double *src, size_t n) {
+        __m256d f = _mm256_set1_pd(alpha);
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            _mm256_storeu_pd(dst + i, _mm256_fmadd_pd(f, _mm256_loadu_pd(src + i), _mm256_loadu_pd(dst + i)));
+            _mm256_storeu_pd(dst + i + 4, _mm256_fmadd_pd(f, _mm256_loadu_pd(src + i + 4), _mm256_loadu_pd(dst + i + 4)));
+        }
+        for (; i < n; ++i) {
+            dst[i] += alpha * src[i];
+        }
+    }
+
+    __attribute__((target("avx2,fma"))) void microKernelAvx2(size_t kc, double alpha, const double *a, const double *b,
+                                                             double *c, size_t ldc, size_t rows, size_t cols) {
+        __m256d c0[GEMM_MR], c1[GEMM_MR];
+#pragma GCC unroll 8
+        for (size_t i = 0; i < GEMM_MR; ++i) {
+            c0[i] = _mm256_setzero_pd();
+            c1[i] = _mm256_setzero_pd();
+        }
+        for (size_t p = 0; p < kc; ++p) {
+            __m256d b0 = _mm256_load_pd(b);
+            __m256d b1 = _mm256_load_pd(b + 4);
+#pragma GCC unroll 8
+            for (size_t i = 0; i < GEMM_MR; ++i) {
+                __m256d ai = _mm256_broadcast_sd(a + i);
+                c0[i] = _mm256_fmadd_pd(ai, b0, c0[i]);
+                c1[i] = _mm256_fmadd_pd(ai, b1, c1[i]);
+            }
+            a += GEMM_MR;
+            b += GEMM_NR;
+        }
+        __m256d scale = _mm256_set1_pd(alpha);
+        if (rows == GEMM_MR && cols == GEMM_NR) {
+#pragma GCC unroll 8
+            for (size_t i = 0; i < GEMM_MR; ++i) {
+                double *ci = c + i * ldc;
+                _mm256_storeu_pd(ci, _mm256_fmadd_pd(scale, c0[i], _mm256_loadu_pd(ci)));
+                _mm256_storeu_pd(ci + 4, _mm256_fmadd_pd(scale, c1[i], _mm256_loadu_pd(ci + 4)));
+            }
+            return;
+        }
+        alignas(32) double acc[GEMM_MR * GEMM_NR];
+#pragma GCC unroll 8
+        for (size_t i = 0; i < GEMM_MR; ++i) {
+            _mm256_store_pd(acc + i * GEMM_NR, c0[i]);
+            _mm256_store_pd(acc + i * GEMM_NR + 4, c1[i]);
+        }
+        storeTile(acc, alpha, c, ldc, rows, cols);
+    }
+
+    __attribute__((target("avx512f"))) void addAvx512(double *dst, const double *src, size_t n) {
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            _mm512_storeu_pd(dst + i, _mm512_add_pd(_mm512_loadu_pd(dst + i), _mm512_loadu_pd(src + i)));
+            _mm512_storeu_pd(dst + i + 8, _mm512_add_pd(_mm512_loadu_pd(dst + i + 8), _mm512_loadu_pd(src + i + 8)));
+        }
+        for (; i < n; i += 8) {
+            __mmask8 mask = n - i >= 8 ? 0xFF : __mmask8((1u << (n - i)) - 1);
+            __m512d sum = _mm512_add_pd(_mm512_maskz_loadu_pd(mask, dst + i), _mm512_maskz_loadu_pd(mask, src + i));
+            _mm512_mask_storeu_pd(dst + i, mask, sum);
+        }
+    }
+
+    __attribute__((target("avx512f"))) void subAvx512(double *dst, const double *src, size_t n) {
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            _mm512_storeu_pd(dst + i, _mm512_sub_pd(_mm512_loadu_pd(dst + i), _mm512_loadu_pd(src + i)));
+            _mm512_storeu_pd(dst + i + 8, _mm512_sub_pd(_mm512_loadu_pd(dst + i + 8), _mm512_loadu_pd(src + i + 8)));
+        }
+        for (; i < n; i += 8) {
+            __mmask8 mask = n - i >= 8 ? 0xFF : __mmask8((1u << (n - i)) - 1);
+            __m512d diff = _mm512_sub_pd(_mm512_maskz_loadu_pd(mask, dst + i), _mm512_maskz_loadu_pd(mask, src + i));
+            _mm512_mask_storeu_pd(dst + i, mask, diff);
+        }
+    }
+
+    __attribute__((target("avx512f"))) void scaleAvx512(double *dst, double factor, size_t n) {
+        __m512d f = _mm512_set1_pd(factor);
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            _mm512_storeu_pd(dst + i, _mm512_mul_pd(_mm512_loadu_pd(dst + i), f));
+            _mm512_storeu_pd(dst + i + 8, _mm512_mul_pd(_mm512_loadu_pd(dst + i + 8), f));
+        }
+        for (; i < n; i += 8) {
+            __mmask8 mask = n - i >= 8 ? 0xFF : __mmask8((1u << (n - i)) - 1);
+            _mm512_mask_storeu_pd(dst + i, mask, _mm512_mul_pd(_mm512_maskz_loadu_pd(mask, dst + i), f));
+        }
+    }
+
+    __attribute__((target("avx512f"))) void axpyAvx512(double *dst, double alpha, const double *src, size_t n) {
+        __m512d f = _mm512_set1_pd(alpha);
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            _mm512_storeu_pd(dst + i, _mm512_fmadd_pd(f, _mm512_loadu_pd(src + i), _mm512_loadu_pd(dst + i)));
+            _mm512_storeu_pd(dst + i + 8, _mm512_fmadd_pd(f, _mm512_loadu_pd(src + i + 8), _mm512_loadu_pd(dst + i + 8)));
+        }
+        for (; i < n; i += 8) {
+            __mmask8 mask = n - i >= 8 ? 0xFF : __mmask8((1u << (n - i)) - 1);
+            __m512d sum = _mm512_fmadd_pd(f, _mm512_maskz_loadu_pd(mask, src + i), _mm512_maskz_loadu_pd(mask, dst + i));
+            _mm512_mask_storeu_pd(dst + i, mask, sum);
+        }
+    }
+
+    __attribute__((target("avx512f"))) void microKernelAvx512(size_t kc, double alpha, const double *a, const double *b,
+                                                              double *c, size_t ldc, size_t rows, size_t cols) {
+        __m512d acc[GEMM_MR];
+#pragma GCC unroll 8
+        for (size_t i = 0; i < GEMM_MR; ++i) {
+            acc[i] = _mm512_setzero_pd();
+        }
+        for (size_t p = 0; p < kc; ++p) {
+            __m512d bp = _mm512_load_pd(b);
+#pragma GCC unroll 8
+            for (size_t i = 0; i < GEMM_MR; ++i) {
+                acc[i] = _mm512_fmadd_pd(_mm512_set1_pd(a[i]), bp, acc[i]);
+            }
+            a += GEMM_MR;
+            b += GEMM_NR;
+        }
+        __m512d scale = _mm512_set1_pd(alpha);
+        __mmask8 mask = __mmask8((1u << cols) - 1);
+        for (size_t i = 0; i < rows; ++i) {
+            double *ci = c + i * ldc;
+            _mm512_mask_storeu_pd(ci, mask, _mm512_fmadd_pd(scale, acc[i], _mm512_maskz_loadu_pd(mask, ci)));
+        }
+    }
+
+    __attribute__((target("sse2"))) void addSse2Float(float *dst, const float *src, size_t n) {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_loadu_ps(src + i)));
+            _mm_storeu_ps(dst + i + 4, _mm_add_ps(_mm_loadu_ps(dst + i + 4), _mm_loadu_ps(src + i + 4)));
+        }
+        for (; i < n; ++i) {
+            dst[i] += src[i];
+        }
+    }
+
+    __attribute__((target("sse2"))) void subSse2Float(float *dst, const float *src, size_t n) {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            _mm_storeu_ps(dst + i, _mm_sub_ps(_mm_loadu_ps(dst + i), _mm_loadu_ps(src + i)));
+            _mm_storeu_ps(dst + i + 4, _mm_sub_ps(_mm_loadu_ps(dst + i + 4), _mm_loadu_ps(src + i + 4)));
+        }
+        for (; i < n; ++i) {
+            dst[i] -= src[i];
+        }
+    }
+
+    __attribute__((target("sse2"))) void scaleSse2Float(float *dst, float factor, size_t n) {
+        __m128 f = _mm_set1_ps(factor);
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(dst + i), f));
+            _mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_loadu_ps(dst + i + 4), f));
+        }
+        for (; i < n; ++i) {
+            dst[i] *= factor;
+        }
+    }
+
+    __attribute__((target("sse2"))) void axpySse2Float(float *dst, float alpha, const float *src, size_t n) {
+        __m128 f = _mm_set1_ps(alpha);
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(f, _mm_loadu_ps(src + i))));
+            _mm_storeu_ps(dst + i + 4, _mm_add_ps(_mm_loadu_ps(dst + i + 4), _mm_mul_ps(f, _mm_loadu_ps(src + i + 4))));
+        }
+        for (; i < n; ++i) {
+            dst[i] += alpha * src[i];
+        }
+    }
+
+    __attribute__((target("sse2"))) void microKernelSse2Float(size_t kc, float alpha, const float *a, const float *b,
+                                                              float *c, size_t ldc, size_t rows, size_t cols) {
+        __m128 c0[GEMM_MR], c1[GEMM_MR];
+#pragma GCC unroll 8
+        for (size_t i = 0; i < GEMM_MR; ++i) {
+            c0[i] = _mm_setzero_ps();
+            c1[i] = _mm_setzero_ps();
+        }
+        for (size_t p = 0; p < kc; ++p) {
+            __m128 b0 = _mm_load_ps(b);
+            __m128 b1 = _mm_load_ps(b + 4);
+#pragma GCC unroll 8
+            for (size_t i = 0; i < GEMM_MR; ++i) {
+                __m128 ai = _mm_set1_ps(a[i]);
+                c0[i] = _mm_add_ps(c0[i], _mm_mul_ps(ai, b0));
+                c1[i] = _mm_add_ps(c1[i], _mm_mul_ps(ai, b1));
+            }
+            a += GEMM_MR;
+            b += GEMM_NR;
+        }
+        alignas(16) float acc[GEMM_MR * GEMM_NR];
+#pragma GCC unroll 8
+        for (size_t i = 0; i < GEMM_MR; ++i) {
+            _mm_store_ps(acc + i * GEMM_NR, c0[i]);
+            _mm_store_ps(acc + i * GEMM_NR + 4, c1[i]);
+        }
+        storeTile(acc, alpha, c, ldc, rows, cols);
+    }
+
+    __attribute__((target("avx2"))) void addAvx2Float(float *dst, const float *src, size_t n) {
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), _mm256_loadu_ps(src + i)));
+            _mm256_storeu_ps(dst + i + 8, _mm256_add_ps(_mm256_loadu_ps(dst + i + 8), _mm256_loadu_ps(src + i + 8)));
+        }
+        for (; i < n; ++i) {
+            dst[i] += src[i];
+        }
+    }
+
+    __attribute__((target("avx2"))) void subAvx2Float(float *dst, const float *src, size_t n) {
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            _mm256_storeu_ps(dst + i, _mm256_sub_ps(_mm256_loadu_ps(dst + i), _mm256_loadu_ps(src + i)));
+            _mm256_storeu_ps(dst + i + 8, _mm256_sub_ps(_mm256_loadu_ps(dst + i + 8), _mm256_loadu_ps(src + i + 8)));
+        }
+        for (; i < n; ++i) {
+            dst[i] -= src[i];
+        }
+    }
+
+    __attribute__((target("avx2"))) void scaleAvx2Float(float *dst, float factor, size_t n) {
+        __m256 f = _mm256_set1_ps(factor);
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_loadu_ps(dst + i), f));
+            _mm256_storeu_ps(dst + i + 8, _mm256_mul_ps(_mm256_loadu_ps(dst + i + 8), f));
+        }
+        for (; i < n; ++i) {
+            dst[i] *= factor;
+        }
+    }
+
+    __attribute__((target("avx2,fma"))) void axpyAvx2Float(float *dst, float alpha, const float *src, size_t n) {
+        __m256 f = _mm256_set1_ps(alpha);
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            _mm256_storeu_ps(dst + i, _mm256_fmadd_ps(f, _mm256_loadu_ps(src + i), _mm256_loadu_ps(dst + i)));
+            _mm256_storeu_ps(dst + i + 8, _mm256_fmadd_ps(f, _mm256_loadu_ps(src + i + 8), _mm256_loadu_ps(dst + i + 8)));
+        }
+        for (; i < n; ++i) {
+            dst[i] += alpha * src[i];
+        }
+    }
+
+    // GEMM_NR floats fill one ymm register, so this kernel also serves the AVX-512 level.
+    __attribute__((target("avx2,fma"))) void microKernelAvx2Float(size_t kc, float alpha, const float *a, const float *b,
+                                                                  float *c, size_t ldc, size_t rows, size_t cols) {
+        __m256 acc[GEMM_MR];
+#pragma GCC unroll 8
+        for (size_t i = 0; i < GEMM_MR; ++i) {
+            acc[i] = _mm256_setzero_ps();
+        }
+        for (size_t p = 0; p < kc; ++p) {
+            __m256 bp = _mm256_load_ps(b);
+#pragma GCC unroll 8
+            for (size_t i = 0; i < GEMM_MR; ++i) {
+                acc[i] = _mm256_fmadd_ps(_mm256_broadcast_ss(a + i), bp, acc[i]);
+            }
+            a += GEMM_MR;
+            b += GEMM_NR;
+        }
+        if (rows == GEMM_MR && cols == GEMM_NR) {
+            __m256 scale = _mm256_set1_ps(alpha);
+#pragma GCC unroll 8
+            for (size_t i = 0; i < GEMM_MR; ++i) {
+                float *ci = c + i * ldc;
+                _mm256_storeu_ps(ci, _mm256_fmadd_ps(scale, acc[i], _mm256_loadu_ps(ci)));
+            }
+            return;
+        }
+        alignas(32) float tile[GEMM_MR * GEMM_NR];
+#pragma GCC unroll 8
+        for (size_t i = 0; i < GEMM_MR; ++i) {
+            _mm256_store_ps(tile + i * GEMM_NR, acc[i]);
+        }
+        storeTile(tile, alpha, c, ldc, rows, cols);
+    }
+
+    __attribute__((target("avx512f"))) void addAvx512Float(float *dst, const float *src, size_t n) {
+        size_t i = 0;
+        for (; i + 32 <= n; i += 32) {
+            _mm512_storeu_ps(dst + i, _mm512_add_ps(_mm512_loadu_ps(dst + i), _mm512_loadu_ps(src + i)));
+            _mm512_storeu_ps(dst + i + 16, _mm512_add_ps(_mm512_loadu_ps(dst + i + 16), _mm512_loadu_ps(src + i + 16)));
+        }
+        for (; i < n; i += 16) {
+            __mmask16 mask = n - i >= 16 ? 0xFFFF : __mmask16((1u << (n - i)) - 1);
+            __m512 sum = _mm512_add_ps(_mm512_maskz_loadu_ps(mask, dst + i), _mm512_maskz_loadu_ps(mask, src + i));
+            _mm512_mask_storeu_ps(dst + i, mask, sum);
+        }
+    }
+
+    __attribute__((target("avx512f"))) void subAvx512Float(float *dst, const float *src, size_t n) {
+        size_t i = 0;
+        for (; i + 32 <= n; i += 32) {
+            _mm512_storeu_ps(dst + i, _mm512_sub_ps(_mm512_loadu_ps(dst + i), _mm512_loadu_ps(src + i)));
+            _mm512_storeu_ps(dst + i + 16, _mm512_sub_ps(_mm512_loadu_ps(dst + i + 16), _mm512_loadu_ps(src + i + 16)));
+        }
+        for (; i < n; i += 16) {
+            __mmask16 mask = n - i >= 16 ? 0xFFFF : __mmask16((1u << (n - i)) - 1);
+            __m512 diff = _mm512_sub_ps(_mm512_maskz_loadu_ps(mask, dst + i), _mm512_maskz_loadu_ps(mask, src + i));
+            _mm512_mask_storeu_ps(dst + i, mask, diff);
+        }
+    }
+
+    __attribute__((target("avx512f"))) void scaleAvx512Float(float *dst, float factor, size_t n) {
+        __m512 f = _mm512_set1_ps(factor);
+        size_t i = 0;
+        for (; i + 32 <= n; i += 32) {
+            _mm512_storeu_ps(dst + i, _mm512_mul_ps(_mm512_loadu_ps(dst + i), f));
+            _mm512_storeu_ps(dst + i + 16, _mm512_mul_ps(_mm512_loadu_ps(dst + i + 16), f));
+        }
+        for (; i < n; i += 16) {
+            __mmask16 mask = n - i >= 16 ? 0xFFFF : __mmask16((1u << (n - i)) - 1);
+            _mm512_mask_storeu_ps(dst + i, mask, _mm512_mul_ps(_mm512_maskz_loadu_ps(mask, dst + i), f));
+        }
+    }
+
+    __attribute__((target("avx512f"))) void axpyAvx512Float(float *dst, float alpha, const float *src, size_t n) {
+        __m512 f = _mm512_set1_ps(alpha);
+        size_t i = 0;
+        for (; i + 32 <= n; i += 32) {
+            _mm512_storeu_ps(dst + i, _mm512_fmadd_ps(f, _mm512_loadu_ps(src + i), _mm512_loadu_ps(dst + i)));
+            _mm512_storeu_ps(dst + i + 16, _mm512_fmadd_ps(f, _mm512_loadu_ps(src + i + 16), _mm512_loadu_ps(dst + i + 16)));
+        }
+        for (; i < n; i += 16) {
+            __mmask16 mask = n - i >= 16 ? 0xFFFF : __mmask16((1u << (n - i)) - 1);
+            __m512 sum = _mm512_fmadd_ps(f, _mm512_maskz_loadu_ps(mask, src + i), _mm512_maskz_loadu_ps(mask, dst + i));
+            _mm512_mask_storeu_ps(dst + i, mask, sum);
+        }
+    }
+
+#endif
+
+    const Kernels<double> SCALAR_KERNELS = {addScalar<double>, subScalar<double>, scaleScalar<double>,
+                                            axpyScalar<double>, microKernelScalar<double>};
+    const Kernels<float> SCALAR_KERNELS_FLOAT = {addScalar<float>, subScalar<float>, scaleScalar<float>,
+                                                 axpyScalar<float>, microKernelScalar<float>};
+    const Kernels<int64_t> KERNELS_INT64 = {addScalar<int64_t>, subScalar<int64_t>, scaleScalar<int64_t>,
+                                            axpyScalar<int64_t>, microKernelScalar<int64_t>};
+    const Kernels<std::complex<double>> KERNELS_COMPLEX = {
+            addScalar<std::complex<double>>, subScalar<std::complex<double>>, scaleScalar<std::complex<double>>,
+            axpyScalar<std::complex<double>>, microKernelScalar<std::complex<double>>};
+
+#ifdef MATRIX_X86
+    const Kernels<double> SSE2_KERNELS = {addSse2, subSse2, scaleSse2, axpySse2, microKernelSse2};
+    const Kernels<double> AVX2_KERNELS = {addAvx2, subAvx2, scaleAvx2, axpyAvx2, microKernelAvx2};
+    const Kernels<double> AVX512_KERNELS = {addAvx512, subAvx512, scaleAvx512, axpyAvx512, microKernelAvx512};
+
+    const Kernels<float> SSE2_KERNELS_FLOAT = {addSse2Float, subSse2Float, scaleSse2Float,
+                                               axpySse2Float, microKernelSse2Float};
+    const Kernels<float> AVX2_KERNELS_FLOAT = {addAvx2Float, subAvx2Float, scaleAvx2Float,
+                                               axpyAvx2Float, microKernelAvx2Float};
+    const Kernels<float> AVX512_KERNELS_FLOAT = {addAvx512Float, subAvx512Float, scaleAvx512Float,
+                                                 axpyAvx512Float, microKernelAvx2Float};
+#endif
+
+    SimdLevel &currentLevel() {
+        static SimdLevel level = detectSimdLevel();
+        return level;
+    }
+
+}// namespace
+
+SimdLevel task::detectSimdLevel() {
+#ifdef MATRIX_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return SimdLevel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return SimdLevel::AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return SimdLevel::SSE2;
+    }
+#endif
+    return SimdLevel::SCALAR;
+}
+
+SimdLevel task::simdLevel() {
+    return currentLevel();
+}
+
+void task::setSimdLevel(SimdLevel level) {
+    SimdLevel supported = detectSimdLevel();
+    currentLevel() = (level > supported ? supported : level);
+}
+
+const char *task::simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::SSE2:
+            return "sse2";
+        case SimdLevel::AVX2:
+            return "avx2";
+        case SimdLevel::AVX512:
+            return "avx512";
+        default:
+            return "scalar";
+    }
+}
+
+template<>
+const Kernels<double> &task::kernels<double>() {
+#ifdef MATRIX_X86
+    switch (currentLevel()) {
+        case SimdLevel::SSE2:
+            return SSE2_KERNELS;
+        case SimdLevel::AVX2:
+            return AVX2_KERNELS;
+        case SimdLevel::AVX512:
+            return AVX512_KERNELS;
+        default:
+            break;
+    }
+#endif
+    return SCALAR_KERNELS;
+}
+
+template<>
+const Kernels<float> &task::kernels<float>() {
+#ifdef MATRIX_X86
+    switch (currentLevel()) {
+        case SimdLevel::SSE2:
+            return SSE2_KERNELS_FLOAT;
+        case SimdLevel::AVX2:
+            return AVX2_KERNELS_FLOAT;
+        case SimdLevel::AVX512:
+            return AVX512_KERNELS_FLOAT;
+        default:
+            break;
+    }
+#endif
+    return SCALAR_KERNELS_FLOAT;
+}
+
+template<>
+const Kernels<int64_t> &task::kernels<int64_t>() {
+    return KERNELS_INT64;
+}
+
+template<>
+const Kernels<std::complex<double>> &task::kernels<std::complex<double>>() {
+    return KERNELS_COMPLEX;
+}
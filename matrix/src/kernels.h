@@ -0,0 +1,62 @@
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace task {
+
+    enum class SimdLevel {
+        SCALAR,
+        SSE2,
+        AVX2,
+        AVX512
+    };
+
+    template<class T>
+    struct Kernels {
+        // dst[i] += src[i]
+        void (*add)(T *dst, const T *src, size_t n);
+
+        // dst[i] -= src[i]
+        void (*sub)(T *dst, const T *src, size_t n);
+
+        // dst[i] *= factor
+        void (*scale)(T *dst, T factor, size_t n);
+
+        // dst[i] += alpha * src[i]
+        void (*axpy)(T *dst, T alpha, const T *src, size_t n);
+
+        // c += alpha * a * b for packed GEMM_MR x kc and kc x GEMM_NR panels,
+        // only the leading rows x cols corner of the tile is written.
+        void (*microKernel)(size_t kc, T alpha, const T *a, const T *b,
+                            T *c, size_t ldc, size_t rows, size_t cols);
+    };
+
+    SimdLevel detectSimdLevel();
+
+    SimdLevel simdLevel();
+
+    // Selects the kernel set, clamped to what the CPU supports. Not thread-safe.
+    void setSimdLevel(SimdLevel level);
+
+    const char *simdLevelName(SimdLevel level);
+
+    // float and double have SIMD kernel sets; int64_t and complex<double> use portable loops.
+    template<class T>
+    const Kernels<T> &kernels();
+
+    template<>
+    const Kernels<float> &kernels<float>();
+
+    template<>
+    const Kernels<double> &kernels<double>();
+
+    template<>
+    const Kernels<int64_t> &kernels<int64_t>();
+
+    template<>
+    const Kernels<std::complex<double>> &kernels<std::complex<double>>();
+
+}// namespace task
@@ -0,0 +1,185 @@
+#include "lu.h"
+#include "gemm.h"
+#include "kernels.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace task;
+
+namespace {
+
+    template<class T>
+    const BasicMatrix<T> &checkSquare(const BasicMatrix<T> &a) {
+        if (a.getRow() != a.getCol()) {
+            throw SizeMismatchException();
+        }
+        return a;
+    }
+
+}// namespace
+
+template<class T>
+BasicLU<T>::BasicLU(const BasicMatrix<T> &a) : lu(checkSquare(a)), perm(a.getRow()) {
+    for (size_t i = 0; i < perm.size(); ++i) {
+        perm[i] = i;
+    }
+    factorize();
+}
+
+template<class T>
+size_t BasicLU<T>::size() const {
+    return lu.getRow();
+}
+
+template<class T>
+bool BasicLU<T>::isSingular() const {
+    return singular;
+}
+
+template<class T>
+const BasicMatrix<T> &BasicLU<T>::factors() const {
+    return lu;
+}
+
+template<class T>
+const std::vector<size_t> &BasicLU<T>::permutation() const {
+    return perm;
+}
+
+template<class T>
+void BasicLU<T>::factorize() {
+    size_t n = size();
+    CounterScope counter(Operation::FACTORIZE, 0, 2 * n * n * n / 3);
+    T *a = lu.data();
+    const Kernels<T> &k = kernels<T>();
+    for (size_t j = 0; j < n; j += LU_BLOCK) {
+        size_t jb = std::min(LU_BLOCK, n - j);
+        factorizePanel(j, jb);
+
+        size_t rest = n - j - jb;
+        if (rest == 0) {
+            continue;
+        }
+        for (size_t i = j; i < j + jb; ++i) {
+            for (size_t r = i + 1; r < j + jb; ++r) {
+                k.axpy(a + r * n + j + jb, -a[r * n + i], a + i * n + j + jb, rest);
+            }
+        }
+        gemm(rest, rest, jb, T(-1), a + (j + jb) * n + j, n, a + j * n + j + jb, n,
+             T(1), a + (j + jb) * n + j + jb, n);
+    }
+}
+
+template<class T>
+void BasicLU<T>::factorizePanel(size_t first, size_t width) {
+    size_t n = size();
+    T *a = lu.data();
+    const Kernels<T> &k = kernels<T>();
+    for (size_t c = first; c < first + width; ++c) {
+        size_t pivotRow = c;
+        auto best = std::abs(a[c * n + c]);
+        for (size_t r = c + 1; r < n; ++r) {
+            if (std::abs(a[r * n + c]) > best) {
+                best = std::abs(a[r * n + c]);
+                pivotRow = r;
+            }
+        }
+        if (best == 0) {
+            singular = true;
+            continue;
+        }
+        if (pivotRow != c) {
+            std::swap_ranges(a + c * n, a + c * n + n, a + pivotRow * n);
+            std::swap(perm[c], perm[pivotRow]);
+            sign = -sign;
+        }
+        T pivot = a[c * n + c];
+        for (size_t r = c + 1; r < n; ++r) {
+            T l = a[r * n + c] /= pivot;
+            if (l != T(0)) {
+                k.axpy(a + r * n + c + 1, -l, a + c * n + c + 1, first + width - c - 1);
+            }
+        }
+    }
+}
+
+template<class T>
+T BasicLU<T>::det() const {
+    if (singular) {
+        return T(0);
+    }
+    T d = T(sign);
+    for (size_t i = 0; i < size(); ++i) {
+        d *= lu[i][i];
+    }
+    return d;
+}
+
+template<class T>
+void BasicLU<T>::solveInPlace(T *x, size_t cols) const {
+    if (singular) {
+        throw SingularMatrixException();
+    }
+    size_t n = size();
+    CounterScope counter(Operation::SOLVE, 0, 2 * n * n * cols);
+    solveTriangular(true, true, n, cols, lu.data(), n, x, cols);
+    solveTriangular(false, false, n, cols, lu.data(), n, x, cols);
+}
+
+template<class T>
+BasicMatrix<T> BasicLU<T>::solve(const BasicMatrix<T> &b) const {
+    if (b.getRow() != size()) {
+        throw SizeMismatchException();
+    }
+    size_t cols = b.getCol();
+    BasicMatrix<T> x(size(), cols);
+    for (size_t i = 0; i < size(); ++i) {
+        std::copy_n(b.data() + perm[i] * cols, cols, x.data() + i * cols);
+    }
+    solveInPlace(x.data(), cols);
+    return x;
+}
+
+template<class T>
+std::vector<T> BasicLU<T>::solve(const std::vector<T> &b) const {
+    if (b.size() != size()) {
+        throw SizeMismatchException();
+    }
+    std::vector<T> x(size());
+    for (size_t i = 0; i < size(); ++i) {
+        x[i] = b[perm[i]];
+    }
+    solveInPlace(x.data(), 1);
+    return x;
+}
+
+template<class T>
+BasicMatrix<T> BasicLU<T>::inverse() const {
+    return solve(BasicMatrix<T>(size(), size()));
+}
+
+template<class T>
+BasicMatrix<T> task::solve(const BasicMatrix<T> &a, const BasicMatrix<T> &b) {
+    return BasicLU<T>(a).solve(b);
+}
+
+template<class T>
+std::vector<T> task::solve(const BasicMatrix<T> &a, const std::vector<T> &b) {
+    return BasicLU<T>(a).solve(b);
+}
+
+template<class T>
+BasicMatrix<T> task::inverse(const BasicMatrix<T> &a) {
+    return BasicLU<T>(a).inverse();
+}
+
+#define LU_INSTANTIATE(T)                                                                      \
+    template class task::BasicLU<T>;                                                           \
+    template BasicMatrix<T> task::solve(const BasicMatrix<T> &, const BasicMatrix<T> &);       \
+    template std::vector<T> task::solve(const BasicMatrix<T> &, const std::vector<T> &);       \
+    template BasicMatrix<T> task::inverse(const BasicMatrix<T> &);
+
+LU_INSTANTIATE(float)
+LU_INSTANTIATE(double)
+LU_INSTANTIATE(std::complex<double>)
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "matrix.h"
+
+#include <vector>
+
+
+namespace task {
+
+    const size_t LU_BLOCK = 64;
+
+    // PA = LU with partial pivoting. L (unit diagonal) and U share one packed matrix.
+    // Instantiated for float, double and std::complex<double>.
+    template<class T>
+    class BasicLU {
+    public:
+        explicit BasicLU(const BasicMatrix<T> &a);
+
+        size_t size() const;
+
+        bool isSingular() const;
+
+        T det() const;
+
+        BasicMatrix<T> solve(const BasicMatrix<T> &b) const;
+
+        std::vector<T> solve(const std::vector<T> &b) const;
+
+        BasicMatrix<T> inverse() const;
+
+        const BasicMatrix<T> &factors() const;
+
+        // Row i of PA is row permutation()[i] of A.
+        const std::vector<size_t> &permutation() const;
+
+    private:
+        BasicMatrix<T> lu;
+        std::vector<size_t> perm;
+        int sign = 1;
+        bool singular = false;
+
+        void factorize();
+
+        void factorizePanel(size_t first, size_t width);
+
+        void solveInPlace(T *x, size_t cols) const;
+    };
+
+    using LU = BasicLU<double>;
+
+    // Through LU; throws SingularMatrixException for singular a.
+    template<class T>
+    BasicMatrix<T> solve(const BasicMatrix<T> &a, const BasicMatrix<T> &b);
+
+    template<class T>
+    std::vector<T> solve(const BasicMatrix<T> &a, const std::vector<T> &b);
+
+    template<class T>
+    BasicMatrix<T> inverse(const BasicMatrix<T> &a);
+
+    extern template class BasicLU<float>;
+    extern template class BasicLU<double>;
+    extern template class BasicLU<std::complex<double>>;
+
+}// namespace task
@@ -1,259 +1,450 @@
 #include "matrix.h"
+#include "gemm.h"
+#include "kernels.h"
+#include "lu.h"
+#include "summation.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <new>
+#include <type_traits>
 
 using namespace task;
 
-Matrix::Matrix() : row(1), col(1) {
+namespace {
+
+    const size_t TRANSPOSE_TILE = 32;
+
+    // Swaps the h x w block at (i, j) with the w x h block at (j, i), halving the larger side until it fits a tile.
+    template<class T>
+    void swapMirrorBlocks(T *a, size_t ld, size_t i, size_t j, size_t h, size_t w) {
+        if (h <= TRANSPOSE_TILE && w <= TRANSPOSE_TILE) {
+            for (size_t r = i; r < i + h; ++r) {
+                for (size_t c = j; c < j + w; ++c) {
+                    std::swap(a[r * ld + c], a[c * ld + r]);
+                }
+            }
+        } else if (h >= w) {
+            swapMirrorBlocks(a, ld, i, j, h / 2, w);
+            swapMirrorBlocks(a, ld, i + h / 2, j, h - h / 2, w);
+        } else {
+            swapMirrorBlocks(a, ld, i, j, h, w / 2);
+            swapMirrorBlocks(a, ld, i, j + w / 2, h, w - w / 2);
+        }
+    }
+
+    // Cache-oblivious in-place transpose of the n x n diagonal block starting at (first, first).
+    template<class T>
+    void transposeSquare(T *a, size_t ld, size_t first, size_t n) {
+        if (n <= TRANSPOSE_TILE) {
+            for (size_t r = first; r < first + n; ++r) {
+                for (size_t c = r + 1; c < first + n; ++c) {
+                    std::swap(a[r * ld + c], a[c * ld + r]);
+                }
+            }
+            return;
+        }
+        size_t half = n / 2;
+        transposeSquare(a, ld, first, half);
+        transposeSquare(a, ld, first + half, n - half);
+        swapMirrorBlocks(a, ld, first + half, first, n - half, half);
+    }
+
+    // In-place transpose of a rows x cols matrix by following the permutation cycles
+    // k -> k * rows mod (rows * cols - 1); needs one bit of bookkeeping per element.
+    template<class T>
+    void transposeCycles(T *a, size_t rows, size_t cols) {
+        size_t last = rows * cols - 1;
+        std::vector<bool> visited(last + 1, false);
+        for (size_t start = 1; start < last; ++start) {
+            if (visited[start]) {
+                continue;
+            }
+            T value = a[start];
+            size_t pos = start;
+            do {
+                pos = pos * rows % last;
+                std::swap(value, a[pos]);
+                visited[pos] = true;
+            } while (pos != start);
+        }
+    }
+
+    // Fraction-free Gaussian elimination: every intermediate is a minor of the input, so the result
+    // is exact whenever the minors fit in int64_t. Products are formed in 128 bits.
+    int64_t bareissDet(const int64_t *src, size_t n) {
+        std::vector<int64_t> a(src, src + n * n);
+        int64_t previous = 1;
+        int64_t sign = 1;
+        for (size_t k = 0; k + 1 < n; ++k) {
+            if (a[k * n + k] == 0) {
+                size_t r = k + 1;
+                while (r < n && a[r * n + k] == 0) {
+                    ++r;
+                }
+                if (r == n) {
+                    return 0;
+                }
+                std::swap_ranges(a.begin() + k * n, a.begin() + k * n + n, a.begin() + r * n);
+                sign = -sign;
+            }
+            for (size_t i = k + 1; i < n; ++i) {
+                for (size_t j = k + 1; j < n; ++j) {
+                    __int128 value = __int128(a[i * n + j]) * a[k * n + k] - __int128(a[i * n + k]) * a[k * n + j];
+                    a[i * n + j] = int64_t(value / previous);
+                }
+            }
+            previous = a[k * n + k];
+        }
+        return n == 0 ? 1 : sign * a[n * n - 1];
+    }
+
+}// namespace
+
+template<class T>
+BasicMatrix<T>::BasicMatrix() : row(1), col(1) {
     allocateMemory();
     markWithOnes();
 }
 
-Matrix::Matrix(size_t rows, size_t cols) : row(rows), col(cols) {
+template<class T>
+BasicMatrix<T>::BasicMatrix(size_t rows, size_t cols) : row(rows), col(cols) {
     allocateMemory();
     markWithOnes();
 }
 
-Matrix::Matrix(const Matrix &copy) {
+template<class T>
+BasicMatrix<T>::BasicMatrix(size_t rows, size_t cols, std::pmr::memory_resource *resource)
+    : row(rows), col(cols), resource(resource) {
+    allocateMemory();
+    markWithOnes();
+}
+
+template<class T>
+BasicMatrix<T>::BasicMatrix(const BasicMatrix &copy) {
     row = copy.row;
     col = copy.col;
     allocateMemory();
-    for (size_t i = 0; i < row; ++i) {
-        for (size_t j = 0; j < col; ++j) {
-            arr[i][j] = copy[i][j];
-        }
-    }
+    CounterScope counter(Operation::COPY, row * col * sizeof(T));
+    std::copy_n(copy.arr, row * col, arr);
 }
 
-Matrix::~Matrix() {
+template<class T>
+BasicMatrix<T>::BasicMatrix(BasicMatrix &&other) noexcept
+    : arr(other.arr), row(other.row), col(other.col), resource(other.resource) {
+    other.arr = nullptr;
+    other.row = 0;
+    other.col = 0;
+}
+
+template<class T>
+BasicMatrix<T>::~BasicMatrix() {
     deallocateMemory();
 }
 
-void Matrix::deallocateMemory() {
-    for (size_t i = 0; i < row; ++i) {
-        delete[] arr[i];
+template<class T>
+void BasicMatrix<T>::deallocateMemory() {
+    deallocate(arr, row * col);
+    arr = nullptr;
+}
+
+template<class T>
+T *BasicMatrix<T>::allocate(size_t size) {
+    if (size == 0) {
+        return nullptr;
     }
-    delete[] arr;
+    CounterScope counter(Operation::ALLOCATE, size * sizeof(T));
+    return static_cast<T *>(resource->allocate(size * sizeof(T), std::max(ALIGNMENT, alignof(T))));
 }
 
-Matrix::ProxyArr Matrix::operator[](size_t n) const {
-    return ProxyArr(arr[n]);
+template<class T>
+void BasicMatrix<T>::deallocate(T *ptr, size_t size) {
+    if (ptr == nullptr) {
+        return;
+    }
+    resource->deallocate(ptr, size * sizeof(T), std::max(ALIGNMENT, alignof(T)));
 }
 
-Matrix &Matrix::operator=(const Matrix &a) {
+template<class T>
+BasicMatrix<T> &BasicMatrix<T>::operator=(const BasicMatrix<T> &a) {
     if (&a == this) {
         return *this;
     }
-    deallocateMemory();
-    row = a.getRow();
-    col = a.getCol();
-    allocateMemory();
+    if (row * col != a.row * a.col) {
+        deallocateMemory();
+        arr = allocate(a.row * a.col);
+    }
+    row = a.row;
+    col = a.col;
+    CounterScope counter(Operation::COPY, row * col * sizeof(T));
+    std::copy_n(a.arr, row * col, arr);
+    return *this;
+}
 
-    for (size_t i = 0; i < row; ++i) {
-        for (size_t j = 0; j < col; ++j) {
-            arr[i][j] = a[i][j];
-        }
+template<class T>
+BasicMatrix<T> &BasicMatrix<T>::operator=(BasicMatrix<T> &&other) noexcept {
+    if (&other != this) {
+        deallocateMemory();
+        arr = other.arr;
+        row = other.row;
+        col = other.col;
+        resource = other.resource;
+        other.arr = nullptr;
+        other.row = 0;
+        other.col = 0;
     }
     return *this;
 }
 
-size_t Matrix::getRow() const {
+template<class T>
+void BasicMatrix<T>::swap(BasicMatrix<T> &other) noexcept {
+    std::swap(arr, other.arr);
+    std::swap(row, other.row);
+    std::swap(col, other.col);
+    std::swap(resource, other.resource);
+}
+
+template<class T>
+void task::swap(BasicMatrix<T> &a, BasicMatrix<T> &b) noexcept {
+    a.swap(b);
+}
+
+template<class T>
+size_t BasicMatrix<T>::getRow() const {
     return row;
 }
 
-size_t Matrix::Matrix::getCol() const {
+template<class T>
+size_t BasicMatrix<T>::getCol() const {
     return col;
 }
 
-double &Matrix::get(size_t n, size_t m) {
+template<class T>
+T *BasicMatrix<T>::data() {
+    return arr;
+}
+
+template<class T>
+const T *BasicMatrix<T>::data() const {
+    return arr;
+}
+
+template<class T>
+std::pmr::memory_resource *BasicMatrix<T>::getResource() const {
+    return resource;
+}
+
+template<class T>
+T &BasicMatrix<T>::get(size_t n, size_t m) {
     if (n >= row || n < 0 || m >= col || m < 0) {
         throw OutOfBoundsException();
     }
-    return arr[n][m];
+    return arr[n * col + m];
 }
 
-const double &Matrix::get(size_t n, size_t m) const {
+template<class T>
+const T &BasicMatrix<T>::get(size_t n, size_t m) const {
     if (n >= row || n < 0 || m >= col || m < 0) {
         throw OutOfBoundsException();
     }
-    return arr[n][m];
+    return arr[n * col + m];
 }
 
-void Matrix::set(size_t n, size_t m, const double &value) {
+template<class T>
+void BasicMatrix<T>::set(size_t n, size_t m, const T &value) {
     if (n >= row || n < 0 || m >= col || m < 0) {
         throw OutOfBoundsException();
     }
-    arr[n][m] = value;
+    arr[n * col + m] = value;
 }
 
-void Matrix::resize(size_t n, size_t m) {
-    Matrix temp(n, m);
-    for (size_t i = 0; i < n; ++i) {
-        for (size_t j = 0; j < m; ++j) {
-            temp.arr[i][j] = 0;
-        }
+template<class T>
+void BasicMatrix<T>::resize(size_t n, size_t m) {
+    if (n == row && m == col) {
+        return;
     }
+    T *temp = allocate(n * m);
+    std::fill_n(temp, n * m, T(0));
+    size_t copyCols = getMin(m, col);
     for (size_t i = 0; i < getMin(n, row); ++i) {
-        for (size_t j = 0; j < getMin(m, col); ++j) {
-            temp.arr[i][j] = arr[i][j];
-        }
+        std::copy_n(arr + i * col, copyCols, temp + i * m);
     }
-    *this = temp;
+    deallocateMemory();
+    arr = temp;
+    row = n;
+    col = m;
 }
 
-void Matrix::allocateMemory() {
-    arr = new double *[row];
-    for (size_t i = 0; i < row; ++i) {
-        arr[i] = new double[col];
-    }
+template<class T>
+void BasicMatrix<T>::allocateMemory() {
+    arr = allocate(row * col);
 }
 
-void Matrix::markWithOnes() {
-    for (size_t i = 0; i < row; ++i) {
-        for (size_t j = 0; j < col; ++j) {
-            arr[i][j] = (i == j ? 1 : 0);
-        }
+template<class T>
+void BasicMatrix<T>::markWithOnes() {
+    std::fill_n(arr, row * col, T(0));
+    for (size_t i = 0; i < getMin(row, col); ++i) {
+        arr[i * col + i] = T(1);
     }
 }
 
-size_t Matrix::getMin(size_t a, size_t b) {
+template<class T>
+size_t BasicMatrix<T>::getMin(size_t a, size_t b) {
     return (a > b ? b : a);
 }
 
-void Matrix::checkMismatch(size_t n, size_t m) const {
+template<class T>
+void BasicMatrix<T>::checkMismatch(size_t n, size_t m) const {
     if (n != row || m != col) {
         throw SizeMismatchException();
     }
 }
 
-void Matrix::checkMismatch() const {
+template<class T>
+void BasicMatrix<T>::checkMismatch() const {
     if (row != col) {
         throw SizeMismatchException();
     }
 }
 
-Matrix &Matrix::operator+=(const Matrix &a) {
+template<class T>
+BasicMatrix<T> &BasicMatrix<T>::operator+=(const BasicMatrix<T> &a) {
     checkMismatch(a.row, a.col);
-    for (size_t i = 0; i < row; ++i) {
-        for (size_t j = 0; j < col; ++j) {
-            arr[i][j] += a[i][j];
-        }
-    }
+    CounterScope counter(Operation::ELEMENTWISE, row * col * sizeof(T));
+    parallelFor(row * col, PARALLEL_THRESHOLD, [&](size_t begin, size_t end) {
+        kernels<T>().add(arr + begin, a.arr + begin, end - begin);
+    });
     return *this;
 }
 
-Matrix Matrix::operator+(const Matrix &a) const {
-    Matrix temp = *this;
-    return temp += a;
+template<class T>
+BasicMatrix<T> &BasicMatrix<T>::operator-=(const BasicMatrix<T> &a) {
+    checkMismatch(a.row, a.col);
+    CounterScope counter(Operation::ELEMENTWISE, row * col * sizeof(T));
+    parallelFor(row * col, PARALLEL_THRESHOLD, [&](size_t begin, size_t end) {
+        kernels<T>().sub(arr + begin, a.arr + begin, end - begin);
+    });
+    return *this;
 }
 
-Matrix &Matrix::operator-=(const Matrix &a) {
-    return *this += -a;
+template<class T>
+BasicMatrix<T> &BasicMatrix<T>::operator*=(const T &number) {
+    CounterScope counter(Operation::ELEMENTWISE, row * col * sizeof(T));
+    parallelFor(row * col, PARALLEL_THRESHOLD, [&](size_t begin, size_t end) {
+        kernels<T>().scale(arr + begin, number, end - begin);
+    });
+    return *this;
 }
 
-Matrix Matrix::operator-(const Matrix &a) const {
-    Matrix temp = *this;
-    return temp -= a;
+template<class T>
+BasicMatrix<T> &BasicMatrix<T>::operator*=(const BasicMatrix<T> &a) {
+    return *this = multiply(*this, a);
 }
 
-Matrix task::operator*(const double &a, const Matrix &b) {
-    Matrix temp = b;
-    for (size_t i = 0; i < temp.getRow(); ++i) {
-        for (size_t j = 0; j < temp.getCol(); ++j) {
-            temp[i][j] *= a;
-        }
+template<class T>
+BasicMatrix<T> task::multiply(const BasicMatrix<T> &a, const BasicMatrix<T> &b) {
+    return multiply(a.view(), b.view());
+}
+
+template<class T>
+BasicMatrix<T> task::multiply(const BasicMatrixView<const T> &a, const BasicMatrixView<const T> &b) {
+    if (a.getCol() != b.getRow()) {
+        throw SizeMismatchException();
     }
+    BasicMatrix<T> temp(a.getRow(), b.getCol());
+    multiply(a, b, temp.view());
     return temp;
 }
 
-Matrix Matrix::operator-() const {
-    Matrix temp = *this;
-    return -1 * temp;
+template<class T>
+void task::multiply(const BasicMatrixView<const typename BasicMatrixView<T>::value_type> &a,
+                    const BasicMatrixView<const typename BasicMatrixView<T>::value_type> &b,
+                    const BasicMatrixView<T> &c) {
+    using V = typename BasicMatrixView<T>::value_type;
+    size_t n = a.getRow(), m = b.getCol(), inner = a.getCol();
+    if (inner != b.getRow() || c.getRow() != n || c.getCol() != m) {
+        throw SizeMismatchException();
+    }
+    CounterScope counter(Operation::MULTIPLY, 0, 2 * n * m * inner);
+    bool accurate = std::is_floating_point<V>::value && summation() != Summation::PLAIN;
+    if (n * m * inner >= GEMM_THRESHOLD || accurate) {
+        gemm(n, m, inner, V(1), a.data(), a.getStride(), b.data(), b.getStride(), V(0), c.data(), c.getStride());
+        return;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < m; ++j) {
+            V s = V(0);
+            for (size_t k = 0; k < inner; ++k) {
+                s += a[i][k] * b[k][j];
+            }
+            c[i][j] = s;
+        }
+    }
 }
 
-Matrix Matrix::operator+() const {
-    Matrix temp = *this;
-    return temp;
+template<class T>
+std::vector<T> BasicMatrix<T>::getRow(size_t row) {
+    BasicRowView<T> view = rowView(row);
+    return std::vector<T>(view.begin(), view.end());
 }
 
-Matrix &Matrix::operator*=(const double &number) {
-    for (size_t i = 0; i < row; ++i) {
-        for (size_t j = 0; j < col; ++j) {
-            arr[i][j] *= number;
-        }
+template<class T>
+std::vector<T> BasicMatrix<T>::getColumn(size_t column) {
+    BasicColView<T> view = colView(column);
+    std::vector<T> vec(view.size());
+    for (size_t i = 0; i < view.size(); ++i) {
+        vec[i] = view[i];
     }
-    return *this;
+    return vec;
 }
 
-Matrix Matrix::operator*(const double &number) const {
-    Matrix temp = *this;
-    return temp *= number;
+template<class T>
+BasicMatrixView<T> BasicMatrix<T>::view() {
+    return BasicMatrixView<T>(arr, row, col, col);
 }
 
-Matrix &Matrix::operator*=(const Matrix &a) {
-    if (col != a.getRow()) {
-        throw SizeMismatchException();
-    }
-    Matrix temp(row, a.getCol());
-    for (size_t i = 0; i < row; ++i) {
-        for (size_t j = 0; j < temp.getCol(); ++j) {
-            double s = 0;
-            for (size_t k = 0; k < col; ++k) {
-                s += arr[i][k] * a[k][j];
-            }
-            temp[i][j] = s;
-        }
-    }
-    *this = temp;
-    return *this;
+template<class T>
+BasicMatrixView<const T> BasicMatrix<T>::view() const {
+    return BasicMatrixView<const T>(arr, row, col, col);
 }
 
-Matrix Matrix::operator*(const Matrix &a) const {
-    Matrix temp = *this;
-    return temp *= a;
+template<class T>
+BasicMatrix<T>::operator BasicMatrixView<const T>() const {
+    return view();
 }
 
-bool Matrix::operator==(const Matrix &a) const {
-    if (row != a.getRow() || col != a.getCol()) {
-        return false;
-    }
-    for (size_t i = 0; i < row; ++i) {
-        for (size_t j = 0; j < col; ++j) {
-            if (!areClose(arr[i][j], a[i][j])) {
-                return false;
-            }
-        }
-    }
-    return true;
+template<class T>
+BasicMatrixView<T> BasicMatrix<T>::block(size_t n, size_t m, size_t rows, size_t cols) {
+    return view().block(n, m, rows, cols);
 }
 
-bool Matrix::operator!=(const Matrix &a) const {
-    return !(a == *this);
+template<class T>
+BasicMatrixView<const T> BasicMatrix<T>::block(size_t n, size_t m, size_t rows, size_t cols) const {
+    return view().block(n, m, rows, cols);
 }
 
-bool Matrix::areClose(double a, double b) {
-    return abs(a - b) <= EPS;
+template<class T>
+BasicRowView<T> BasicMatrix<T>::rowView(size_t n) {
+    return view().rowView(n);
 }
 
-double Matrix::abs(double a) {
-    return (a > 0 ? a : -a);
+template<class T>
+BasicRowView<const T> BasicMatrix<T>::rowView(size_t n) const {
+    return view().rowView(n);
 }
 
-std::vector<double> Matrix::getRow(size_t row) {
-    std::vector<double> vec(getRow());
-    for (size_t i = 0; i < getRow(); ++i) {
-        vec[i] = arr[row][i];
-    }
-    return vec;
+template<class T>
+BasicColView<T> BasicMatrix<T>::colView(size_t m) {
+    return view().colView(m);
 }
 
-std::vector<double> Matrix::getColumn(size_t column) {
-    std::vector<double> vec(getCol());
-    for (size_t i = 0; i < getCol(); ++i) {
-        vec[i] = arr[i][column];
-    }
-    return vec;
+template<class T>
+BasicColView<const T> BasicMatrix<T>::colView(size_t m) const {
+    return view().colView(m);
 }
 
-std::ostream &task::operator<<(std::ostream &output, const Matrix &matrix) {
+template<class T>
+std::ostream &task::operator<<(std::ostream &output, const BasicMatrix<T> &matrix) {
     for (size_t i = 0; i < matrix.getRow(); ++i) {
         for (size_t j = 0; j < matrix.getCol(); ++j) {
             output << matrix[i][j] << " ";
@@ -263,55 +454,87 @@ std::ostream &task::operator<<(std::ostream &output, const Matrix &matrix) {
     return output;
 }
 
-std::istream &task::operator>>(std::istream &input, Matrix &matrix) {
+template<class T>
+std::istream &task::operator>>(std::istream &input, BasicMatrix<T> &matrix) {
     size_t n, m;
     input >> n >> m;
-    matrix.resize(n, m);
-    for (size_t i = 0; i < n; ++i) {
-        for (size_t j = 0; j < m; ++j) {
-            input >> matrix[i][j];
-        }
+    if (matrix.getRow() != n || matrix.getCol() != m) {
+        BasicMatrix<T> temp(n, m);
+        matrix.swap(temp);
+    }
+    T *values = matrix.data();
+    for (size_t i = 0; i < n * m; ++i) {
+        input >> values[i];
     }
     return input;
 }
 
-double Matrix::det() const {
-    checkMismatch();
-    Matrix arr = *this;
-    for (size_t i = 0; i < arr.getRow() - 1; ++i) {
-        for (size_t j = i + 1; j < arr.getCol(); ++j) {
-            double coef = double(arr[j][i]) / arr[i][i];
-            for (size_t k = i; k < arr.getRow(); ++k) {
-                arr[j][k] -= arr[i][k] * coef;
-            }
-        }
-    }
-    double d = 1;
-    for (size_t i = 0; i < arr.getRow(); ++i) {
-        d *= arr[i][i];
+template<class T>
+T BasicMatrix<T>::det() const {
+    if constexpr (std::is_integral<T>::value) {
+        checkMismatch();
+        return bareissDet(arr, row);
+    } else {
+        return BasicLU<T>(*this).det();
     }
-    return d;
 }
 
-double Matrix::trace() const {
+template<class T>
+T BasicMatrix<T>::trace() const {
     checkMismatch();
-    double s = 0;
+    if constexpr (std::is_floating_point<T>::value) {
+        if (summation() != Summation::PLAIN) {
+            return sum(arr, row, col + 1);
+        }
+    }
+    T s = T(0);
     for (size_t i = 0; i < getRow(); ++i) {
-        s += arr[i][i];
+        s += arr[i * col + i];
     }
     return s;
 }
 
-Matrix Matrix::transposed() const {
-    Matrix temp(getCol(), getRow());
-    for (size_t i = 0; i < getRow(); ++i) {
-        for (size_t j = 0; j < getCol(); ++j) {
-            temp[j][i] = arr[i][j];
+template<class T>
+BasicMatrix<T> BasicMatrix<T>::transposed() const {
+    BasicMatrix<T> temp(getCol(), getRow());
+    CounterScope counter(Operation::TRANSPOSE, row * col * sizeof(T));
+    size_t grain = std::max<size_t>(TRANSPOSE_TILE, PARALLEL_THRESHOLD / std::max<size_t>(col, 1));
+    parallelFor(row, grain, [&](size_t begin, size_t end) {
+        for (size_t ii = begin; ii < end; ii += TRANSPOSE_TILE) {
+            for (size_t jj = 0; jj < col; jj += TRANSPOSE_TILE) {
+                for (size_t i = ii; i < std::min(end, ii + TRANSPOSE_TILE); ++i) {
+                    for (size_t j = jj; j < std::min(col, jj + TRANSPOSE_TILE); ++j) {
+                        temp.arr[j * row + i] = arr[i * col + j];
+                    }
+                }
+            }
         }
-    }
+    });
     return temp;
 }
 
-void Matrix::transpose() {
-    *this = this->transposed();
-}
\ No newline at end of file
+template<class T>
+void BasicMatrix<T>::transpose() {
+    CounterScope counter(Operation::TRANSPOSE, row * col * sizeof(T));
+    if (row == col) {
+        transposeSquare(arr, col, 0, row);
+    } else if (row > 1 && col > 1) {
+        transposeCycles(arr, row, col);
+    }
+    std::swap(row, col);
+}
+
+#define MATRIX_INSTANTIATE(T)                                                                                   \
+    template class task::BasicMatrix<T>;                                                                        \
+    template void task::swap(BasicMatrix<T> &, BasicMatrix<T> &) noexcept;                                      \
+    template BasicMatrix<T> task::multiply(const BasicMatrix<T> &, const BasicMatrix<T> &);                     \
+    template BasicMatrix<T> task::multiply(const BasicMatrixView<const T> &, const BasicMatrixView<const T> &); \
+    template void task::multiply(const BasicMatrixView<const T> &, const BasicMatrixView<const T> &,            \
+                                 const BasicMatrixView<T> &);                                                   \
+    template std::ostream &task::operator<<(std::ostream &, const BasicMatrix<T> &);                            \
+    template std::istream &task::operator>>(std::istream &, BasicMatrix<T> &);
+
+MATRIX_INSTANTIATE(float)
+MATRIX_INSTANTIATE(double)
+MATRIX_INSTANTIATE(int64_t)
+MATRIX_INSTANTIATE(std::complex<double>)
@@ -1,107 +1,221 @@
 #pragma once
 
+#include "matrix_counters.h"
+#include "matrix_expr.h"
+#include "matrix_memory.h"
+#include "thread_pool.h"
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <vector>
 
+#ifndef MATRIX_ALIGNMENT
+#define MATRIX_ALIGNMENT 64
+#endif
+
 
 namespace task {
 
-    const double EPS = 1e-6;
+    constexpr double EPS = 1e-6;
+
+    const size_t ALIGNMENT = MATRIX_ALIGNMENT;
 
 
     class OutOfBoundsException : public std::exception {};
     class SizeMismatchException : public std::exception {};
+    class SingularMatrixException : public std::exception {};
+    class NotPositiveDefiniteException : public std::exception {};
+
+
+    // Per-element-type tolerance used by == and !=; integers compare exactly.
+    template<class T>
+    struct MatrixTraits;
+
+    template<>
+    struct MatrixTraits<float> {
+        static constexpr float EPS = 1e-4f;
+    };
+
+    template<>
+    struct MatrixTraits<double> {
+        static constexpr double EPS = task::EPS;
+    };
+
+    template<>
+    struct MatrixTraits<int64_t> {
+        static constexpr int64_t EPS = 0;
+    };
+
+    template<>
+    struct MatrixTraits<std::complex<double>> {
+        static constexpr double EPS = task::EPS;
+    };
+
+
+    // Complex conjugate that keeps real types real, unlike std::conj.
+    template<class T>
+    T conjugate(const T &x) {
+        return x;
+    }
+
+    inline std::complex<double> conjugate(const std::complex<double> &x) {
+        return std::conj(x);
+    }
 
 
-    class Matrix {
+    template<class T>
+    class BasicMatrixView;
+
+    template<class T>
+    class BasicRowView;
+
+    template<class T>
+    class BasicColView;
+
+
+    // Buffers come from the memory resource given at construction, matrixResource() otherwise;
+    // copies take matrixResource() like std::pmr containers, moves and swaps carry theirs along.
+    // Instantiated for float, double, int64_t and std::complex<double>.
+    template<class T>
+    class BasicMatrix : public MatrixExpr<BasicMatrix<T>> {
     public:
-        Matrix();
+        using value_type = T;
+
+        BasicMatrix();
+
+        BasicMatrix(size_t rows, size_t cols);
+
+        BasicMatrix(size_t rows, size_t cols, std::pmr::memory_resource *resource);
 
-        Matrix(size_t rows, size_t cols);
+        template<class E>
+        BasicMatrix(const MatrixExpr<E> &expr);
 
-        ~Matrix();
+        ~BasicMatrix();
 
         class ProxyArr {
         public:
-            explicit ProxyArr(double *row) : row(row) {}
+            explicit ProxyArr(T *row) : row(row) {}
 
-            const double &operator[](size_t m) const {
-                double &temp = row[m];
+            const T &operator[](size_t m) const {
+                T &temp = row[m];
                 //delete this;
                 return temp;
             }
 
-            double &operator[](size_t m) {
-                double &temp = row[m];
+            T &operator[](size_t m) {
+                T &temp = row[m];
                 //delete this;
                 return temp;
             }
 
         private:
-            double *row;
+            T *row;
         };
 
-        ProxyArr operator[](size_t n) const;
+        ProxyArr operator[](size_t n) const {
+            return ProxyArr(arr + n * col);
+        }
 
         size_t getRow() const;
 
         size_t getCol() const;
 
-        double &get(size_t row, size_t col);
+        T *data();
 
-        const double &get(size_t row, size_t col) const;
+        const T *data() const;
 
-        void set(size_t row, size_t col, const double &value);
+        std::pmr::memory_resource *getResource() const;
+
+        T &get(size_t row, size_t col);
+
+        const T &get(size_t row, size_t col) const;
+
+        void set(size_t row, size_t col, const T &value);
 
         void resize(size_t n, size_t m);
 
-        Matrix &operator+=(const Matrix &a);
+        BasicMatrix &operator+=(const BasicMatrix &a);
 
-        Matrix &operator-=(const Matrix &a);
+        BasicMatrix &operator-=(const BasicMatrix &a);
 
-        Matrix &operator*=(const Matrix &a);
+        BasicMatrix &operator*=(const BasicMatrix &a);
 
-        Matrix &operator*=(const double &number);
+        BasicMatrix &operator*=(const T &number);
 
+        template<class E>
+        BasicMatrix &operator+=(const MatrixExpr<E> &expr);
 
-        Matrix operator+(const Matrix &a) const;
+        template<class E>
+        BasicMatrix &operator-=(const MatrixExpr<E> &expr);
 
-        Matrix operator-(const Matrix &a) const;
 
-        Matrix operator*(const Matrix &a) const;
+        // Exact (fraction-free elimination) for int64_t, LU-based otherwise.
+        T det() const;
 
-        Matrix operator*(const double &a) const;
+        void transpose();
 
-        Matrix operator-() const;
+        BasicMatrix transposed() const;
 
-        Matrix operator+() const;
+        T trace() const;
 
-        bool operator==(const Matrix &a) const;
+        std::vector<T> getRow(size_t row);
 
-        bool operator!=(const Matrix &a) const;
+        std::vector<T> getColumn(size_t column);
 
-        double det() const;
+        BasicMatrixView<T> view();
 
-        void transpose();
+        BasicMatrixView<const T> view() const;
+
+        operator BasicMatrixView<const T>() const;
+
+        // Throws OutOfBoundsException unless the block lies inside the matrix.
+        BasicMatrixView<T> block(size_t row, size_t col, size_t rows, size_t cols);
 
-        Matrix transposed() const;
+        BasicMatrixView<const T> block(size_t row, size_t col, size_t rows, size_t cols) const;
 
-        double trace() const;
+        BasicRowView<T> rowView(size_t row);
 
-        std::vector<double> getRow(size_t row);
+        BasicRowView<const T> rowView(size_t row) const;
 
-        std::vector<double> getColumn(size_t column);
+        BasicColView<T> colView(size_t col);
 
-        Matrix(const Matrix &copy);
+        BasicColView<const T> colView(size_t col) const;
 
-        Matrix &operator=(const Matrix &a);
+        BasicMatrix(const BasicMatrix &copy);
+
+        BasicMatrix(BasicMatrix &&other) noexcept;
+
+        BasicMatrix &operator=(const BasicMatrix &a);
+
+        BasicMatrix &operator=(BasicMatrix &&other) noexcept;
+
+        void swap(BasicMatrix &other) noexcept;
+
+        template<class E>
+        BasicMatrix &operator=(const MatrixExpr<E> &expr);
+
+        const T *span(size_t i, size_t j, size_t, T *) const {
+            return arr + i * col + j;
+        }
+
+        template<class M>
+        bool refersTo(const M &matrix) const {
+            return overlaps(*this, matrix);
+        }
 
     private:
-        double **arr = nullptr;
+        T *arr = nullptr;
         size_t row, col;
+        std::pmr::memory_resource *resource = matrixResource();
 
         void allocateMemory();
 
+        T *allocate(size_t size);
+
+        void deallocate(T *ptr, size_t size);
+
         void markWithOnes();
 
         size_t getMin(size_t a, size_t b);
@@ -110,17 +224,69 @@ namespace task {
 
         void checkMismatch() const;
 
-        static double abs(double a);
-
-        static bool areClose(double a, double b);
-
         void deallocateMemory();
+
+        template<class E, class Store>
+        void evaluate(const MatrixExpr<E> &expr, bool direct, Store store);
     };
 
-    task::Matrix operator*(const double &a, const Matrix &b);
+    using Matrix = BasicMatrix<double>;
+
+    template<class T>
+    void swap(BasicMatrix<T> &a, BasicMatrix<T> &b) noexcept;
+
+    template<class T>
+    BasicMatrix<T> multiply(const BasicMatrix<T> &a, const BasicMatrix<T> &b);
+
+    template<class L, class R>
+    MatrixSum<L, R> operator+(const MatrixExpr<L> &a, const MatrixExpr<R> &b);
+
+    template<class L, class R>
+    MatrixDifference<L, R> operator-(const MatrixExpr<L> &a, const MatrixExpr<R> &b);
+
+    template<class E>
+    MatrixScaled<E> operator*(const MatrixExpr<E> &a, typename E::value_type number);
+
+    template<class E>
+    MatrixScaled<E> operator*(typename E::value_type number, const MatrixExpr<E> &a);
+
+    template<class E>
+    MatrixScaled<E> operator-(const MatrixExpr<E> &a);
+
+    template<class E>
+    const E &operator+(const MatrixExpr<E> &a);
+
+    template<class L, class R>
+    BasicMatrix<typename L::value_type> operator*(const MatrixExpr<L> &a, const MatrixExpr<R> &b);
+
+    template<class L, class R>
+    bool operator==(const MatrixExpr<L> &a, const MatrixExpr<R> &b);
+
+    template<class L, class R>
+    bool operator!=(const MatrixExpr<L> &a, const MatrixExpr<R> &b);
+
+    template<class T>
+    std::ostream &operator<<(std::ostream &output, const BasicMatrix<T> &matrix);
+
+    template<class T>
+    std::istream &operator>>(std::istream &input, BasicMatrix<T> &matrix);
+
+#define MATRIX_EXTERN_TEMPLATES(T)                                                            \
+    extern template class BasicMatrix<T>;                                                     \
+    extern template void swap(BasicMatrix<T> &, BasicMatrix<T> &) noexcept;                   \
+    extern template BasicMatrix<T> multiply(const BasicMatrix<T> &, const BasicMatrix<T> &); \
+    extern template std::ostream &operator<<(std::ostream &, const BasicMatrix<T> &);         \
+    extern template std::istream &operator>>(std::istream &, BasicMatrix<T> &);
+
+    MATRIX_EXTERN_TEMPLATES(float)
+    MATRIX_EXTERN_TEMPLATES(double)
+    MATRIX_EXTERN_TEMPLATES(int64_t)
+    MATRIX_EXTERN_TEMPLATES(std::complex<double>)
+
+#undef MATRIX_EXTERN_TEMPLATES
 
-    std::ostream &operator<<(std::ostream &output, const Matrix &matrix);
+}// namespace task
 
-    std::istream &operator>>(std::istream &input, Matrix &matrix);
 
-}// namespace task
\ No newline at end of file
+#include "matrix.tpp"
+#include "matrix_view.h"
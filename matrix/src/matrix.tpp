@@ -0,0 +1,159 @@
+#include <cmath>
+
+namespace task {
+
+    template<class L, class R>
+    void checkSameSize(const MatrixExpr<L> &a, const MatrixExpr<R> &b) {
+        if (a.getRow() != b.getRow() || a.getCol() != b.getCol()) {
+            throw SizeMismatchException();
+        }
+    }
+
+    template<class T>
+    template<class E, class Store>
+    void BasicMatrix<T>::evaluate(const MatrixExpr<E> &expr, bool direct, Store store) {
+        const E &e = expr.self();
+        CounterScope counter(Operation::ELEMENTWISE, row * col * sizeof(T));
+        size_t grain = std::max<size_t>(1, PARALLEL_THRESHOLD / std::max<size_t>(col, 1));
+        parallelFor(row, grain, [&](size_t begin, size_t end) {
+            T buffer[EXPR_BLOCK];
+            for (size_t i = begin; i < end; ++i) {
+                for (size_t j = 0; j < col; j += EXPR_BLOCK) {
+                    size_t len = std::min(EXPR_BLOCK, col - j);
+                    T *dst = arr + i * col + j;
+                    store(dst, e.span(i, j, len, direct ? dst : buffer), len);
+                }
+            }
+        });
+    }
+
+    template<class T>
+    template<class E>
+    BasicMatrix<T>::BasicMatrix(const MatrixExpr<E> &expr) : row(expr.getRow()), col(expr.getCol()) {
+        allocateMemory();
+        evaluate(expr, true, [](T *dst, const T *src, size_t len) {
+            if (src != dst) {
+                std::copy_n(src, len, dst);
+            }
+        });
+    }
+
+    template<class T>
+    template<class E>
+    BasicMatrix<T> &BasicMatrix<T>::operator=(const MatrixExpr<E> &expr) {
+        if (row != expr.getRow() || col != expr.getCol()) {
+            // Like copy assignment, the new buffer comes from this matrix's own resource.
+            BasicMatrix temp(expr.getRow(), expr.getCol(), resource);
+            temp.evaluate(expr, true, [](T *dst, const T *src, size_t len) {
+                if (src != dst) {
+                    std::copy_n(src, len, dst);
+                }
+            });
+            swap(temp);
+            return *this;
+        }
+        evaluate(expr, !expr.refersTo(*this), [](T *dst, const T *src, size_t len) {
+            if (src != dst) {
+                std::copy_n(src, len, dst);
+            }
+        });
+        return *this;
+    }
+
+    template<class T>
+    template<class E>
+    BasicMatrix<T> &BasicMatrix<T>::operator+=(const MatrixExpr<E> &expr) {
+        checkSameSize(*this, expr);
+        evaluate(expr, false, [](T *dst, const T *src, size_t len) {
+            kernels<T>().add(dst, src, len);
+        });
+        return *this;
+    }
+
+    template<class T>
+    template<class E>
+    BasicMatrix<T> &BasicMatrix<T>::operator-=(const MatrixExpr<E> &expr) {
+        checkSameSize(*this, expr);
+        evaluate(expr, false, [](T *dst, const T *src, size_t len) {
+            kernels<T>().sub(dst, src, len);
+        });
+        return *this;
+    }
+
+    template<class L, class R>
+    MatrixSum<L, R> operator+(const MatrixExpr<L> &a, const MatrixExpr<R> &b) {
+        checkSameSize(a, b);
+        return MatrixSum<L, R>(a.self(), b.self());
+    }
+
+    template<class L, class R>
+    MatrixDifference<L, R> operator-(const MatrixExpr<L> &a, const MatrixExpr<R> &b) {
+        checkSameSize(a, b);
+        return MatrixDifference<L, R>(a.self(), b.self());
+    }
+
+    template<class E>
+    MatrixScaled<E> operator*(const MatrixExpr<E> &a, typename E::value_type number) {
+        return MatrixScaled<E>(a.self(), number);
+    }
+
+    template<class E>
+    MatrixScaled<E> operator*(typename E::value_type number, const MatrixExpr<E> &a) {
+        return MatrixScaled<E>(a.self(), number);
+    }
+
+    template<class E>
+    MatrixScaled<E> operator-(const MatrixExpr<E> &a) {
+        return MatrixScaled<E>(a.self(), typename E::value_type(-1));
+    }
+
+    template<class E>
+    const E &operator+(const MatrixExpr<E> &a) {
+        return a.self();
+    }
+
+    template<class T>
+    const BasicMatrix<T> &evaluated(const MatrixExpr<BasicMatrix<T>> &a) {
+        return a.self();
+    }
+
+    template<class E>
+    BasicMatrix<typename E::value_type> evaluated(const MatrixExpr<E> &a) {
+        return BasicMatrix<typename E::value_type>(a);
+    }
+
+    template<class L, class R>
+    BasicMatrix<typename L::value_type> operator*(const MatrixExpr<L> &a, const MatrixExpr<R> &b) {
+        const auto &x = evaluated(a);
+        const auto &y = evaluated(b);
+        return multiply(x.view(), y.view());
+    }
+
+    template<class L, class R>
+    bool operator==(const MatrixExpr<L> &a, const MatrixExpr<R> &b) {
+        if (a.getRow() != b.getRow() || a.getCol() != b.getCol()) {
+            return false;
+        }
+        using T = typename L::value_type;
+        T left[EXPR_BLOCK], right[EXPR_BLOCK];
+        for (size_t i = 0; i < a.getRow(); ++i) {
+            for (size_t j = 0; j < a.getCol(); j += EXPR_BLOCK) {
+                size_t len = std::min(EXPR_BLOCK, a.getCol() - j);
+                const T *l = a.self().span(i, j, len, left);
+                const T *r = b.self().span(i, j, len, right);
+                for (size_t k = 0; k < len; ++k) {
+                    if (!(std::abs(l[k] - r[k]) <= MatrixTraits<T>::EPS)) {
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    template<class L, class R>
+    bool operator!=(const MatrixExpr<L> &a, const MatrixExpr<R> &b) {
+        return !(a == b);
+    }
+
+}// namespace task
@@ -0,0 +1,410 @@
+#include "matrix_batch.h"
+#include "kernels.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace task;
+
+namespace {
+
+    const size_t L = BATCH_LANES;
+
+    // Lanes of one vector register of Bytes bytes, each holding the same element of a different
+    // matrix. The kernels handle a block of L matrices one register at a time and are instantiated
+    // once per SIMD target, picked by simdLevel(). Pointers address the start of a block.
+    template<class T, size_t Bytes>
+    struct Lanes {
+        typedef T type __attribute__((vector_size(Bytes)));
+        static const size_t WIDTH = Bytes / sizeof(T);
+    };
+
+    template<class V, class T>
+    __attribute__((always_inline)) inline void load(V &v, const T *p) {
+        std::memcpy(&v, p, sizeof(v));
+    }
+
+    template<class V, class T>
+    __attribute__((always_inline)) inline void store(T *p, const V &v) {
+        std::memcpy(p, &v, sizeof(v));
+    }
+
+    template<class T, size_t Bytes>
+    __attribute__((always_inline)) inline void detClosed2(const T *a, T *out) {
+        typename Lanes<T, Bytes>::type a00, a01, a10, a11;
+        for (size_t v = 0; v < L; v += Lanes<T, Bytes>::WIDTH) {
+            load(a00, a + v), load(a01, a + L + v), load(a10, a + 2 * L + v), load(a11, a + 3 * L + v);
+            store(out + v, a00 * a11 - a01 * a10);
+        }
+    }
+
+    template<class T, size_t Bytes>
+    __attribute__((always_inline)) inline void detClosed3(const T *a, T *out) {
+        typename Lanes<T, Bytes>::type a00, a01, a02, a10, a11, a12, a20, a21, a22;
+        for (size_t v = 0; v < L; v += Lanes<T, Bytes>::WIDTH) {
+            load(a00, a + v), load(a01, a + L + v), load(a02, a + 2 * L + v);
+            load(a10, a + 3 * L + v), load(a11, a + 4 * L + v), load(a12, a + 5 * L + v);
+            load(a20, a + 6 * L + v), load(a21, a + 7 * L + v), load(a22, a + 8 * L + v);
+            store(out + v, a00 * (a11 * a22 - a12 * a21) - a01 * (a10 * a22 - a12 * a20) +
+                                   a02 * (a10 * a21 - a11 * a20));
+        }
+    }
+
+    template<class T, size_t Bytes>
+    __attribute__((always_inline)) inline void detClosed4(const T *a, T *out) {
+        typename Lanes<T, Bytes>::type a0, a1, a2, a3, b0, b1, b2, b3;
+        for (size_t v = 0; v < L; v += Lanes<T, Bytes>::WIDTH) {
+            load(a0, a + v), load(a1, a + L + v), load(a2, a + 2 * L + v), load(a3, a + 3 * L + v);
+            load(b0, a + 4 * L + v), load(b1, a + 5 * L + v), load(b2, a + 6 * L + v), load(b3, a + 7 * L + v);
+            auto s0 = a0 * b1 - b0 * a1, s1 = a0 * b2 - b0 * a2, s2 = a0 * b3 - b0 * a3;
+            auto s3 = a1 * b2 - b1 * a2, s4 = a1 * b3 - b1 * a3, s5 = a2 * b3 - b2 * a3;
+            load(a0, a + 8 * L + v), load(a1, a + 9 * L + v), load(a2, a + 10 * L + v), load(a3, a + 11 * L + v);
+            load(b0, a + 12 * L + v), load(b1, a + 13 * L + v), load(b2, a + 14 * L + v), load(b3, a + 15 * L + v);
+            auto c5 = a2 * b3 - b2 * a3, c4 = a1 * b3 - b1 * a3, c3 = a1 * b2 - b1 * a2;
+            auto c2 = a0 * b3 - b0 * a3, c1 = a0 * b2 - b0 * a2, c0 = a0 * b1 - b0 * a1;
+            store(out + v, s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0);
+        }
+    }
+
+    // Gaussian elimination with partial pivoting, every lane choosing its own pivot rows. Row swaps
+    // and the zero-pivot guard are blends rather than branches so the lanes never diverge.
+    // work holds n * n vectors.
+    template<class T, size_t Bytes>
+    __attribute__((always_inline)) inline void detEliminate(const T *a, size_t n, T *work, T *out) {
+        using V = typename Lanes<T, Bytes>::type;
+        const size_t W = Lanes<T, Bytes>::WIDTH;
+        V zero = {}, one = zero + T(1);
+        for (size_t v = 0; v < L; v += W) {
+            V x, y;
+            for (size_t e = 0; e < n * n; ++e) {
+                load(x, a + e * L + v);
+                store(work + e * W, x);
+            }
+            V det = one;
+            for (size_t k = 0; k < n; ++k) {
+                V best, pivot = zero + T(k);
+                load(best, work + (k * n + k) * W);
+                best = best < zero ? -best : best;
+                for (size_t r = k + 1; r < n; ++r) {
+                    load(x, work + (r * n + k) * W);
+                    x = x < zero ? -x : x;
+                    auto better = x > best;
+                    best = better ? x : best;
+                    pivot = better ? zero + T(r) : pivot;
+                }
+                for (size_t r = k + 1; r < n; ++r) {
+                    auto swap = pivot == T(r);
+                    det = swap ? -det : det;
+                    for (size_t c = k; c < n; ++c) {
+                        load(x, work + (k * n + c) * W), load(y, work + (r * n + c) * W);
+                        store(work + (k * n + c) * W, swap ? y : x);
+                        store(work + (r * n + c) * W, swap ? x : y);
+                    }
+                }
+                V top;
+                load(top, work + (k * n + k) * W);
+                det *= top;
+                // A zero pivot leaves det 0; dividing by one instead keeps the lane finite.
+                V inverse = one / (top == zero ? one : top);
+                for (size_t r = k + 1; r < n; ++r) {
+                    V lead;
+                    load(lead, work + (r * n + k) * W);
+                    lead *= inverse;
+                    for (size_t c = k + 1; c < n; ++c) {
+                        load(x, work + (k * n + c) * W), load(y, work + (r * n + c) * W);
+                        store(work + (r * n + c) * W, y - lead * x);
+                    }
+                }
+            }
+            store(out + v, det);
+        }
+    }
+
+    template<class T, size_t Bytes>
+    __attribute__((always_inline)) inline void detBlock(const T *a, size_t n, T *work, T *out) {
+        switch (n) {
+            case 2:
+                detClosed2<T, Bytes>(a, out);
+                break;
+            case 3:
+                detClosed3<T, Bytes>(a, out);
+                break;
+            case 4:
+                detClosed4<T, Bytes>(a, out);
+                break;
+            default:
+                detEliminate<T, Bytes>(a, n, work, out);
+        }
+    }
+
+    // c (n x m) = a (n x k) * b (k x m) for a block, four columns of c at a time so that four
+    // independent sums stay in registers.
+    template<class T, size_t Bytes>
+    __attribute__((always_inline)) inline void multiplyBlock(const T *a, const T *b, T *c, size_t n, size_t k,
+                                                             size_t m) {
+        using V = typename Lanes<T, Bytes>::type;
+        V x, y0, y1, y2, y3;
+        for (size_t v = 0; v < L; v += Lanes<T, Bytes>::WIDTH) {
+            for (size_t i = 0; i < n; ++i) {
+                size_t j = 0;
+                for (; j + 4 <= m; j += 4) {
+                    V s0 = {}, s1 = {}, s2 = {}, s3 = {};
+                    for (size_t p = 0; p < k; ++p) {
+                        const T *row = b + (p * m + j) * L + v;
+                        load(x, a + (i * k + p) * L + v);
+                        load(y0, row), load(y1, row + L), load(y2, row + 2 * L), load(y3, row + 3 * L);
+                        s0 += x * y0, s1 += x * y1, s2 += x * y2, s3 += x * y3;
+                    }
+                    T *out = c + (i * m + j) * L + v;
+                    store(out, s0), store(out + L, s1), store(out + 2 * L, s2), store(out + 3 * L, s3);
+                }
+                for (; j < m; ++j) {
+                    V sum = {};
+                    for (size_t p = 0; p < k; ++p) {
+                        load(x, a + (i * k + p) * L + v), load(y0, b + (p * m + j) * L + v);
+                        sum += x * y0;
+                    }
+                    store(c + (i * m + j) * L + v, sum);
+                }
+            }
+        }
+    }
+
+    template<class T>
+    void detDefault(const T *a, size_t n, T *work, T *out) {
+        detBlock<T, 16>(a, n, work, out);
+    }
+
+    template<class T>
+    __attribute__((target("avx2,fma"))) void detAvx2(const T *a, size_t n, T *work, T *out) {
+        detBlock<T, 32>(a, n, work, out);
+    }
+
+    template<class T>
+    __attribute__((target("avx512f"))) void detAvx512(const T *a, size_t n, T *work, T *out) {
+        detBlock<T, 64>(a, n, work, out);
+    }
+
+    template<class T>
+    void multiplyDefault(const T *a, const T *b, T *c, size_t n, size_t k, size_t m) {
+        multiplyBlock<T, 16>(a, b, c, n, k, m);
+    }
+
+    template<class T>
+    __attribute__((target("avx2,fma"))) void multiplyAvx2(const T *a, const T *b, T *c, size_t n, size_t k,
+                                                          size_t m) {
+        multiplyBlock<T, 32>(a, b, c, n, k, m);
+    }
+
+    template<class T>
+    __attribute__((target("avx512f"))) void multiplyAvx512(const T *a, const T *b, T *c, size_t n, size_t k,
+                                                           size_t m) {
+        multiplyBlock<T, 64>(a, b, c, n, k, m);
+    }
+
+    template<class T>
+    using DetFunction = void (*)(const T *, size_t, T *, T *);
+
+    template<class T>
+    using MultiplyFunction = void (*)(const T *, const T *, T *, size_t, size_t, size_t);
+
+    template<class T>
+    DetFunction<T> detFunction() {
+        switch (simdLevel()) {
+            case SimdLevel::AVX512:
+                return detAvx512<T>;
+            case SimdLevel::AVX2:
+                return detAvx2<T>;
+            default:
+                return detDefault<T>;
+        }
+    }
+
+    template<class T>
+    MultiplyFunction<T> multiplyFunction() {
+        switch (simdLevel()) {
+            case SimdLevel::AVX512:
+                return multiplyAvx512<T>;
+            case SimdLevel::AVX2:
+                return multiplyAvx2<T>;
+            default:
+                return multiplyDefault<T>;
+        }
+    }
+
+    // Lane blocks per task so that every task does about PARALLEL_THRESHOLD operations.
+    size_t blockGrain(size_t work) {
+        return std::max<size_t>(1, PARALLEL_THRESHOLD / std::max<size_t>(1, work * L));
+    }
+
+}// namespace
+
+template<class T>
+BasicMatrixBatch<T>::BasicMatrixBatch(size_t count, size_t rows, size_t cols)
+    : count(count), row(rows), col(cols), blockCount((count + L - 1) / L), values(blockCount * rows * cols * L) {}
+
+template<class T>
+size_t BasicMatrixBatch<T>::size() const {
+    return count;
+}
+
+template<class T>
+size_t BasicMatrixBatch<T>::getRow() const {
+    return row;
+}
+
+template<class T>
+size_t BasicMatrixBatch<T>::getCol() const {
+    return col;
+}
+
+template<class T>
+size_t BasicMatrixBatch<T>::blocks() const {
+    return blockCount;
+}
+
+template<class T>
+T *BasicMatrixBatch<T>::lanes(size_t block, size_t n, size_t m) {
+    return values.data() + ((block * row + n) * col + m) * L;
+}
+
+template<class T>
+const T *BasicMatrixBatch<T>::lanes(size_t block, size_t n, size_t m) const {
+    return values.data() + ((block * row + n) * col + m) * L;
+}
+
+template<class T>
+void BasicMatrixBatch<T>::checkIndex(size_t index, size_t n, size_t m) const {
+    if (index >= count || n >= row || m >= col) {
+        throw OutOfBoundsException();
+    }
+}
+
+template<class T>
+T &BasicMatrixBatch<T>::get(size_t index, size_t n, size_t m) {
+    checkIndex(index, n, m);
+    return lanes(index / L, n, m)[index % L];
+}
+
+template<class T>
+const T &BasicMatrixBatch<T>::get(size_t index, size_t n, size_t m) const {
+    checkIndex(index, n, m);
+    return lanes(index / L, n, m)[index % L];
+}
+
+template<class T>
+void BasicMatrixBatch<T>::setMatrix(size_t index, const BasicMatrixView<const T> &matrix) {
+    if (index >= count) {
+        throw OutOfBoundsException();
+    }
+    if (matrix.getRow() != row || matrix.getCol() != col) {
+        throw SizeMismatchException();
+    }
+    for (size_t i = 0; i < row; ++i) {
+        for (size_t j = 0; j < col; ++j) {
+            lanes(index / L, i, j)[index % L] = matrix[i][j];
+        }
+    }
+}
+
+template<class T>
+BasicMatrix<T> BasicMatrixBatch<T>::getMatrix(size_t index) const {
+    if (index >= count) {
+        throw OutOfBoundsException();
+    }
+    BasicMatrix<T> result(row, col);
+    for (size_t i = 0; i < row; ++i) {
+        for (size_t j = 0; j < col; ++j) {
+            result[i][j] = lanes(index / L, i, j)[index % L];
+        }
+    }
+    return result;
+}
+
+template<class T>
+BasicMatrixBatch<T> &BasicMatrixBatch<T>::operator+=(const BasicMatrixBatch &a) {
+    if (a.count != count || a.row != row || a.col != col) {
+        throw SizeMismatchException();
+    }
+    kernels<T>().add(values.data(), a.values.data(), values.size());
+    return *this;
+}
+
+template<class T>
+BasicMatrixBatch<T> &BasicMatrixBatch<T>::operator-=(const BasicMatrixBatch &a) {
+    if (a.count != count || a.row != row || a.col != col) {
+        throw SizeMismatchException();
+    }
+    kernels<T>().sub(values.data(), a.values.data(), values.size());
+    return *this;
+}
+
+template<class T>
+std::vector<T> BasicMatrixBatch<T>::det() const {
+    if (row != col) {
+        throw SizeMismatchException();
+    }
+    std::vector<T> result(blockCount * L, T(1));
+    size_t n = row;
+    if (n == 1) {
+        std::copy_n(values.data(), result.size(), result.data());
+    } else if (n > 1) {
+        DetFunction<T> function = detFunction<T>();
+        parallelFor(blockCount, blockGrain(n * n * n), [&](size_t begin, size_t end) {
+            std::vector<T> work(n > 4 ? n * n * L : 0);
+            for (size_t block = begin; block < end; ++block) {
+                function(lanes(block, 0, 0), n, work.data(), result.data() + block * L);
+            }
+        });
+    }
+    result.resize(count);
+    return result;
+}
+
+template<class T>
+BasicMatrixBatch<T> BasicMatrixBatch<T>::transposed() const {
+    BasicMatrixBatch result(count, col, row);
+    parallelFor(blockCount, blockGrain(row * col), [&](size_t begin, size_t end) {
+        for (size_t block = begin; block < end; ++block) {
+            for (size_t i = 0; i < row; ++i) {
+                for (size_t j = 0; j < col; ++j) {
+                    std::copy_n(lanes(block, i, j), L, result.lanes(block, j, i));
+                }
+            }
+        }
+    });
+    return result;
+}
+
+template<class T>
+BasicMatrixBatch<T> task::multiply(const BasicMatrixBatch<T> &a, const BasicMatrixBatch<T> &b) {
+    if (a.size() != b.size() || a.getCol() != b.getRow()) {
+        throw SizeMismatchException();
+    }
+    size_t n = a.getRow(), k = a.getCol(), m = b.getCol();
+    BasicMatrixBatch<T> c(a.size(), n, m);
+    if (n == 0 || m == 0 || k == 0) {
+        return c;
+    }
+    MultiplyFunction<T> function = multiplyFunction<T>();
+    parallelFor(a.blocks(), blockGrain(n * k * m), [&](size_t begin, size_t end) {
+        for (size_t block = begin; block < end; ++block) {
+            function(a.lanes(block, 0, 0), b.lanes(block, 0, 0), c.lanes(block, 0, 0), n, k, m);
+        }
+    });
+    return c;
+}
+
+template<class T>
+BasicMatrixBatch<T> task::operator*(const BasicMatrixBatch<T> &a, const BasicMatrixBatch<T> &b) {
+    return multiply(a, b);
+}
+
+#define BATCH_INSTANTIATE(T)                                                                               \
+    template class task::BasicMatrixBatch<T>;                                                              \
+    template BasicMatrixBatch<T> task::multiply(const BasicMatrixBatch<T> &, const BasicMatrixBatch<T> &);  \
+    template BasicMatrixBatch<T> task::operator*(const BasicMatrixBatch<T> &, const BasicMatrixBatch<T> &);
+
+BATCH_INSTANTIATE(float)
+BATCH_INSTANTIATE(double)
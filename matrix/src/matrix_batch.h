@@ -0,0 +1,71 @@
+#pragma once
+
+#include "matrix.h"
+
+#include <cstddef>
+#include <vector>
+
+
+namespace task {
+
+    // Matrices per block of a batch.
+    const size_t BATCH_LANES = 16;
+
+    // count matrices of one shape, BATCH_LANES at a time in structure-of-arrays layout: a block
+    // stores element (0, 0) of its matrices, then element (0, 1), and so on, so vector lanes hold
+    // the same element of consecutive matrices while every block stays contiguous. Operations run
+    // block by block in parallel. Instantiated for float and double.
+    template<class T>
+    class BasicMatrixBatch {
+    public:
+        // count zero matrices.
+        BasicMatrixBatch(size_t count, size_t rows, size_t cols);
+
+        size_t size() const;
+
+        size_t getRow() const;
+
+        size_t getCol() const;
+
+        size_t blocks() const;
+
+        // BATCH_LANES values of element (row, col), one per matrix of the block. The lanes of
+        // the last block past size() start out zero.
+        T *lanes(size_t block, size_t row, size_t col);
+
+        const T *lanes(size_t block, size_t row, size_t col) const;
+
+        T &get(size_t index, size_t row, size_t col);
+
+        const T &get(size_t index, size_t row, size_t col) const;
+
+        void setMatrix(size_t index, const BasicMatrixView<const T> &matrix);
+
+        BasicMatrix<T> getMatrix(size_t index) const;
+
+        BasicMatrixBatch &operator+=(const BasicMatrixBatch &a);
+
+        BasicMatrixBatch &operator-=(const BasicMatrixBatch &a);
+
+        // Closed-form up to 4 x 4, lane-wise partially pivoted elimination above that.
+        std::vector<T> det() const;
+
+        BasicMatrixBatch transposed() const;
+
+    private:
+        size_t count, row, col, blockCount;
+        std::vector<T> values;
+
+        void checkIndex(size_t index, size_t row, size_t col) const;
+    };
+
+    using MatrixBatch = BasicMatrixBatch<double>;
+
+    // Matrix-wise products of two batches of the same size.
+    template<class T>
+    BasicMatrixBatch<T> multiply(const BasicMatrixBatch<T> &a, const BasicMatrixBatch<T> &b);
+
+    template<class T>
+    BasicMatrixBatch<T> operator*(const BasicMatrixBatch<T> &a, const BasicMatrixBatch<T> &b);
+
+}// namespace task
@@ -0,0 +1,183 @@
+#include "matrix_counters.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+using namespace task;
+
+namespace {
+
+    // Written only by the owning thread, with plain loads and stores; atomic so readers on other
+    // threads may load them at any time.
+    struct Slot {
+        std::atomic<uint64_t> calls;
+        std::atomic<uint64_t> bytes;
+        std::atomic<uint64_t> flops;
+        std::atomic<uint64_t> cycles;
+    };
+
+    // Trivially destructible like the pool's cache: operations that run while other thread-local
+    // objects are destroyed still find it, closed, and count straight into the retired totals.
+    struct ThreadCounters {
+        Slot slots[OPERATION_COUNT];
+        bool closed;
+    };
+
+    struct Registry {
+        std::mutex mutex;
+        std::vector<ThreadCounters *> live;
+        MatrixCounters retired{};
+        MatrixCounters baseline{};
+    };
+
+    Registry &registry() {
+        // Never destroyed: threads may exit after every static destructor has run.
+        static Registry *registry = new Registry();
+        return *registry;
+    }
+
+    void add(OperationCounters &total, const Slot &slot) {
+        total.calls += slot.calls.load(std::memory_order_relaxed);
+        total.bytes += slot.bytes.load(std::memory_order_relaxed);
+        total.flops += slot.flops.load(std::memory_order_relaxed);
+        total.cycles += slot.cycles.load(std::memory_order_relaxed);
+    }
+
+    void add(OperationCounters &total, uint64_t bytes, uint64_t flops, uint64_t cycles) {
+        ++total.calls;
+        total.bytes += bytes;
+        total.flops += flops;
+        total.cycles += cycles;
+    }
+
+    void bump(std::atomic<uint64_t> &counter, uint64_t value) {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    struct CounterGuard {
+        ThreadCounters &counters;
+
+        explicit CounterGuard(ThreadCounters &counters) : counters(counters) {
+            Registry &r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            r.live.push_back(&counters);
+        }
+
+        ~CounterGuard() {
+            Registry &r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            for (size_t i = 0; i < OPERATION_COUNT; ++i) {
+                add(r.retired[i], counters.slots[i]);
+            }
+            r.live.erase(std::find(r.live.begin(), r.live.end(), &counters));
+            counters.closed = true;
+        }
+    };
+
+    ThreadCounters &threadCounters() {
+        thread_local ThreadCounters counters{};
+        thread_local CounterGuard guard{counters};
+        return counters;
+    }
+
+    MatrixCounters total(Registry &r) {
+        MatrixCounters result = r.retired;
+        for (const ThreadCounters *counters : r.live) {
+            for (size_t i = 0; i < OPERATION_COUNT; ++i) {
+                add(result[i], counters->slots[i]);
+            }
+        }
+        return result;
+    }
+
+}// namespace
+
+const char *task::operationName(Operation operation) {
+    switch (operation) {
+        case Operation::ALLOCATE:
+            return "allocate";
+        case Operation::COPY:
+            return "copy";
+        case Operation::ELEMENTWISE:
+            return "elementwise";
+        case Operation::MULTIPLY:
+            return "multiply";
+        case Operation::TRANSPOSE:
+            return "transpose";
+        case Operation::FACTORIZE:
+            return "factorize";
+        case Operation::SOLVE:
+            return "solve";
+        default:
+            return "unknown";
+    }
+}
+
+void task::recordOperation(Operation operation, uint64_t bytes, uint64_t flops, uint64_t cycles) {
+    ThreadCounters &counters = threadCounters();
+    if (counters.closed) {
+        Registry &r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        add(r.retired[size_t(operation)], bytes, flops, cycles);
+        return;
+    }
+    Slot &slot = counters.slots[size_t(operation)];
+    bump(slot.calls, 1);
+    bump(slot.bytes, bytes);
+    bump(slot.flops, flops);
+    bump(slot.cycles, cycles);
+}
+
+MatrixCounters task::readCounters() {
+    Registry &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    MatrixCounters result = total(r);
+    for (size_t i = 0; i < OPERATION_COUNT; ++i) {
+        result[i].calls -= r.baseline[i].calls;
+        result[i].bytes -= r.baseline[i].bytes;
+        result[i].flops -= r.baseline[i].flops;
+        result[i].cycles -= r.baseline[i].cycles;
+    }
+    return result;
+}
+
+void task::resetCounters() {
+    Registry &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.baseline = total(r);
+}
+
+void task::dumpCounters(std::ostream &output) {
+    MatrixCounters counters = readCounters();
+    if (!COUNTERS_ENABLED) {
+        output << "matrix counters disabled, build with -DMATRIX_COUNTERS=1\n";
+        bool recorded = std::any_of(counters.begin(), counters.end(),
+                                    [](const OperationCounters &c) { return c.calls != 0; });
+        if (!recorded) {
+            return;
+        }
+    }
+    std::ios_base::fmtflags flags = output.flags();
+    std::streamsize precision = output.precision();
+    output << std::left << std::setw(12) << "operation" << std::right << std::setw(12) << "calls"
+           << std::setw(16) << "bytes" << std::setw(16) << "flops" << std::setw(16) << "cycles"
+           << std::setw(14) << "cycles/call" << std::setw(14) << "flops/cycle" << "\n";
+    for (size_t i = 0; i < OPERATION_COUNT; ++i) {
+        const OperationCounters &c = counters[i];
+        if (c.calls == 0) {
+            continue;
+        }
+        output << std::left << std::setw(12) << operationName(Operation(i)) << std::right
+               << std::setw(12) << c.calls << std::setw(16) << c.bytes << std::setw(16) << c.flops
+               << std::setw(16) << c.cycles << std::fixed << std::setprecision(1)
+               << std::setw(14) << double(c.cycles) / double(c.calls) << std::setprecision(2)
+               << std::setw(14) << (c.cycles == 0 ? 0. : double(c.flops) / double(c.cycles))
+               << std::defaultfloat << "\n";
+    }
+    output.flags(flags);
+    output.precision(precision);
+}
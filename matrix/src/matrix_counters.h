@@ -0,0 +1,114 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+// Build the library and everything including it with -DMATRIX_COUNTERS=1 to record the counters
+// below. With the default 0 every CounterScope is an empty object and the hot paths are unchanged.
+#ifndef MATRIX_COUNTERS
+#define MATRIX_COUNTERS 0
+#endif
+
+#if MATRIX_COUNTERS && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#elif MATRIX_COUNTERS
+#include <chrono>
+#endif
+
+
+namespace task {
+
+    enum class Operation {
+        // Matrix buffers taken from the memory resource; bytes requested.
+        ALLOCATE,
+        // Copy construction and copy assignment; bytes copied.
+        COPY,
+        // +=, -=, scaling and evaluated expressions; bytes written.
+        ELEMENTWISE,
+        // multiply(), operator* and strassen(); 2 m n k flops.
+        MULTIPLY,
+        TRANSPOSE,
+        // LU, QR and Cholesky factorizations, with their textbook flop counts.
+        FACTORIZE,
+        // Substitutions through a factorization; 2 n^2 flops per right-hand side.
+        SOLVE,
+        COUNT
+    };
+
+    const size_t OPERATION_COUNT = size_t(Operation::COUNT);
+
+    const bool COUNTERS_ENABLED = MATRIX_COUNTERS;
+
+    // Times are inclusive: a det() also shows up in FACTORIZE, ALLOCATE and COPY. Cycles are
+    // time-stamp counter ticks on x86 and nanoseconds elsewhere. Flops count a multiply-add of
+    // the element type as two, complex ones included.
+    struct OperationCounters {
+        uint64_t calls = 0;
+        uint64_t bytes = 0;
+        uint64_t flops = 0;
+        uint64_t cycles = 0;
+    };
+
+    using MatrixCounters = std::array<OperationCounters, OPERATION_COUNT>;
+
+    const char *operationName(Operation operation);
+
+    // Every thread counts into its own block; reads add up the live blocks and those of exited
+    // threads, so they see all work finished before the call. When counters are disabled the
+    // library records nothing, and only explicit recordOperation() calls show up.
+    MatrixCounters readCounters();
+
+    // Later reads count from here. Safe to call while other threads are counting.
+    void resetCounters();
+
+    // One line per operation that has been called, with cycles per call and flops per cycle: what
+    // readCounters() returns. When counters are disabled a note comes first, followed by the table
+    // only if recordOperation() was called. The formatting flags of output are left as they were.
+    void dumpCounters(std::ostream &output);
+
+    void recordOperation(Operation operation, uint64_t bytes, uint64_t flops, uint64_t cycles);
+
+
+#if MATRIX_COUNTERS
+    inline uint64_t counterTicks() {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now().time_since_epoch())
+                .count();
+#endif
+    }
+
+    // Counts one call of operation, timed from construction to destruction.
+    class CounterScope {
+    public:
+        explicit CounterScope(Operation operation, uint64_t bytes = 0, uint64_t flops = 0)
+            : operation(operation), bytes(bytes), flops(flops), start(counterTicks()) {}
+
+        ~CounterScope() {
+            recordOperation(operation, bytes, flops, counterTicks() - start);
+        }
+
+        CounterScope(const CounterScope &) = delete;
+
+        CounterScope &operator=(const CounterScope &) = delete;
+
+    private:
+        Operation operation;
+        uint64_t bytes, flops, start;
+    };
+#else
+    class CounterScope {
+    public:
+        explicit CounterScope(Operation, uint64_t = 0, uint64_t = 0) {}
+
+        CounterScope(const CounterScope &) = delete;
+
+        CounterScope &operator=(const CounterScope &) = delete;
+    };
+#endif
+
+}// namespace task
@@ -0,0 +1,169 @@
+#pragma once
+
+#include "kernels.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+
+namespace task {
+
+    // Element-wise expressions are evaluated row by row in spans of at most EXPR_BLOCK elements,
+    // so intermediate results live in small stack buffers instead of full-size temporaries.
+    const size_t EXPR_BLOCK = 256;
+
+    template<class T>
+    class BasicMatrix;
+
+    template<class E>
+    class MatrixExpr {
+    public:
+        const E &self() const {
+            return static_cast<const E &>(*this);
+        }
+
+        size_t getRow() const {
+            return self().getRow();
+        }
+
+        size_t getCol() const {
+            return self().getCol();
+        }
+
+        // Pointer to elements [j, j + len) of row i, either stored in the operand itself
+        // or written into buffer, which holds at least len elements.
+        template<class T>
+        const T *span(size_t i, size_t j, size_t len, T *buffer) const {
+            return self().span(i, j, len, buffer);
+        }
+
+        template<class M>
+        bool refersTo(const M &matrix) const {
+            return self().refersTo(matrix);
+        }
+    };
+
+    // Matrices are captured by reference, nested expressions by value.
+    template<class E>
+    struct ExprOperand {
+        using type = E;
+    };
+
+    template<class T>
+    struct ExprOperand<BasicMatrix<T>> {
+        using type = const BasicMatrix<T> &;
+    };
+
+
+    template<class L, class R>
+    class MatrixSum : public MatrixExpr<MatrixSum<L, R>> {
+    public:
+        using value_type = typename L::value_type;
+
+        static_assert(std::is_same<value_type, typename R::value_type>::value, "operands must share an element type");
+
+        MatrixSum(const L &left, const R &right) : left(left), right(right) {}
+
+        size_t getRow() const {
+            return left.getRow();
+        }
+
+        size_t getCol() const {
+            return left.getCol();
+        }
+
+        const value_type *span(size_t i, size_t j, size_t len, value_type *buffer) const {
+            const value_type *l = left.span(i, j, len, buffer);
+            if (l != buffer) {
+                std::copy_n(l, len, buffer);
+            }
+            value_type scratch[EXPR_BLOCK];
+            kernels<value_type>().add(buffer, right.span(i, j, len, scratch), len);
+            return buffer;
+        }
+
+        template<class M>
+        bool refersTo(const M &matrix) const {
+            return left.refersTo(matrix) || right.refersTo(matrix);
+        }
+
+    private:
+        typename ExprOperand<L>::type left;
+        typename ExprOperand<R>::type right;
+    };
+
+
+    template<class L, class R>
+    class MatrixDifference : public MatrixExpr<MatrixDifference<L, R>> {
+    public:
+        using value_type = typename L::value_type;
+
+        static_assert(std::is_same<value_type, typename R::value_type>::value, "operands must share an element type");
+
+        MatrixDifference(const L &left, const R &right) : left(left), right(right) {}
+
+        size_t getRow() const {
+            return left.getRow();
+        }
+
+        size_t getCol() const {
+            return left.getCol();
+        }
+
+        const value_type *span(size_t i, size_t j, size_t len, value_type *buffer) const {
+            const value_type *l = left.span(i, j, len, buffer);
+            if (l != buffer) {
+                std::copy_n(l, len, buffer);
+            }
+            value_type scratch[EXPR_BLOCK];
+            kernels<value_type>().sub(buffer, right.span(i, j, len, scratch), len);
+            return buffer;
+        }
+
+        template<class M>
+        bool refersTo(const M &matrix) const {
+            return left.refersTo(matrix) || right.refersTo(matrix);
+        }
+
+    private:
+        typename ExprOperand<L>::type left;
+        typename ExprOperand<R>::type right;
+    };
+
+
+    template<class E>
+    class MatrixScaled : public MatrixExpr<MatrixScaled<E>> {
+    public:
+        using value_type = typename E::value_type;
+
+        MatrixScaled(const E &inner, value_type factor) : inner(inner), factor(factor) {}
+
+        size_t getRow() const {
+            return inner.getRow();
+        }
+
+        size_t getCol() const {
+            return inner.getCol();
+        }
+
+        const value_type *span(size_t i, size_t j, size_t len, value_type *buffer) const {
+            const value_type *p = inner.span(i, j, len, buffer);
+            if (p != buffer) {
+                std::copy_n(p, len, buffer);
+            }
+            kernels<value_type>().scale(buffer, factor, len);
+            return buffer;
+        }
+
+        template<class M>
+        bool refersTo(const M &matrix) const {
+            return inner.refersTo(matrix);
+        }
+
+    private:
+        typename ExprOperand<E>::type inner;
+        value_type factor;
+    };
+
+}// namespace task
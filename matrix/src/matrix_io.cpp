@@ -0,0 +1,379 @@
+#include "matrix_io.h"
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace task;
+
+namespace {
+
+    const size_t TEXT_BUFFER = 1 << 16;
+
+    MatrixFileHeader makeHeader(size_t rows, size_t cols, uint32_t dtype) {
+        MatrixFileHeader header = {};
+        std::memcpy(header.magic, "TMAT", 4);
+        header.version = MATRIX_FILE_VERSION;
+        header.dtype = dtype;
+        header.alignment = sizeof(MatrixFileHeader);
+        header.rows = rows;
+        header.cols = cols;
+        header.payloadOffset = sizeof(MatrixFileHeader);
+        return header;
+    }
+
+    // Checks a header read from a file of fileSize bytes and returns its payload size in bytes.
+    // The payload has to start after the header, aligned for T, and fit in the file; sizes are
+    // compared by dividing the room left down, so no product can wrap.
+    template<class T>
+    size_t checkHeader(const MatrixFileHeader &header, uint64_t fileSize) {
+        if (std::memcmp(header.magic, "TMAT", 4) != 0 || header.version != MATRIX_FILE_VERSION ||
+            header.dtype != MatrixDtype<T>::value || header.payloadOffset < sizeof(MatrixFileHeader) ||
+            header.payloadOffset % alignof(T) != 0 || header.payloadOffset > fileSize) {
+            throw MatrixIOException();
+        }
+        uint64_t capacity = (fileSize - header.payloadOffset) / sizeof(T);
+        if (header.cols != 0 && header.rows > capacity / header.cols) {
+            throw MatrixIOException();
+        }
+        return size_t(header.rows * header.cols * sizeof(T));
+    }
+
+    // Bytes from the current position to the end of input, or UINT64_MAX when it cannot seek; a
+    // pipe is then only bounded by the overflow checks.
+    uint64_t remainingBytes(std::istream &input) {
+        std::istream::pos_type position = input.tellg();
+        if (position == std::istream::pos_type(-1) || !input.seekg(0, std::ios::end)) {
+            input.clear();
+            return UINT64_MAX;
+        }
+        std::istream::pos_type end = input.tellg();
+        input.seekg(position);
+        if (end == std::istream::pos_type(-1) || !input) {
+            throw MatrixIOException();
+        }
+        return uint64_t(end - position);
+    }
+
+    const char *skipSpaces(const char *begin, const char *end) {
+        while (begin != end && (*begin == ' ' || *begin == '\n' || *begin == '\t' || *begin == '\r')) {
+            ++begin;
+        }
+        return begin;
+    }
+
+    template<class T>
+    const char *parseValue(const char *begin, const char *end, T &value) {
+        begin = skipSpaces(begin, end);
+        auto result = std::from_chars(begin, end, value);
+        if (result.ec != std::errc()) {
+            throw MatrixIOException();
+        }
+        return result.ptr;
+    }
+
+    std::string readFile(const std::string &path) {
+        std::ifstream input(path, std::ios::binary | std::ios::ate);
+        if (!input) {
+            throw MatrixIOException();
+        }
+        std::string content(size_t(input.tellg()), '\0');
+        input.seekg(0);
+        if (!input.read(&content[0], std::streamsize(content.size()))) {
+            throw MatrixIOException();
+        }
+        return content;
+    }
+
+}// namespace
+
+template<class T>
+void task::writeBinary(std::ostream &output, const BasicMatrix<T> &matrix) {
+    MatrixFileHeader header = makeHeader(matrix.getRow(), matrix.getCol(), MatrixDtype<T>::value);
+    output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    output.write(reinterpret_cast<const char *>(matrix.data()),
+                 std::streamsize(matrix.getRow() * matrix.getCol() * sizeof(T)));
+    if (!output) {
+        throw MatrixIOException();
+    }
+}
+
+template<class T>
+BasicMatrix<T> task::readBinary(std::istream &input) {
+    MatrixFileHeader header;
+    if (!input.read(reinterpret_cast<char *>(&header), sizeof(header))) {
+        throw MatrixIOException();
+    }
+    uint64_t remaining = remainingBytes(input);
+    size_t payload = checkHeader<T>(header, remaining == UINT64_MAX ? UINT64_MAX : remaining + sizeof(header));
+    input.ignore(std::streamsize(header.payloadOffset - sizeof(header)));
+    BasicMatrix<T> matrix(header.rows, header.cols);
+    input.read(reinterpret_cast<char *>(matrix.data()), std::streamsize(payload));
+    if (!input) {
+        throw MatrixIOException();
+    }
+    return matrix;
+}
+
+template<class T>
+void task::saveBinary(const std::string &path, const BasicMatrix<T> &matrix) {
+    BasicMatrixWriter<T> writer(path, matrix.getRow(), matrix.getCol());
+    writer.writeRows(matrix.data(), matrix.getRow());
+    writer.close();
+}
+
+template<class T>
+BasicMatrix<T> task::loadBinary(const std::string &path) {
+    std::ifstream input(path, std::ios::binary);
+    if (!input) {
+        throw MatrixIOException();
+    }
+    return readBinary<T>(input);
+}
+
+template<class T>
+BasicMatrixWriter<T>::BasicMatrixWriter(const std::string &path, size_t rows, size_t cols)
+    : output(path, std::ios::binary | std::ios::trunc), rows(rows), cols(cols) {
+    MatrixFileHeader header = makeHeader(rows, cols, MatrixDtype<T>::value);
+    output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    if (!output) {
+        throw MatrixIOException();
+    }
+}
+
+template<class T>
+BasicMatrixWriter<T>::~BasicMatrixWriter() {
+    if (output.is_open()) {
+        output.close();
+    }
+}
+
+template<class T>
+void BasicMatrixWriter<T>::writeRows(const T *values, size_t count) {
+    if (written + count > rows) {
+        throw SizeMismatchException();
+    }
+    output.write(reinterpret_cast<const char *>(values), std::streamsize(count * cols * sizeof(T)));
+    if (!output) {
+        throw MatrixIOException();
+    }
+    written += count;
+}
+
+template<class T>
+void BasicMatrixWriter<T>::writeRow(const std::vector<T> &values) {
+    if (values.size() != cols) {
+        throw SizeMismatchException();
+    }
+    writeRows(values.data(), 1);
+}
+
+template<class T>
+void BasicMatrixWriter<T>::close() {
+    if (written != rows) {
+        throw SizeMismatchException();
+    }
+    output.close();
+    if (!output) {
+        throw MatrixIOException();
+    }
+}
+
+template<class T>
+BasicMappedMatrix<T>::BasicMappedMatrix(const std::string &path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw MatrixIOException();
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || size_t(info.st_size) < sizeof(MatrixFileHeader)) {
+        ::close(fd);
+        throw MatrixIOException();
+    }
+    mappingSize = size_t(info.st_size);
+    mapping = ::mmap(nullptr, mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        throw MatrixIOException();
+    }
+
+    MatrixFileHeader header;
+    std::memcpy(&header, mapping, sizeof(header));
+    try {
+        checkHeader<T>(header, mappingSize);
+    } catch (...) {
+        unmap();
+        throw;
+    }
+    row = header.rows;
+    col = header.cols;
+    values = reinterpret_cast<const T *>(static_cast<const char *>(mapping) + header.payloadOffset);
+}
+
+template<class T>
+BasicMappedMatrix<T>::~BasicMappedMatrix() {
+    unmap();
+}
+
+template<class T>
+BasicMappedMatrix<T>::BasicMappedMatrix(BasicMappedMatrix &&other) noexcept
+    : mapping(other.mapping), mappingSize(other.mappingSize), values(other.values), row(other.row), col(other.col) {
+    other.mapping = nullptr;
+    other.values = nullptr;
+    other.row = other.col = other.mappingSize = 0;
+}
+
+template<class T>
+BasicMappedMatrix<T> &BasicMappedMatrix<T>::operator=(BasicMappedMatrix &&other) noexcept {
+    if (&other != this) {
+        unmap();
+        std::swap(mapping, other.mapping);
+        std::swap(mappingSize, other.mappingSize);
+        std::swap(values, other.values);
+        std::swap(row, other.row);
+        std::swap(col, other.col);
+    }
+    return *this;
+}
+
+template<class T>
+void BasicMappedMatrix<T>::unmap() {
+    if (mapping != nullptr) {
+        ::munmap(mapping, mappingSize);
+        mapping = nullptr;
+    }
+    values = nullptr;
+    row = col = mappingSize = 0;
+}
+
+template<class T>
+size_t BasicMappedMatrix<T>::getRow() const {
+    return row;
+}
+
+template<class T>
+size_t BasicMappedMatrix<T>::getCol() const {
+    return col;
+}
+
+template<class T>
+const T *BasicMappedMatrix<T>::data() const {
+    return values;
+}
+
+template<class T>
+const T &BasicMappedMatrix<T>::get(size_t n, size_t m) const {
+    if (n >= row || m >= col) {
+        throw OutOfBoundsException();
+    }
+    return values[n * col + m];
+}
+
+template<class T>
+BasicMatrix<T> BasicMappedMatrix<T>::toMatrix() const {
+    return BasicMatrix<T>(*this);
+}
+
+const char *task::parseText(const char *begin, const char *end, Matrix &matrix) {
+    size_t n, m;
+    begin = parseValue(begin, end, n);
+    begin = parseValue(begin, end, m);
+    if (matrix.getRow() != n || matrix.getCol() != m) {
+        Matrix temp(n, m);
+        matrix.swap(temp);
+    }
+    double *values = matrix.data();
+    for (size_t i = 0; i < n * m; ++i) {
+        begin = parseValue(begin, end, values[i]);
+    }
+    return begin;
+}
+
+Matrix task::loadText(const std::string &path) {
+    std::string content = readFile(path);
+    Matrix matrix;
+    parseText(content.data(), content.data() + content.size(), matrix);
+    return matrix;
+}
+
+SparseMatrix task::loadSparseText(const std::string &path) {
+    std::string content = readFile(path);
+    const char *begin = content.data(), *end = content.data() + content.size();
+    size_t n, m;
+    begin = parseValue(begin, end, n);
+    begin = parseValue(begin, end, m);
+    std::vector<size_t> starts(n + 1, 0), columns;
+    std::vector<double> values;
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < m; ++j) {
+            double value;
+            begin = parseValue(begin, end, value);
+            if (value != 0) {
+                columns.push_back(j);
+                values.push_back(value);
+            }
+        }
+        starts[i + 1] = columns.size();
+    }
+    return SparseMatrix(n, m, std::move(starts), std::move(columns), std::move(values));
+}
+
+void task::writeText(std::ostream &output, const Matrix &matrix) {
+    std::vector<char> buffer(TEXT_BUFFER);
+    char *pos = buffer.data();
+    char *end = buffer.data() + buffer.size();
+    auto flush = [&] {
+        output.write(buffer.data(), pos - buffer.data());
+        pos = buffer.data();
+    };
+
+    pos = std::to_chars(pos, end, matrix.getRow()).ptr;
+    *pos++ = ' ';
+    pos = std::to_chars(pos, end, matrix.getCol()).ptr;
+    *pos++ = '\n';
+    const double *values = matrix.data();
+    for (size_t i = 0; i < matrix.getRow(); ++i) {
+        for (size_t j = 0; j < matrix.getCol(); ++j) {
+            // 32 bytes hold any shortest double representation plus the separator.
+            if (end - pos < 32) {
+                flush();
+            }
+            pos = std::to_chars(pos, end, values[i * matrix.getCol() + j]).ptr;
+            *pos++ = ' ';
+        }
+        if (end - pos < 1) {
+            flush();
+        }
+        *pos++ = '\n';
+    }
+    flush();
+    if (!output) {
+        throw MatrixIOException();
+    }
+}
+
+void task::saveText(const std::string &path, const Matrix &matrix) {
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    if (!output) {
+        throw MatrixIOException();
+    }
+    writeText(output, matrix);
+}
+
+#define MATRIX_IO_INSTANTIATE(T)                                                    \
+    template void task::writeBinary(std::ostream &, const BasicMatrix<T> &);         \
+    template BasicMatrix<T> task::readBinary(std::istream &);                        \
+    template void task::saveBinary(const std::string &, const BasicMatrix<T> &);     \
+    template BasicMatrix<T> task::loadBinary(const std::string &);                   \
+    template class task::BasicMatrixWriter<T>;                                       \
+    template class task::BasicMappedMatrix<T>;
+
+MATRIX_IO_INSTANTIATE(float)
+MATRIX_IO_INSTANTIATE(double)
+MATRIX_IO_INSTANTIATE(int64_t)
+MATRIX_IO_INSTANTIATE(std::complex<double>)
@@ -0,0 +1,173 @@
+#pragma once
+
+#include "matrix.h"
+#include "sparse_matrix.h"
+
+#include <complex>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+
+namespace task {
+
+    class MatrixIOException : public std::exception {};
+
+    // Binary layout: a 64-byte header followed by the row-major payload in native byte order.
+    struct MatrixFileHeader {
+        char magic[4];
+        uint32_t version;
+        uint32_t dtype;
+        uint32_t alignment;
+        uint64_t rows;
+        uint64_t cols;
+        uint64_t payloadOffset;
+        char reserved[24];
+    };
+
+    static_assert(sizeof(MatrixFileHeader) == 64, "matrix file header must stay 64 bytes");
+
+    const uint32_t MATRIX_FILE_VERSION = 1;
+    const uint32_t MATRIX_DTYPE_FLOAT64 = 1;
+    const uint32_t MATRIX_DTYPE_FLOAT32 = 2;
+    const uint32_t MATRIX_DTYPE_INT64 = 3;
+    const uint32_t MATRIX_DTYPE_COMPLEX128 = 4;
+
+    template<class T>
+    struct MatrixDtype;
+
+    template<>
+    struct MatrixDtype<float> {
+        static constexpr uint32_t value = MATRIX_DTYPE_FLOAT32;
+    };
+
+    template<>
+    struct MatrixDtype<double> {
+        static constexpr uint32_t value = MATRIX_DTYPE_FLOAT64;
+    };
+
+    template<>
+    struct MatrixDtype<int64_t> {
+        static constexpr uint32_t value = MATRIX_DTYPE_INT64;
+    };
+
+    template<>
+    struct MatrixDtype<std::complex<double>> {
+        static constexpr uint32_t value = MATRIX_DTYPE_COMPLEX128;
+    };
+
+    // Reading a file whose dtype differs from T throws MatrixIOException.
+    template<class T>
+    void writeBinary(std::ostream &output, const BasicMatrix<T> &matrix);
+
+    template<class T = double>
+    BasicMatrix<T> readBinary(std::istream &input);
+
+    template<class T>
+    void saveBinary(const std::string &path, const BasicMatrix<T> &matrix);
+
+    template<class T = double>
+    BasicMatrix<T> loadBinary(const std::string &path);
+
+
+    // Writes a binary matrix file row by row without holding the whole matrix in memory.
+    template<class T>
+    class BasicMatrixWriter {
+    public:
+        BasicMatrixWriter(const std::string &path, size_t rows, size_t cols);
+
+        ~BasicMatrixWriter();
+
+        BasicMatrixWriter(const BasicMatrixWriter &) = delete;
+
+        BasicMatrixWriter &operator=(const BasicMatrixWriter &) = delete;
+
+        void writeRows(const T *values, size_t count);
+
+        void writeRow(const std::vector<T> &values);
+
+        // Throws MatrixIOException unless exactly rows rows were written.
+        void close();
+
+    private:
+        std::ofstream output;
+        size_t rows, cols;
+        size_t written = 0;
+    };
+
+    using MatrixWriter = BasicMatrixWriter<double>;
+
+
+    // Read-only, zero-copy view of a binary matrix file mapped into memory.
+    template<class T>
+    class BasicMappedMatrix : public MatrixExpr<BasicMappedMatrix<T>> {
+    public:
+        using value_type = T;
+
+        explicit BasicMappedMatrix(const std::string &path);
+
+        ~BasicMappedMatrix();
+
+        BasicMappedMatrix(const BasicMappedMatrix &) = delete;
+
+        BasicMappedMatrix &operator=(const BasicMappedMatrix &) = delete;
+
+        BasicMappedMatrix(BasicMappedMatrix &&other) noexcept;
+
+        BasicMappedMatrix &operator=(BasicMappedMatrix &&other) noexcept;
+
+        size_t getRow() const;
+
+        size_t getCol() const;
+
+        const T *data() const;
+
+        const T *operator[](size_t n) const {
+            return values + n * col;
+        }
+
+        const T &get(size_t row, size_t col) const;
+
+        BasicMatrix<T> toMatrix() const;
+
+        const T *span(size_t i, size_t j, size_t, T *) const {
+            return values + i * col + j;
+        }
+
+        template<class M>
+        bool refersTo(const M &) const {
+            return false;
+        }
+
+    private:
+        void *mapping = nullptr;
+        size_t mappingSize = 0;
+        const T *values = nullptr;
+        size_t row = 0, col = 0;
+
+        void unmap();
+    };
+
+    using MappedMatrix = BasicMappedMatrix<double>;
+
+    template<class T>
+    struct ExprOperand<BasicMappedMatrix<T>> {
+        using type = const BasicMappedMatrix<T> &;
+    };
+
+
+    // Fast paths for the double text format of operator>> and operator<<: "rows cols" followed by the values.
+    const char *parseText(const char *begin, const char *end, Matrix &matrix);
+
+    Matrix loadText(const std::string &path);
+
+    // Reads the same format straight into CSR form, without a dense intermediate.
+    SparseMatrix loadSparseText(const std::string &path);
+
+    // Writes the dimensions line read by operator>>, then one row per line with the shortest
+    // representation that parses back to the same double.
+    void writeText(std::ostream &output, const Matrix &matrix);
+
+    void saveText(const std::string &path, const Matrix &matrix);
+
+}// namespace task
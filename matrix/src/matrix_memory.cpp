@@ -0,0 +1,147 @@
+#include "matrix_memory.h"
+#include "matrix.h"
+
+#include <atomic>
+
+using namespace task;
+
+namespace {
+
+    // Constant-initialized, so matrices with static storage can be built before this file's initializers run.
+    std::atomic<std::pmr::memory_resource *> currentResource{nullptr};
+
+    const size_t MIN_CLASS_BITS = 6;
+    const size_t CLASS_STEPS = 4;
+
+    // Class 0 is 2^MIN_CLASS_BITS bytes, then four evenly spaced sizes up to each next power of two.
+    constexpr size_t sizeClass(size_t bytes) {
+        if (bytes <= (size_t(1) << MIN_CLASS_BITS)) {
+            return 0;
+        }
+        size_t e = 63 - __builtin_clzll(bytes - 1);
+        size_t step = size_t(1) << (e - 2);
+        size_t q = (bytes - (size_t(1) << e) + step - 1) / step;
+        return (e - MIN_CLASS_BITS) * CLASS_STEPS + q;
+    }
+
+    constexpr size_t classBytes(size_t index) {
+        if (index == 0) {
+            return size_t(1) << MIN_CLASS_BITS;
+        }
+        size_t e = MIN_CLASS_BITS + (index - 1) / CLASS_STEPS;
+        return (size_t(1) << e) + ((index - 1) % CLASS_STEPS + 1) * (size_t(1) << (e - 2));
+    }
+
+    constexpr size_t CLASS_COUNT = sizeClass(MATRIX_POOL_LIMIT) + 1;
+
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+
+    // Trivially destructible, so it stays usable while other thread-local and static objects are
+    // destroyed; the guard below empties and closes it first.
+    struct Cache {
+        FreeBlock *heads[CLASS_COUNT];
+        MatrixPoolStats stats;
+        bool closed;
+    };
+
+    void drain(Cache &cache) {
+        std::pmr::memory_resource *upstream = std::pmr::new_delete_resource();
+        for (size_t i = 0; i < CLASS_COUNT; ++i) {
+            while (FreeBlock *block = cache.heads[i]) {
+                cache.heads[i] = block->next;
+                upstream->deallocate(block, classBytes(i), ALIGNMENT);
+            }
+        }
+        cache.stats.cachedBytes = 0;
+    }
+
+    struct CacheGuard {
+        Cache &cache;
+
+        ~CacheGuard() {
+            drain(cache);
+            cache.closed = true;
+        }
+    };
+
+    Cache &threadCache() {
+        thread_local Cache cache{};
+        thread_local CacheGuard guard{cache};
+        return cache;
+    }
+
+    class PoolResource : public std::pmr::memory_resource {
+    private:
+        void *do_allocate(size_t bytes, size_t alignment) override {
+            Cache &cache = threadCache();
+            if (bytes > MATRIX_POOL_LIMIT || alignment > ALIGNMENT) {
+                return upstream()->allocate(bytes, alignment);
+            }
+            size_t index = sizeClass(bytes);
+            if (cache.closed) {
+                return upstream()->allocate(classBytes(index), ALIGNMENT);
+            }
+            ++cache.stats.allocations;
+            if (FreeBlock *block = cache.heads[index]) {
+                cache.heads[index] = block->next;
+                cache.stats.cachedBytes -= classBytes(index);
+                ++cache.stats.reused;
+                cache.stats.bytesReused += bytes;
+                return block;
+            }
+            return upstream()->allocate(classBytes(index), ALIGNMENT);
+        }
+
+        void do_deallocate(void *ptr, size_t bytes, size_t alignment) override {
+            Cache &cache = threadCache();
+            if (bytes > MATRIX_POOL_LIMIT || alignment > ALIGNMENT) {
+                upstream()->deallocate(ptr, bytes, alignment);
+                return;
+            }
+            size_t index = sizeClass(bytes), size = classBytes(index);
+            if (cache.closed || cache.stats.cachedBytes + size > MATRIX_POOL_LIMIT) {
+                upstream()->deallocate(ptr, size, ALIGNMENT);
+                return;
+            }
+            FreeBlock *block = static_cast<FreeBlock *>(ptr);
+            block->next = cache.heads[index];
+            cache.heads[index] = block;
+            cache.stats.cachedBytes += size;
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+            return this == &other;
+        }
+
+        static std::pmr::memory_resource *upstream() {
+            return std::pmr::new_delete_resource();
+        }
+    };
+
+}// namespace
+
+std::pmr::memory_resource *task::matrixResource() {
+    std::pmr::memory_resource *resource = currentResource.load(std::memory_order_relaxed);
+    return resource != nullptr ? resource : std::pmr::new_delete_resource();
+}
+
+std::pmr::memory_resource *task::setMatrixResource(std::pmr::memory_resource *resource) {
+    std::pmr::memory_resource *previous = currentResource.exchange(resource);
+    return previous != nullptr ? previous : std::pmr::new_delete_resource();
+}
+
+std::pmr::memory_resource *task::matrixPool() {
+    // Never destroyed: matrices with static storage may be freed after every destructor has run.
+    static PoolResource *pool = new PoolResource();
+    return pool;
+}
+
+MatrixPoolStats task::matrixPoolStats() {
+    return threadCache().stats;
+}
+
+void task::releaseMatrixPool() {
+    drain(threadCache());
+}
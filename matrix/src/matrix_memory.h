@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+
+namespace task {
+
+    // Buffers above this many bytes bypass the pool, and each thread keeps at most this many
+    // bytes of freed buffers for reuse.
+    const size_t MATRIX_POOL_LIMIT = size_t(1) << 28;
+
+    // Where matrices built without an explicit resource get their buffers: copies, results of
+    // operators and decompositions. Process-wide; std::pmr::new_delete_resource() until set.
+    std::pmr::memory_resource *matrixResource();
+
+    // Returns the previous resource; nullptr restores the default. The resource must outlive every
+    // matrix allocated from it.
+    std::pmr::memory_resource *setMatrixResource(std::pmr::memory_resource *resource);
+
+    struct MatrixPoolStats {
+        // Requests the pool has served on this thread, and how many of them got a cached buffer.
+        size_t allocations = 0;
+        size_t reused = 0;
+        size_t bytesReused = 0;
+        // Freed buffers this thread currently holds for reuse.
+        size_t cachedBytes = 0;
+    };
+
+    // A resource that recycles buffers by size class (four per power of two) through a cache owned
+    // by the calling thread, so no lock or shared counter is touched on the fast path. A buffer
+    // freed on another thread joins that thread's cache; caches go back upstream at thread exit.
+    // Lives for the whole program.
+    std::pmr::memory_resource *matrixPool();
+
+    MatrixPoolStats matrixPoolStats();
+
+    // Returns the calling thread's cached buffers upstream.
+    void releaseMatrixPool();
+
+}// namespace task
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "matrix.h"
+
+#include <cstddef>
+#include <type_traits>
+
+
+namespace task {
+
+    // Non-owning rows x cols window into row-major storage whose rows start stride elements apart.
+    // T is const-qualified for read-only views. Copying a view copies the reference; assigning to a
+    // view writes the viewed elements, which must have the same shape as the right-hand side.
+    template<class T>
+    class BasicMatrixView : public MatrixExpr<BasicMatrixView<T>> {
+    public:
+        using value_type = std::remove_const_t<T>;
+
+        BasicMatrixView(T *data, size_t rows, size_t cols, size_t stride);
+
+        BasicMatrixView(const BasicMatrixView &other) = default;
+
+        // Mutable views convert to read-only ones.
+        template<class U, class = std::enable_if_t<std::is_same<const U, T>::value>>
+        BasicMatrixView(const BasicMatrixView<U> &other);
+
+        size_t getRow() const;
+
+        size_t getCol() const;
+
+        size_t getStride() const;
+
+        T *data() const;
+
+        T *operator[](size_t n) const {
+            return values + n * stride;
+        }
+
+        T &get(size_t row, size_t col) const;
+
+        // Throws OutOfBoundsException unless the block lies inside this view.
+        BasicMatrixView block(size_t row, size_t col, size_t rows, size_t cols) const;
+
+        BasicRowView<T> rowView(size_t row) const;
+
+        BasicColView<T> colView(size_t col) const;
+
+        BasicMatrixView<const value_type> view() const;
+
+        BasicMatrix<value_type> toMatrix() const;
+
+        BasicMatrixView &operator=(const BasicMatrixView &other);
+
+        template<class E>
+        BasicMatrixView &operator=(const MatrixExpr<E> &expr);
+
+        template<class E>
+        BasicMatrixView &operator+=(const MatrixExpr<E> &expr);
+
+        template<class E>
+        BasicMatrixView &operator-=(const MatrixExpr<E> &expr);
+
+        BasicMatrixView &operator*=(const value_type &number);
+
+        const value_type *span(size_t i, size_t j, size_t, value_type *) const {
+            return values + i * stride + j;
+        }
+
+        template<class M>
+        bool refersTo(const M &matrix) const;
+
+    private:
+        T *values;
+        size_t row, col, stride;
+
+        template<class E, class Store>
+        void evaluate(const MatrixExpr<E> &expr, Store store);
+    };
+
+
+    // A single row; its elements are contiguous.
+    template<class T>
+    class BasicRowView : public BasicMatrixView<T> {
+    public:
+        BasicRowView(T *data, size_t size);
+
+        using BasicMatrixView<T>::operator=;
+
+        size_t size() const;
+
+        T &operator[](size_t k) const {
+            return this->data()[k];
+        }
+
+        T *begin() const;
+
+        T *end() const;
+    };
+
+
+    // A single column, one element every stride.
+    template<class T>
+    class BasicColView : public BasicMatrixView<T> {
+    public:
+        BasicColView(T *data, size_t size, size_t stride);
+
+        using BasicMatrixView<T>::operator=;
+
+        size_t size() const;
+
+        T &operator[](size_t k) const {
+            return this->data()[k * this->getStride()];
+        }
+    };
+
+    using MatrixView = BasicMatrixView<double>;
+    using ConstMatrixView = BasicMatrixView<const double>;
+    using RowView = BasicRowView<double>;
+    using ColView = BasicColView<double>;
+
+    template<class T>
+    size_t strideOf(const BasicMatrix<T> &matrix);
+
+    template<class T>
+    size_t strideOf(const BasicMatrixView<T> &view);
+
+    // Whether the elements of a and b may share memory: compares address ranges, so blocks side by
+    // side in the same rows count as overlapping.
+    template<class A, class B>
+    bool overlaps(const A &a, const B &b);
+
+    template<class T>
+    const BasicMatrixView<T> &evaluated(const MatrixExpr<BasicMatrixView<T>> &a);
+
+    template<class T>
+    BasicMatrix<T> multiply(const BasicMatrixView<const T> &a, const BasicMatrixView<const T> &b);
+
+    // c = a * b without allocating; c must not overlap a or b.
+    template<class T>
+    void multiply(const BasicMatrixView<const typename BasicMatrixView<T>::value_type> &a,
+                  const BasicMatrixView<const typename BasicMatrixView<T>::value_type> &b,
+                  const BasicMatrixView<T> &c);
+
+}// namespace task
+
+
+#include "matrix_view.tpp"
@@ -0,0 +1,199 @@
+#include <functional>
+
+namespace task {
+
+    template<class T>
+    BasicMatrixView<T>::BasicMatrixView(T *data, size_t rows, size_t cols, size_t stride)
+        : values(data), row(rows), col(cols), stride(stride) {}
+
+    template<class T>
+    template<class U, class>
+    BasicMatrixView<T>::BasicMatrixView(const BasicMatrixView<U> &other)
+        : values(other.data()), row(other.getRow()), col(other.getCol()), stride(other.getStride()) {}
+
+    template<class T>
+    size_t BasicMatrixView<T>::getRow() const {
+        return row;
+    }
+
+    template<class T>
+    size_t BasicMatrixView<T>::getCol() const {
+        return col;
+    }
+
+    template<class T>
+    size_t BasicMatrixView<T>::getStride() const {
+        return stride;
+    }
+
+    template<class T>
+    T *BasicMatrixView<T>::data() const {
+        return values;
+    }
+
+    template<class T>
+    T &BasicMatrixView<T>::get(size_t n, size_t m) const {
+        if (n >= row || m >= col) {
+            throw OutOfBoundsException();
+        }
+        return values[n * stride + m];
+    }
+
+    template<class T>
+    BasicMatrixView<T> BasicMatrixView<T>::block(size_t n, size_t m, size_t rows, size_t cols) const {
+        if (n + rows > row || m + cols > col) {
+            throw OutOfBoundsException();
+        }
+        return BasicMatrixView(values + n * stride + m, rows, cols, stride);
+    }
+
+    template<class T>
+    BasicRowView<T> BasicMatrixView<T>::rowView(size_t n) const {
+        if (n >= row) {
+            throw OutOfBoundsException();
+        }
+        return BasicRowView<T>(values + n * stride, col);
+    }
+
+    template<class T>
+    BasicColView<T> BasicMatrixView<T>::colView(size_t m) const {
+        if (m >= col) {
+            throw OutOfBoundsException();
+        }
+        return BasicColView<T>(values + m, row, stride);
+    }
+
+    template<class T>
+    BasicMatrixView<const typename BasicMatrixView<T>::value_type> BasicMatrixView<T>::view() const {
+        return *this;
+    }
+
+    template<class T>
+    BasicMatrix<typename BasicMatrixView<T>::value_type> BasicMatrixView<T>::toMatrix() const {
+        return BasicMatrix<value_type>(*this);
+    }
+
+    template<class T>
+    template<class E, class Store>
+    void BasicMatrixView<T>::evaluate(const MatrixExpr<E> &expr, Store store) {
+        checkSameSize(*this, expr);
+        if (expr.refersTo(*this)) {
+            // A shifted overlap can read elements this assignment has already written.
+            BasicMatrix<value_type> temp(expr);
+            evaluate(temp, store);
+            return;
+        }
+        const E &e = expr.self();
+        size_t grain = std::max<size_t>(1, PARALLEL_THRESHOLD / std::max<size_t>(col, 1));
+        parallelFor(row, grain, [&](size_t begin, size_t end) {
+            value_type buffer[EXPR_BLOCK];
+            for (size_t i = begin; i < end; ++i) {
+                for (size_t j = 0; j < col; j += EXPR_BLOCK) {
+                    size_t len = std::min(EXPR_BLOCK, col - j);
+                    store(values + i * stride + j, e.span(i, j, len, buffer), len);
+                }
+            }
+        });
+    }
+
+    template<class T>
+    BasicMatrixView<T> &BasicMatrixView<T>::operator=(const BasicMatrixView &other) {
+        return *this = static_cast<const MatrixExpr<BasicMatrixView> &>(other);
+    }
+
+    template<class T>
+    template<class E>
+    BasicMatrixView<T> &BasicMatrixView<T>::operator=(const MatrixExpr<E> &expr) {
+        evaluate(expr, [](value_type *dst, const value_type *src, size_t len) {
+            if (src != dst) {
+                std::copy_n(src, len, dst);
+            }
+        });
+        return *this;
+    }
+
+    template<class T>
+    template<class E>
+    BasicMatrixView<T> &BasicMatrixView<T>::operator+=(const MatrixExpr<E> &expr) {
+        evaluate(expr, [](value_type *dst, const value_type *src, size_t len) {
+            kernels<value_type>().add(dst, src, len);
+        });
+        return *this;
+    }
+
+    template<class T>
+    template<class E>
+    BasicMatrixView<T> &BasicMatrixView<T>::operator-=(const MatrixExpr<E> &expr) {
+        evaluate(expr, [](value_type *dst, const value_type *src, size_t len) {
+            kernels<value_type>().sub(dst, src, len);
+        });
+        return *this;
+    }
+
+    template<class T>
+    BasicMatrixView<T> &BasicMatrixView<T>::operator*=(const value_type &number) {
+        for (size_t i = 0; i < row; ++i) {
+            kernels<value_type>().scale(values + i * stride, number, col);
+        }
+        return *this;
+    }
+
+    template<class T>
+    template<class M>
+    bool BasicMatrixView<T>::refersTo(const M &matrix) const {
+        return overlaps(*this, matrix);
+    }
+
+    template<class T>
+    BasicRowView<T>::BasicRowView(T *data, size_t size) : BasicMatrixView<T>(data, 1, size, size) {}
+
+    template<class T>
+    size_t BasicRowView<T>::size() const {
+        return this->getCol();
+    }
+
+    template<class T>
+    T *BasicRowView<T>::begin() const {
+        return this->data();
+    }
+
+    template<class T>
+    T *BasicRowView<T>::end() const {
+        return this->data() + size();
+    }
+
+    template<class T>
+    BasicColView<T>::BasicColView(T *data, size_t size, size_t stride) : BasicMatrixView<T>(data, size, 1, stride) {}
+
+    template<class T>
+    size_t BasicColView<T>::size() const {
+        return this->getRow();
+    }
+
+    template<class T>
+    size_t strideOf(const BasicMatrix<T> &matrix) {
+        return matrix.getCol();
+    }
+
+    template<class T>
+    size_t strideOf(const BasicMatrixView<T> &view) {
+        return view.getStride();
+    }
+
+    template<class A, class B>
+    bool overlaps(const A &a, const B &b) {
+        if (a.getRow() == 0 || a.getCol() == 0 || b.getRow() == 0 || b.getCol() == 0) {
+            return false;
+        }
+        const void *aFirst = a.data(), *aLast = a.data() + (a.getRow() - 1) * strideOf(a) + a.getCol();
+        const void *bFirst = b.data(), *bLast = b.data() + (b.getRow() - 1) * strideOf(b) + b.getCol();
+        std::less<const void *> less;
+        return less(aFirst, bLast) && less(bFirst, aLast);
+    }
+
+    template<class T>
+    const BasicMatrixView<T> &evaluated(const MatrixExpr<BasicMatrixView<T>> &a) {
+        return a.self();
+    }
+
+}// namespace task
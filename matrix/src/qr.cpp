@@ -0,0 +1,196 @@
+#include "qr.h"
+#include "gemm.h"
+#include "kernels.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace task;
+
+template<class T>
+BasicQR<T>::BasicQR(const BasicMatrix<T> &a) : qr(a), tau(std::min(a.getRow(), a.getCol())) {
+    factorize();
+}
+
+template<class T>
+size_t BasicQR<T>::getRow() const {
+    return qr.getRow();
+}
+
+template<class T>
+size_t BasicQR<T>::getCol() const {
+    return qr.getCol();
+}
+
+template<class T>
+const BasicMatrix<T> &BasicQR<T>::factors() const {
+    return qr;
+}
+
+template<class T>
+void BasicQR<T>::factorize() {
+    size_t n = getCol(), k = tau.size();
+    CounterScope counter(Operation::FACTORIZE, 0, 2 * k * k * std::max(getRow(), n) - 2 * k * k * k / 3);
+    for (size_t j = 0; j < k; j += QR_BLOCK) {
+        size_t jb = std::min(QR_BLOCK, k - j);
+        factorizePanel(j, jb);
+        if (j + jb < n) {
+            applyBlock(j, jb, qr.data() + j + jb, n - j - jb, n, true);
+        }
+    }
+}
+
+template<class T>
+void BasicQR<T>::factorizePanel(size_t first, size_t width) {
+    using Real = decltype(std::abs(T()));
+    size_t m = getRow(), n = getCol();
+    T *a = qr.data();
+    const Kernels<T> &k = kernels<T>();
+    std::vector<T> w(width);
+    for (size_t c = first; c < first + width; ++c) {
+        // H^H (alpha, x) = (beta, 0) with H = I - tau v v^H and v = (1, x / (alpha - beta)).
+        T alpha = a[c * n + c];
+        Real norm = 0;
+        for (size_t r = c + 1; r < m; ++r) {
+            norm += std::norm(a[r * n + c]);
+        }
+        if (norm == Real(0) && std::imag(alpha) == Real(0)) {
+            tau[c] = T(0);
+            continue;
+        }
+        Real beta = std::sqrt(std::norm(alpha) + norm);
+        if (std::real(alpha) >= Real(0)) {
+            beta = -beta;
+        }
+        tau[c] = (T(beta) - alpha) / T(beta);
+        T scale = T(1) / (alpha - T(beta));
+        for (size_t r = c + 1; r < m; ++r) {
+            a[r * n + c] *= scale;
+        }
+        a[c * n + c] = T(beta);
+
+        size_t rest = first + width - c - 1;
+        if (rest == 0) {
+            continue;
+        }
+        std::copy_n(a + c * n + c + 1, rest, w.data());
+        for (size_t r = c + 1; r < m; ++r) {
+            k.axpy(w.data(), conjugate(a[r * n + c]), a + r * n + c + 1, rest);
+        }
+        T factor = -conjugate(tau[c]);
+        k.axpy(a + c * n + c + 1, factor, w.data(), rest);
+        for (size_t r = c + 1; r < m; ++r) {
+            k.axpy(a + r * n + c + 1, factor * a[r * n + c], w.data(), rest);
+        }
+    }
+}
+
+template<class T>
+void BasicQR<T>::applyBlock(size_t first, size_t width, T *c, size_t cols, size_t ldc, bool adjoint) const {
+    size_t m = getRow(), n = getCol(), rows = m - first;
+    const T *a = qr.data();
+    std::vector<T> v(rows * width), vh(width * rows);
+    for (size_t r = 0; r < rows; ++r) {
+        for (size_t i = 0; i < width; ++i) {
+            T x = r == i ? T(1) : r > i ? a[(first + r) * n + first + i] : T(0);
+            v[r * width + i] = x;
+            vh[i * rows + r] = conjugate(x);
+        }
+    }
+
+    // H_first ... H_last = I - V t V^H with upper triangular t, built column by column from V^H V.
+    std::vector<T> s(width * width), t(width * width, T(0));
+    gemm(width, width, rows, T(1), vh.data(), rows, v.data(), width, T(0), s.data(), width);
+    for (size_t i = 0; i < width; ++i) {
+        t[i * width + i] = tau[first + i];
+        for (size_t p = 0; p < i; ++p) {
+            T sum = T(0);
+            for (size_t q = p; q < i; ++q) {
+                sum += t[p * width + q] * s[q * width + i];
+            }
+            t[p * width + i] = -tau[first + i] * sum;
+        }
+    }
+    if (adjoint) {
+        for (size_t i = 0; i < width; ++i) {
+            for (size_t p = 0; p < i; ++p) {
+                t[i * width + p] = conjugate(t[p * width + i]);
+                t[p * width + i] = T(0);
+            }
+            t[i * width + i] = conjugate(t[i * width + i]);
+        }
+    }
+
+    std::vector<T> w(width * cols, T(0)), y(width * cols, T(0));
+    T *block = c + first * ldc;
+    gemm(width, cols, rows, T(1), vh.data(), rows, block, ldc, T(0), w.data(), cols);
+    gemm(width, cols, width, T(1), t.data(), width, w.data(), cols, T(0), y.data(), cols);
+    gemm(rows, cols, width, T(-1), v.data(), width, y.data(), cols, T(1), block, ldc);
+}
+
+template<class T>
+BasicMatrix<T> BasicQR<T>::q() const {
+    size_t k = tau.size();
+    BasicMatrix<T> result(getRow(), k);
+    for (size_t j = (k + QR_BLOCK - 1) / QR_BLOCK * QR_BLOCK; j > 0;) {
+        j -= QR_BLOCK;
+        applyBlock(j, std::min(QR_BLOCK, k - j), result.data(), k, k, false);
+    }
+    return result;
+}
+
+template<class T>
+BasicMatrix<T> BasicQR<T>::r() const {
+    size_t k = tau.size(), n = getCol();
+    BasicMatrix<T> result(k, n);
+    for (size_t i = 0; i < k; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            result[i][j] = j >= i ? qr[i][j] : T(0);
+        }
+    }
+    return result;
+}
+
+template<class T>
+void BasicQR<T>::solveInPlace(T *x, size_t cols) const {
+    size_t m = getRow(), n = getCol();
+    CounterScope counter(Operation::SOLVE, 0, (4 * m * n - n * n) * cols);
+    for (size_t j = 0; j < n; j += QR_BLOCK) {
+        applyBlock(j, std::min(QR_BLOCK, n - j), x, cols, cols, true);
+    }
+    const T *a = qr.data();
+    for (size_t i = 0; i < n; ++i) {
+        if (a[i * n + i] == T(0)) {
+            throw SingularMatrixException();
+        }
+    }
+    solveTriangular(false, false, n, cols, a, n, x, cols);
+}
+
+template<class T>
+BasicMatrix<T> BasicQR<T>::solve(const BasicMatrix<T> &b) const {
+    if (b.getRow() != getRow() || getRow() < getCol()) {
+        throw SizeMismatchException();
+    }
+    size_t cols = b.getCol();
+    BasicMatrix<T> y(b);
+    solveInPlace(y.data(), cols);
+    BasicMatrix<T> x(getCol(), cols);
+    std::copy_n(y.data(), getCol() * cols, x.data());
+    return x;
+}
+
+template<class T>
+std::vector<T> BasicQR<T>::solve(const std::vector<T> &b) const {
+    if (b.size() != getRow() || getRow() < getCol()) {
+        throw SizeMismatchException();
+    }
+    std::vector<T> y(b);
+    solveInPlace(y.data(), 1);
+    y.resize(getCol());
+    return y;
+}
+
+template class task::BasicQR<float>;
+template class task::BasicQR<double>;
+template class task::BasicQR<std::complex<double>>;
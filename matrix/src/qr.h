@@ -0,0 +1,60 @@
+#pragma once
+
+#include "matrix.h"
+
+#include <vector>
+
+
+namespace task {
+
+    const size_t QR_BLOCK = 32;
+
+    // A = QR by Householder reflections, QR_BLOCK columns at a time: every panel's reflectors are
+    // combined into one block reflector I - V T V^H and applied to the rest of A with gemm. R and
+    // the reflectors share one packed matrix, as in LAPACK geqrf, so the signs of R match numpy.
+    // Instantiated for float, double and std::complex<double>.
+    template<class T>
+    class BasicQR {
+    public:
+        explicit BasicQR(const BasicMatrix<T> &a);
+
+        size_t getRow() const;
+
+        size_t getCol() const;
+
+        // Reduced factors: Q is rows x k with orthonormal columns, R is k x cols upper triangular,
+        // k = min(rows, cols).
+        BasicMatrix<T> q() const;
+
+        BasicMatrix<T> r() const;
+
+        // Least-squares x minimizing |a x - b| for rows >= cols. Throws SingularMatrixException if
+        // a does not have full column rank.
+        BasicMatrix<T> solve(const BasicMatrix<T> &b) const;
+
+        std::vector<T> solve(const std::vector<T> &b) const;
+
+        const BasicMatrix<T> &factors() const;
+
+    private:
+        BasicMatrix<T> qr;
+        std::vector<T> tau;
+
+        void factorize();
+
+        void factorizePanel(size_t first, size_t width);
+
+        // c (rows x cols, rows stride ldc) := Q_j c or Q_j^H c for the block reflector of columns
+        // [first, first + width); only rows from first on change.
+        void applyBlock(size_t first, size_t width, T *c, size_t cols, size_t ldc, bool adjoint) const;
+
+        void solveInPlace(T *x, size_t cols) const;
+    };
+
+    using QR = BasicQR<double>;
+
+    extern template class BasicQR<float>;
+    extern template class BasicQR<double>;
+    extern template class BasicQR<std::complex<double>>;
+
+}// namespace task
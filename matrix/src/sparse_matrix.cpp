@@ -0,0 +1,424 @@
+#include "sparse_matrix.h"
+#include "kernels.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <complex>
+#include <cstdint>
+
+using namespace task;
+
+namespace {
+
+    const size_t NO_POSITION = size_t(-1);
+
+    // Rows per task so that every task touches about PARALLEL_THRESHOLD elements.
+    size_t rowGrain(size_t work, size_t rows) {
+        return std::max<size_t>(1, PARALLEL_THRESHOLD / std::max<size_t>(1, work / std::max<size_t>(1, rows)));
+    }
+
+}// namespace
+
+template<class T>
+SparseBuilder<T>::SparseBuilder(size_t rows, size_t cols) : row(rows), col(cols) {}
+
+template<class T>
+size_t SparseBuilder<T>::getRow() const {
+    return row;
+}
+
+template<class T>
+size_t SparseBuilder<T>::getCol() const {
+    return col;
+}
+
+template<class T>
+void SparseBuilder<T>::reserve(size_t nonZeros) {
+    entries.reserve(nonZeros);
+}
+
+template<class T>
+void SparseBuilder<T>::add(size_t n, size_t m, const T &value) {
+    if (n >= row || m >= col) {
+        throw OutOfBoundsException();
+    }
+    entries.push_back({n, m, value});
+}
+
+template<class T>
+CsrMatrix<T> SparseBuilder<T>::toCsr() const {
+    std::vector<Entry> sorted(entries);
+    std::sort(sorted.begin(), sorted.end(), [](const Entry &a, const Entry &b) {
+        return a.row < b.row || (a.row == b.row && a.col < b.col);
+    });
+    std::vector<size_t> starts(row + 1, 0), columns;
+    std::vector<T> values;
+    columns.reserve(sorted.size());
+    values.reserve(sorted.size());
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        if (i > 0 && sorted[i].row == sorted[i - 1].row && sorted[i].col == sorted[i - 1].col) {
+            values.back() += sorted[i].value;
+            continue;
+        }
+        ++starts[sorted[i].row + 1];
+        columns.push_back(sorted[i].col);
+        values.push_back(sorted[i].value);
+    }
+    for (size_t i = 0; i < row; ++i) {
+        starts[i + 1] += starts[i];
+    }
+    return CsrMatrix<T>(row, col, std::move(starts), std::move(columns), std::move(values));
+}
+
+template<class T>
+CsrMatrix<T>::CsrMatrix() : CsrMatrix(0, 0) {}
+
+template<class T>
+CsrMatrix<T>::CsrMatrix(size_t rows, size_t cols) : row(rows), col(cols), starts(rows + 1, 0) {}
+
+template<class T>
+CsrMatrix<T>::CsrMatrix(const BasicMatrix<T> &matrix) : CsrMatrix(matrix.getRow(), matrix.getCol()) {
+    const T *values = matrix.data();
+    for (size_t i = 0; i < row; ++i) {
+        for (size_t j = 0; j < col; ++j) {
+            if (values[i * col + j] != T(0)) {
+                indices.push_back(j);
+                elements.push_back(values[i * col + j]);
+            }
+        }
+        starts[i + 1] = indices.size();
+    }
+}
+
+template<class T>
+CsrMatrix<T>::CsrMatrix(size_t rows, size_t cols, std::vector<size_t> rowStart,
+                        std::vector<size_t> columns, std::vector<T> values)
+    : row(rows), col(cols), starts(std::move(rowStart)), indices(std::move(columns)), elements(std::move(values)) {
+    if (starts.size() != row + 1 || starts.front() != 0 || starts.back() != indices.size() ||
+        indices.size() != elements.size()) {
+        throw SizeMismatchException();
+    }
+    for (size_t i = 0; i < row; ++i) {
+        if (starts[i] > starts[i + 1]) {
+            throw SizeMismatchException();
+        }
+    }
+    for (size_t j : indices) {
+        if (j >= col) {
+            throw SizeMismatchException();
+        }
+    }
+}
+
+template<class T>
+size_t CsrMatrix<T>::getRow() const {
+    return row;
+}
+
+template<class T>
+size_t CsrMatrix<T>::getCol() const {
+    return col;
+}
+
+template<class T>
+size_t CsrMatrix<T>::nonZeros() const {
+    return elements.size();
+}
+
+template<class T>
+const std::vector<size_t> &CsrMatrix<T>::rowStart() const {
+    return starts;
+}
+
+template<class T>
+const std::vector<size_t> &CsrMatrix<T>::columns() const {
+    return indices;
+}
+
+template<class T>
+const std::vector<T> &CsrMatrix<T>::values() const {
+    return elements;
+}
+
+template<class T>
+T CsrMatrix<T>::get(size_t n, size_t m) const {
+    if (n >= row || m >= col) {
+        throw OutOfBoundsException();
+    }
+    auto first = indices.begin() + starts[n], last = indices.begin() + starts[n + 1];
+    auto it = std::lower_bound(first, last, m);
+    if (it == last || *it != m) {
+        return T(0);
+    }
+    return elements[it - indices.begin()];
+}
+
+template<class T>
+BasicMatrix<T> CsrMatrix<T>::toMatrix() const {
+    BasicMatrix<T> temp(row, col);
+    T *values = temp.data();
+    std::fill_n(values, row * col, T(0));
+    for (size_t i = 0; i < row; ++i) {
+        for (size_t p = starts[i]; p < starts[i + 1]; ++p) {
+            values[i * col + indices[p]] = elements[p];
+        }
+    }
+    return temp;
+}
+
+template<class T>
+CscMatrix<T> CsrMatrix<T>::toCsc() const {
+    return CscMatrix<T>(*this);
+}
+
+template<class T>
+CsrMatrix<T> CsrMatrix<T>::transposed() const {
+    CsrMatrix temp(col, row);
+    for (size_t j : indices) {
+        ++temp.starts[j + 1];
+    }
+    for (size_t j = 0; j < col; ++j) {
+        temp.starts[j + 1] += temp.starts[j];
+    }
+    temp.indices.resize(nonZeros());
+    temp.elements.resize(nonZeros());
+    std::vector<size_t> next(temp.starts.begin(), temp.starts.end() - 1);
+    for (size_t i = 0; i < row; ++i) {
+        for (size_t p = starts[i]; p < starts[i + 1]; ++p) {
+            size_t q = next[indices[p]]++;
+            temp.indices[q] = i;
+            temp.elements[q] = elements[p];
+        }
+    }
+    return temp;
+}
+
+template<class T>
+CscMatrix<T>::CscMatrix(const CsrMatrix<T> &matrix) : transpose(matrix.transposed()) {}
+
+template<class T>
+size_t CscMatrix<T>::getRow() const {
+    return transpose.getCol();
+}
+
+template<class T>
+size_t CscMatrix<T>::getCol() const {
+    return transpose.getRow();
+}
+
+template<class T>
+size_t CscMatrix<T>::nonZeros() const {
+    return transpose.nonZeros();
+}
+
+template<class T>
+const std::vector<size_t> &CscMatrix<T>::colStart() const {
+    return transpose.rowStart();
+}
+
+template<class T>
+const std::vector<size_t> &CscMatrix<T>::rows() const {
+    return transpose.columns();
+}
+
+template<class T>
+const std::vector<T> &CscMatrix<T>::values() const {
+    return transpose.values();
+}
+
+template<class T>
+T CscMatrix<T>::get(size_t row, size_t col) const {
+    return transpose.get(col, row);
+}
+
+template<class T>
+BasicMatrix<T> CscMatrix<T>::toMatrix() const {
+    return toCsr().toMatrix();
+}
+
+template<class T>
+CsrMatrix<T> CscMatrix<T>::toCsr() const {
+    return transpose.transposed();
+}
+
+template<class T>
+std::vector<T> task::multiply(const CsrMatrix<T> &a, const std::vector<T> &x) {
+    if (x.size() != a.getCol()) {
+        throw SizeMismatchException();
+    }
+    std::vector<T> y(a.getRow());
+    const size_t *starts = a.rowStart().data(), *columns = a.columns().data();
+    const T *values = a.values().data();
+    parallelFor(a.getRow(), rowGrain(a.nonZeros(), a.getRow()), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            T s = T(0);
+            for (size_t p = starts[i]; p < starts[i + 1]; ++p) {
+                s += values[p] * x[columns[p]];
+            }
+            y[i] = s;
+        }
+    });
+    return y;
+}
+
+template<class T>
+std::vector<T> task::multiply(const CscMatrix<T> &a, const std::vector<T> &x) {
+    if (x.size() != a.getCol()) {
+        throw SizeMismatchException();
+    }
+    std::vector<T> y(a.getRow(), T(0));
+    const size_t *starts = a.colStart().data(), *rows = a.rows().data();
+    const T *values = a.values().data();
+    for (size_t j = 0; j < a.getCol(); ++j) {
+        for (size_t p = starts[j]; p < starts[j + 1]; ++p) {
+            y[rows[p]] += values[p] * x[j];
+        }
+    }
+    return y;
+}
+
+template<class T>
+BasicMatrix<T> task::multiply(const CsrMatrix<T> &a, const BasicMatrix<T> &b) {
+    if (a.getCol() != b.getRow()) {
+        throw SizeMismatchException();
+    }
+    size_t n = b.getCol();
+    BasicMatrix<T> c(a.getRow(), n);
+    const size_t *starts = a.rowStart().data(), *columns = a.columns().data();
+    const T *values = a.values().data();
+    auto axpy = kernels<T>().axpy;
+    parallelFor(a.getRow(), rowGrain(a.nonZeros() * n, a.getRow()), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            T *row = c.data() + i * n;
+            std::fill_n(row, n, T(0));
+            for (size_t p = starts[i]; p < starts[i + 1]; ++p) {
+                axpy(row, values[p], b.data() + columns[p] * n, n);
+            }
+        }
+    });
+    return c;
+}
+
+template<class T>
+CsrMatrix<T> task::multiply(const CsrMatrix<T> &a, const CsrMatrix<T> &b) {
+    if (a.getCol() != b.getRow()) {
+        throw SizeMismatchException();
+    }
+    size_t rows = a.getRow(), cols = b.getCol();
+    const size_t *aStarts = a.rowStart().data(), *aColumns = a.columns().data();
+    const size_t *bStarts = b.rowStart().data(), *bColumns = b.columns().data();
+    const T *aValues = a.values().data(), *bValues = b.values().data();
+    size_t work = 0;
+    for (size_t p = 0; p < a.nonZeros(); ++p) {
+        work += bStarts[aColumns[p] + 1] - bStarts[aColumns[p]];
+    }
+    size_t grain = rowGrain(work, rows);
+
+    std::vector<size_t> starts(rows + 1, 0);
+    parallelFor(rows, grain, [&](size_t begin, size_t end) {
+        std::vector<size_t> lastRow(cols, NO_POSITION);
+        for (size_t i = begin; i < end; ++i) {
+            size_t count = 0;
+            for (size_t p = aStarts[i]; p < aStarts[i + 1]; ++p) {
+                size_t k = aColumns[p];
+                for (size_t q = bStarts[k]; q < bStarts[k + 1]; ++q) {
+                    if (lastRow[bColumns[q]] != i) {
+                        lastRow[bColumns[q]] = i;
+                        ++count;
+                    }
+                }
+            }
+            starts[i + 1] = count;
+        }
+    });
+    for (size_t i = 0; i < rows; ++i) {
+        starts[i + 1] += starts[i];
+    }
+
+    std::vector<size_t> columns(starts.back());
+    std::vector<T> values(starts.back());
+    parallelFor(rows, grain, [&](size_t begin, size_t end) {
+        std::vector<size_t> position(cols, NO_POSITION);
+        std::vector<std::pair<size_t, T>> row;
+        for (size_t i = begin; i < end; ++i) {
+            row.clear();
+            for (size_t p = aStarts[i]; p < aStarts[i + 1]; ++p) {
+                size_t k = aColumns[p];
+                for (size_t q = bStarts[k]; q < bStarts[k + 1]; ++q) {
+                    size_t j = bColumns[q];
+                    if (position[j] == NO_POSITION) {
+                        position[j] = row.size();
+                        row.emplace_back(j, aValues[p] * bValues[q]);
+                    } else {
+                        row[position[j]].second += aValues[p] * bValues[q];
+                    }
+                }
+            }
+            std::sort(row.begin(), row.end(), [](const std::pair<size_t, T> &x, const std::pair<size_t, T> &y) {
+                return x.first < y.first;
+            });
+            for (size_t r = 0; r < row.size(); ++r) {
+                columns[starts[i] + r] = row[r].first;
+                values[starts[i] + r] = row[r].second;
+                position[row[r].first] = NO_POSITION;
+            }
+        }
+    });
+    return CsrMatrix<T>(rows, cols, std::move(starts), std::move(columns), std::move(values));
+}
+
+template<class T>
+std::vector<T> task::operator*(const CsrMatrix<T> &a, const std::vector<T> &x) {
+    return multiply(a, x);
+}
+
+template<class T>
+BasicMatrix<T> task::operator*(const CsrMatrix<T> &a, const BasicMatrix<T> &b) {
+    return multiply(a, b);
+}
+
+template<class T>
+CsrMatrix<T> task::operator*(const CsrMatrix<T> &a, const CsrMatrix<T> &b) {
+    return multiply(a, b);
+}
+
+template<class T>
+std::istream &task::operator>>(std::istream &input, CsrMatrix<T> &matrix) {
+    size_t n, m;
+    input >> n >> m;
+    std::vector<size_t> starts(n + 1, 0), columns;
+    std::vector<T> values;
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < m; ++j) {
+            T value;
+            input >> value;
+            if (value != T(0)) {
+                columns.push_back(j);
+                values.push_back(value);
+            }
+        }
+        starts[i + 1] = columns.size();
+    }
+    if (input) {
+        matrix = CsrMatrix<T>(n, m, std::move(starts), std::move(columns), std::move(values));
+    }
+    return input;
+}
+
+#define SPARSE_INSTANTIATE(T)                                                                  \
+    template class task::SparseBuilder<T>;                                                     \
+    template class task::CsrMatrix<T>;                                                         \
+    template class task::CscMatrix<T>;                                                         \
+    template std::vector<T> task::multiply(const CsrMatrix<T> &, const std::vector<T> &);      \
+    template std::vector<T> task::multiply(const CscMatrix<T> &, const std::vector<T> &);      \
+    template BasicMatrix<T> task::multiply(const CsrMatrix<T> &, const BasicMatrix<T> &);      \
+    template CsrMatrix<T> task::multiply(const CsrMatrix<T> &, const CsrMatrix<T> &);          \
+    template std::vector<T> task::operator*(const CsrMatrix<T> &, const std::vector<T> &);     \
+    template BasicMatrix<T> task::operator*(const CsrMatrix<T> &, const BasicMatrix<T> &);     \
+    template CsrMatrix<T> task::operator*(const CsrMatrix<T> &, const CsrMatrix<T> &);         \
+    template std::istream &task::operator>>(std::istream &, CsrMatrix<T> &);
+
+SPARSE_INSTANTIATE(float)
+SPARSE_INSTANTIATE(double)
+SPARSE_INSTANTIATE(int64_t)
+SPARSE_INSTANTIATE(std::complex<double>)
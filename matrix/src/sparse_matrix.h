@@ -0,0 +1,154 @@
+#pragma once
+
+#include "matrix.h"
+
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+
+namespace task {
+
+    template<class T>
+    class CsrMatrix;
+
+    template<class T>
+    class CscMatrix;
+
+
+    // Coordinate-list builder; entries may come in any order and duplicates are summed.
+    template<class T>
+    class SparseBuilder {
+    public:
+        SparseBuilder(size_t rows, size_t cols);
+
+        size_t getRow() const;
+
+        size_t getCol() const;
+
+        void reserve(size_t nonZeros);
+
+        void add(size_t row, size_t col, const T &value);
+
+        CsrMatrix<T> toCsr() const;
+
+    private:
+        struct Entry {
+            size_t row, col;
+            T value;
+        };
+
+        size_t row, col;
+        std::vector<Entry> entries;
+    };
+
+
+    // Compressed sparse rows: the entries of row i are [rowStart()[i], rowStart()[i + 1]),
+    // with column indices sorted inside every row. Instantiated for the same types as BasicMatrix.
+    template<class T>
+    class CsrMatrix {
+    public:
+        CsrMatrix();
+
+        // All zero, unlike the identity built by Matrix(rows, cols).
+        CsrMatrix(size_t rows, size_t cols);
+
+        // Keeps the non-zero elements of matrix.
+        explicit CsrMatrix(const BasicMatrix<T> &matrix);
+
+        // Throws SizeMismatchException if the arrays are inconsistent with each other or with cols.
+        CsrMatrix(size_t rows, size_t cols, std::vector<size_t> rowStart,
+                  std::vector<size_t> columns, std::vector<T> values);
+
+        size_t getRow() const;
+
+        size_t getCol() const;
+
+        size_t nonZeros() const;
+
+        const std::vector<size_t> &rowStart() const;
+
+        const std::vector<size_t> &columns() const;
+
+        const std::vector<T> &values() const;
+
+        // Zero for elements that are not stored.
+        T get(size_t row, size_t col) const;
+
+        BasicMatrix<T> toMatrix() const;
+
+        CscMatrix<T> toCsc() const;
+
+        CsrMatrix transposed() const;
+
+    private:
+        size_t row, col;
+        std::vector<size_t> starts;
+        std::vector<size_t> indices;
+        std::vector<T> elements;
+
+        friend class CscMatrix<T>;
+    };
+
+
+    // Compressed sparse columns, the transpose layout of CsrMatrix.
+    template<class T>
+    class CscMatrix {
+    public:
+        explicit CscMatrix(const CsrMatrix<T> &matrix);
+
+        size_t getRow() const;
+
+        size_t getCol() const;
+
+        size_t nonZeros() const;
+
+        const std::vector<size_t> &colStart() const;
+
+        const std::vector<size_t> &rows() const;
+
+        const std::vector<T> &values() const;
+
+        T get(size_t row, size_t col) const;
+
+        BasicMatrix<T> toMatrix() const;
+
+        CsrMatrix<T> toCsr() const;
+
+    private:
+        // Stored as the CSR form of the transpose.
+        CsrMatrix<T> transpose;
+    };
+
+    using SparseMatrix = CsrMatrix<double>;
+
+
+    // Row-parallel y = A x.
+    template<class T>
+    std::vector<T> multiply(const CsrMatrix<T> &a, const std::vector<T> &x);
+
+    template<class T>
+    std::vector<T> multiply(const CscMatrix<T> &a, const std::vector<T> &x);
+
+    // Row-parallel C = A B for dense B.
+    template<class T>
+    BasicMatrix<T> multiply(const CsrMatrix<T> &a, const BasicMatrix<T> &b);
+
+    // Row-parallel Gustavson product: a symbolic pass sizes every row of C, a numeric pass fills it.
+    template<class T>
+    CsrMatrix<T> multiply(const CsrMatrix<T> &a, const CsrMatrix<T> &b);
+
+    template<class T>
+    std::vector<T> operator*(const CsrMatrix<T> &a, const std::vector<T> &x);
+
+    template<class T>
+    BasicMatrix<T> operator*(const CsrMatrix<T> &a, const BasicMatrix<T> &b);
+
+    template<class T>
+    CsrMatrix<T> operator*(const CsrMatrix<T> &a, const CsrMatrix<T> &b);
+
+    // Same text format as operator>> for Matrix; zeros are not stored.
+    template<class T>
+    std::istream &operator>>(std::istream &input, CsrMatrix<T> &matrix);
+
+}// namespace task
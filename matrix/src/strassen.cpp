@@ -0,0 +1,242 @@
+#include "strassen.h"
+#include "gemm.h"
+#include "kernels.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <memory>
+
+using namespace task;
+
+namespace {
+
+    bool isBase(size_t m, size_t n, size_t k, size_t crossover) {
+        return std::min({m, n, k}) <= std::max<size_t>(crossover, 1);
+    }
+
+    // Scratch of the sequential schedule: one m/2 x max(k/2, n/2) and one k/2 x n/2 temporary per level.
+    size_t sequentialScratch(size_t m, size_t n, size_t k, size_t crossover) {
+        if (isBase(m, n, k, crossover)) {
+            return 0;
+        }
+        m /= 2, n /= 2, k /= 2;
+        return m * std::max(k, n) + k * n + sequentialScratch(m, n, k, crossover);
+    }
+
+    // Z = X + Y or X - Y on rows x cols blocks; Z may be X or Y.
+    template<class T>
+    void combine(bool subtract, size_t rows, size_t cols, const T *x, size_t ldx, const T *y, size_t ldy,
+                 T *z, size_t ldz) {
+        size_t grain = std::max<size_t>(1, PARALLEL_THRESHOLD / std::max<size_t>(cols, 1));
+        parallelFor(rows, grain, [&](size_t begin, size_t end) {
+            const Kernels<T> &kern = kernels<T>();
+            for (size_t i = begin; i < end; ++i) {
+                const T *xi = x + i * ldx, *yi = y + i * ldy;
+                T *zi = z + i * ldz;
+                if (zi == yi) {
+                    if (subtract) {
+                        kern.scale(zi, T(-1), cols);
+                    }
+                    kern.add(zi, xi, cols);
+                    continue;
+                }
+                if (zi != xi) {
+                    std::copy_n(xi, cols, zi);
+                }
+                (subtract ? kern.sub : kern.add)(zi, yi, cols);
+            }
+        });
+    }
+
+    // Runs core(m / 2, n / 2, k / 2) on the even leading part and patches the odd row, column
+    // and inner index with gemm.
+    template<class T, class Core>
+    void peeled(size_t m, size_t n, size_t k, const T *a, size_t lda, const T *b, size_t ldb, T *c, size_t ldc,
+                Core core) {
+        size_t me = m & ~size_t(1), ne = n & ~size_t(1), ke = k & ~size_t(1);
+        core(me / 2, ne / 2, ke / 2);
+        if (k != ke) {
+            gemm(me, ne, size_t(1), T(1), a + ke, lda, b + ke * ldb, ldb, T(1), c, ldc);
+        }
+        if (n != ne) {
+            gemm(m, size_t(1), k, T(1), a, lda, b + ne, ldb, T(0), c + ne, ldc);
+        }
+        if (m != me) {
+            gemm(size_t(1), ne, k, T(1), a + me * lda, lda, b, ldb, T(0), c + me * ldc, ldc);
+        }
+    }
+
+    // The schedule of Boyer, Dumas, Pernet and Zhou, "Memory efficient scheduling of
+    // Strassen-Winograd's matrix multiplication algorithm" (2009): the products go straight into
+    // the quadrants of C and two temporaries hold everything else.
+    template<class T>
+    void sequential(size_t m, size_t n, size_t k, const T *a, size_t lda, const T *b, size_t ldb,
+                    T *c, size_t ldc, T *scratch, size_t crossover) {
+        if (isBase(m, n, k, crossover)) {
+            gemm(m, n, k, T(1), a, lda, b, ldb, T(0), c, ldc);
+            return;
+        }
+        peeled(m, n, k, a, lda, b, ldb, c, ldc, [&](size_t m2, size_t n2, size_t k2) {
+            const T *a11 = a, *a12 = a + k2, *a21 = a + m2 * lda, *a22 = a21 + k2;
+            const T *b11 = b, *b12 = b + n2, *b21 = b + k2 * ldb, *b22 = b21 + n2;
+            T *c11 = c, *c12 = c + n2, *c21 = c + m2 * ldc, *c22 = c21 + n2;
+            size_t ldx = std::max(k2, n2);
+            T *x = scratch, *y = x + m2 * ldx, *rest = y + k2 * n2;
+            auto product = [&](const T *p, size_t ldp, const T *q, size_t ldq, T *r, size_t ldr) {
+                sequential(m2, n2, k2, p, ldp, q, ldq, r, ldr, rest, crossover);
+            };
+
+            combine(true, m2, k2, a11, lda, a21, lda, x, ldx);   // S3 = A11 - A21
+            combine(true, k2, n2, b22, ldb, b12, ldb, y, n2);    // T3 = B22 - B12
+            product(x, ldx, y, n2, c21, ldc);                    // P7 = S3 T3
+            combine(false, m2, k2, a21, lda, a22, lda, x, ldx);  // S1 = A21 + A22
+            combine(true, k2, n2, b12, ldb, b11, ldb, y, n2);    // T1 = B12 - B11
+            product(x, ldx, y, n2, c22, ldc);                    // P5 = S1 T1
+            combine(true, k2, n2, b22, ldb, y, n2, y, n2);       // T2 = B22 - T1
+            combine(true, m2, k2, x, ldx, a11, lda, x, ldx);     // S2 = S1 - A11
+            product(x, ldx, y, n2, c12, ldc);                    // P6 = S2 T2
+            combine(true, m2, k2, a12, lda, x, ldx, x, ldx);     // S4 = A12 - S2
+            product(x, ldx, b22, ldb, c11, ldc);                 // P3 = S4 B22
+            product(a11, lda, b11, ldb, x, ldx);                 // P1 = A11 B11
+            combine(false, m2, n2, x, ldx, c12, ldc, c12, ldc);  // U2 = P1 + P6
+            combine(false, m2, n2, c12, ldc, c21, ldc, c21, ldc);// U3 = U2 + P7
+            combine(false, m2, n2, c12, ldc, c22, ldc, c12, ldc);// U4 = U2 + P5
+            combine(false, m2, n2, c21, ldc, c22, ldc, c22, ldc);// U7 = U3 + P5
+            combine(false, m2, n2, c12, ldc, c11, ldc, c12, ldc);// U5 = U4 + P3
+            combine(true, k2, n2, y, n2, b21, ldb, y, n2);       // T4 = T2 - B21
+            product(a22, lda, y, n2, c11, ldc);                  // P4 = A22 T4
+            combine(true, m2, n2, c21, ldc, c11, ldc, c21, ldc); // U6 = U3 - P4
+            product(a12, lda, b21, ldb, c11, ldc);               // P2 = A12 B21
+            combine(false, m2, n2, x, ldx, c11, ldc, c11, ldc);  // U1 = P1 + P2
+        });
+    }
+
+    // One level with all eight sums formed first and the seven products run concurrently,
+    // each recursing sequentially in its own share of the arena.
+    template<class T>
+    void parallel(size_t m, size_t n, size_t k, const T *a, size_t lda, const T *b, size_t ldb,
+                  T *c, size_t ldc, T *scratch, size_t crossover) {
+        if (isBase(m, n, k, crossover)) {
+            gemm(m, n, k, T(1), a, lda, b, ldb, T(0), c, ldc);
+            return;
+        }
+        peeled(m, n, k, a, lda, b, ldb, c, ldc, [&](size_t m2, size_t n2, size_t k2) {
+            const T *a11 = a, *a12 = a + k2, *a21 = a + m2 * lda, *a22 = a21 + k2;
+            const T *b11 = b, *b12 = b + n2, *b21 = b + k2 * ldb, *b22 = b21 + n2;
+            T *c11 = c, *c12 = c + n2, *c21 = c + m2 * ldc, *c22 = c21 + n2;
+            T *s = scratch, *t = s + 4 * m2 * k2, *p = t + 4 * k2 * n2, *rest = p + 3 * m2 * n2;
+            T *s1 = s, *s2 = s1 + m2 * k2, *s3 = s2 + m2 * k2, *s4 = s3 + m2 * k2;
+            T *t1 = t, *t2 = t1 + k2 * n2, *t3 = t2 + k2 * n2, *t4 = t3 + k2 * n2;
+            T *p2 = p, *p6 = p2 + m2 * n2, *p7 = p6 + m2 * n2;
+
+            combine(false, m2, k2, a21, lda, a22, lda, s1, k2);
+            combine(true, m2, k2, s1, k2, a11, lda, s2, k2);
+            combine(true, m2, k2, a11, lda, a21, lda, s3, k2);
+            combine(true, m2, k2, a12, lda, s2, k2, s4, k2);
+            combine(true, k2, n2, b12, ldb, b11, ldb, t1, n2);
+            combine(true, k2, n2, b22, ldb, t1, n2, t2, n2);
+            combine(true, k2, n2, b22, ldb, b12, ldb, t3, n2);
+            combine(true, k2, n2, t2, n2, b21, ldb, t4, n2);
+
+            struct Product {
+                const T *p;
+                size_t ldp;
+                const T *q;
+                size_t ldq;
+                T *r;
+                size_t ldr;
+            };
+            const Product products[7] = {
+                    {a11, lda, b11, ldb, c11, ldc},// P1
+                    {a12, lda, b21, ldb, p2, n2},  // P2
+                    {s4, k2, b22, ldb, c12, ldc},  // P3
+                    {a22, lda, t4, n2, c21, ldc},  // P4
+                    {s1, k2, t1, n2, c22, ldc},    // P5
+                    {s2, k2, t2, n2, p6, n2},      // P6
+                    {s3, k2, t3, n2, p7, n2},      // P7
+            };
+            size_t share = sequentialScratch(m2, n2, k2, crossover);
+            parallelFor(7, 1, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    const Product &pr = products[i];
+                    sequential(m2, n2, k2, pr.p, pr.ldp, pr.q, pr.ldq, pr.r, pr.ldr, rest + i * share, crossover);
+                }
+            });
+
+            combine(false, m2, n2, p6, n2, c11, ldc, p6, n2);  // U2 = P1 + P6
+            combine(false, m2, n2, c11, ldc, p2, n2, c11, ldc);// U1 = P1 + P2
+            combine(false, m2, n2, p7, n2, p6, n2, p7, n2);    // U3 = U2 + P7
+            combine(false, m2, n2, p6, n2, c22, ldc, p6, n2);  // U4 = U2 + P5
+            combine(false, m2, n2, c12, ldc, p6, n2, c12, ldc);// U5 = U4 + P3
+            combine(true, m2, n2, p7, n2, c21, ldc, c21, ldc); // U6 = U3 - P4
+            combine(false, m2, n2, c22, ldc, p7, n2, c22, ldc);// U7 = U3 + P5
+        });
+    }
+
+    bool runsParallel() {
+        return executionPolicy() == ExecutionPolicy::PARALLEL && threadCount() > 1;
+    }
+
+}// namespace
+
+size_t task::strassenLevels(size_t m, size_t n, size_t k, size_t crossover) {
+    size_t levels = 0;
+    for (; !isBase(m, n, k, crossover); m /= 2, n /= 2, k /= 2) {
+        ++levels;
+    }
+    return levels;
+}
+
+size_t task::strassenScratch(size_t m, size_t n, size_t k, bool parallel, size_t crossover) {
+    if (!parallel || isBase(m, n, k, crossover)) {
+        return sequentialScratch(m, n, k, crossover);
+    }
+    size_t m2 = m / 2, n2 = n / 2, k2 = k / 2;
+    return 4 * m2 * k2 + 4 * k2 * n2 + 3 * m2 * n2 + 7 * sequentialScratch(m2, n2, k2, crossover);
+}
+
+double task::strassenErrorBound(size_t n, size_t crossover) {
+    size_t levels = strassenLevels(n, n, n, crossover);
+    if (levels == 0) {
+        return double(n);
+    }
+    double n0 = double(n >> levels);
+    return (n0 * n0 + 6 * n0) * std::pow(18., double(levels));
+}
+
+template<class T>
+void task::strassen(size_t m, size_t n, size_t k, const T *a, size_t lda, const T *b, size_t ldb,
+                    T *c, size_t ldc, size_t crossover) {
+    CounterScope counter(Operation::MULTIPLY, 0, 2 * m * n * k);
+    bool concurrent = runsParallel();
+    std::unique_ptr<T[]> arena(new T[strassenScratch(m, n, k, concurrent, crossover)]);
+    if (concurrent) {
+        parallel(m, n, k, a, lda, b, ldb, c, ldc, arena.get(), crossover);
+    } else {
+        sequential(m, n, k, a, lda, b, ldb, c, ldc, arena.get(), crossover);
+    }
+}
+
+template<class T>
+BasicMatrix<T> task::strassenMultiply(const BasicMatrix<T> &a, const BasicMatrix<T> &b, size_t crossover) {
+    if (a.getCol() != b.getRow()) {
+        throw SizeMismatchException();
+    }
+    size_t m = a.getRow(), n = b.getCol(), k = a.getCol();
+    BasicMatrix<T> temp(m, n);
+    strassen(m, n, k, a.data(), k, b.data(), n, temp.data(), n, crossover);
+    return temp;
+}
+
+#define STRASSEN_INSTANTIATE(T)                                                                      \
+    template void task::strassen(size_t, size_t, size_t, const T *, size_t, const T *, size_t, T *, \
+                                 size_t, size_t);                                                    \
+    template BasicMatrix<T> task::strassenMultiply(const BasicMatrix<T> &, const BasicMatrix<T> &, size_t);
+
+STRASSEN_INSTANTIATE(float)
+STRASSEN_INSTANTIATE(double)
+STRASSEN_INSTANTIATE(int64_t)
+STRASSEN_INSTANTIATE(std::complex<double>)
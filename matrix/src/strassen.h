@@ -0,0 +1,38 @@
+#pragma once
+
+#include "matrix.h"
+
+#include <cstddef>
+
+
+namespace task {
+
+    // Products with a dimension at or below this go to gemm, measured with bench/strassen.cpp.
+    const size_t STRASSEN_CROSSOVER = 512;
+
+    // C = A * B for row-major A (m x k), B (k x n), C (m x n) by Strassen-Winograd recursion:
+    // seven half-size products and fifteen block additions per level, down to products with a
+    // dimension at or below crossover, which go to gemm. Odd dimensions are peeled off and patched
+    // with gemm. Under the parallel policy the seven top-level products run concurrently.
+    // All temporaries come from one arena allocated up front, strassenScratch() elements.
+    // Instantiated for float, double, int64_t and std::complex<double>.
+    template<class T>
+    void strassen(size_t m, size_t n, size_t k, const T *a, size_t lda, const T *b, size_t ldb,
+                  T *c, size_t ldc, size_t crossover = STRASSEN_CROSSOVER);
+
+    template<class T>
+    BasicMatrix<T> strassenMultiply(const BasicMatrix<T> &a, const BasicMatrix<T> &b,
+                                    size_t crossover = STRASSEN_CROSSOVER);
+
+    size_t strassenLevels(size_t m, size_t n, size_t k, size_t crossover = STRASSEN_CROSSOVER);
+
+    size_t strassenScratch(size_t m, size_t n, size_t k, bool parallel, size_t crossover = STRASSEN_CROSSOVER);
+
+    // Accuracy against the classical product, whose error is bounded elementwise by n u |A| |B|:
+    // Strassen-Winograd is only stable normwise, max |C - fl(C)| <= bound u max |A| max |B| with
+    // bound = (n0^2 + 6 n0) 18^levels for n = 2^levels n0 (Higham, Accuracy and Stability of
+    // Numerical Algorithms, 23.2.2). Returns that bound for an n x n product, or n when it stays
+    // classical. Both are worst cases; bench/strassen.cpp prints the errors actually seen.
+    double strassenErrorBound(size_t n, size_t crossover = STRASSEN_CROSSOVER);
+
+}// namespace task
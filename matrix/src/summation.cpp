@@ -0,0 +1,349 @@
+#include "summation.h"
+#include "kernels.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define MATRIX_X86 1
+#include <immintrin.h>
+#endif
+
+// See the note above accumulate().
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+using namespace task;
+
+namespace {
+
+    std::atomic<Summation> currentMode{Summation::PLAIN};
+
+    // The kernels below are written once against these operation sets: V holds WIDTH running
+    // sums of type Acc, loaded from In values.
+    template<class I, class A>
+    struct ScalarOps {
+        using In = I;
+        using Acc = A;
+        using V = A;
+        static const size_t WIDTH = 1;
+
+        static V zero() { return A(0); }
+        static V load(const I *p) { return A(*p); }
+        static V add(V a, V b) { return a + b; }
+        static V sub(V a, V b) { return a - b; }
+        static V mul(V a, V b) { return a * b; }
+        static V fma(V a, V b, V c) { return std::fma(a, b, c); }
+        static V fms(V a, V b, V c) { return std::fma(a, b, -c); }
+        static void store(A *p, V v) { *p = v; }
+    };
+
+#ifdef MATRIX_X86
+#define AVX2_OPS __attribute__((target("avx2,fma"))) static inline
+#define AVX512_OPS __attribute__((target("avx512f,avx2,fma"))) static inline
+
+    struct Avx2Double {
+        using In = double;
+        using Acc = double;
+        using V = __m256d;
+        static const size_t WIDTH = 4;
+
+        AVX2_OPS V zero() { return _mm256_setzero_pd(); }
+        AVX2_OPS V load(const double *p) { return _mm256_loadu_pd(p); }
+        AVX2_OPS V add(V a, V b) { return _mm256_add_pd(a, b); }
+        AVX2_OPS V sub(V a, V b) { return _mm256_sub_pd(a, b); }
+        AVX2_OPS V mul(V a, V b) { return _mm256_mul_pd(a, b); }
+        AVX2_OPS V fma(V a, V b, V c) { return _mm256_fmadd_pd(a, b, c); }
+        AVX2_OPS V fms(V a, V b, V c) { return _mm256_fmsub_pd(a, b, c); }
+        AVX2_OPS void store(double *p, V v) { _mm256_storeu_pd(p, v); }
+    };
+
+    struct Avx2Float {
+        using In = float;
+        using Acc = float;
+        using V = __m256;
+        static const size_t WIDTH = 8;
+
+        AVX2_OPS V zero() { return _mm256_setzero_ps(); }
+        AVX2_OPS V load(const float *p) { return _mm256_loadu_ps(p); }
+        AVX2_OPS V add(V a, V b) { return _mm256_add_ps(a, b); }
+        AVX2_OPS V sub(V a, V b) { return _mm256_sub_ps(a, b); }
+        AVX2_OPS V mul(V a, V b) { return _mm256_mul_ps(a, b); }
+        AVX2_OPS V fma(V a, V b, V c) { return _mm256_fmadd_ps(a, b, c); }
+        AVX2_OPS V fms(V a, V b, V c) { return _mm256_fmsub_ps(a, b, c); }
+        AVX2_OPS void store(float *p, V v) { _mm256_storeu_ps(p, v); }
+    };
+
+    struct Avx2Wide : Avx2Double {
+        using In = float;
+
+        AVX2_OPS V load(const float *p) { return _mm256_cvtps_pd(_mm_loadu_ps(p)); }
+    };
+
+    struct Avx512Double {
+        using In = double;
+        using Acc = double;
+        using V = __m512d;
+        static const size_t WIDTH = 8;
+
+        AVX512_OPS V zero() { return _mm512_setzero_pd(); }
+        AVX512_OPS V load(const double *p) { return _mm512_loadu_pd(p); }
+        AVX512_OPS V add(V a, V b) { return _mm512_add_pd(a, b); }
+        AVX512_OPS V sub(V a, V b) { return _mm512_sub_pd(a, b); }
+        AVX512_OPS V mul(V a, V b) { return _mm512_mul_pd(a, b); }
+        AVX512_OPS V fma(V a, V b, V c) { return _mm512_fmadd_pd(a, b, c); }
+        AVX512_OPS V fms(V a, V b, V c) { return _mm512_fmsub_pd(a, b, c); }
+        AVX512_OPS void store(double *p, V v) { _mm512_storeu_pd(p, v); }
+    };
+
+    struct Avx512Float {
+        using In = float;
+        using Acc = float;
+        using V = __m512;
+        static const size_t WIDTH = 16;
+
+        AVX512_OPS V zero() { return _mm512_setzero_ps(); }
+        AVX512_OPS V load(const float *p) { return _mm512_loadu_ps(p); }
+        AVX512_OPS V add(V a, V b) { return _mm512_add_ps(a, b); }
+        AVX512_OPS V sub(V a, V b) { return _mm512_sub_ps(a, b); }
+        AVX512_OPS V mul(V a, V b) { return _mm512_mul_ps(a, b); }
+        AVX512_OPS V fma(V a, V b, V c) { return _mm512_fmadd_ps(a, b, c); }
+        AVX512_OPS V fms(V a, V b, V c) { return _mm512_fmsub_ps(a, b, c); }
+        AVX512_OPS void store(float *p, V v) { _mm512_storeu_ps(p, v); }
+    };
+
+    struct Avx512Wide : Avx512Double {
+        using In = float;
+
+        AVX512_OPS V load(const float *p) { return _mm512_cvtps_pd(_mm256_loadu_ps(p)); }
+    };
+
+#undef AVX2_OPS
+#undef AVX512_OPS
+#endif
+
+    // The templates below are always inlined into the per-target functions further down, so their
+    // vector arguments never cross an ABI boundary, whatever the optimization level: flatten alone
+    // does not inline at -O0, where the AVX paths then returned garbage.
+    template<class O, bool Dot>
+    __attribute__((always_inline)) inline void accumulate(typename O::V &s, const typename O::In *x,
+                                                          const typename O::In *y) {
+        s = Dot ? O::fma(O::load(x), O::load(y), s) : O::add(s, O::load(x));
+    }
+
+    template<class O>
+    __attribute__((always_inline)) inline typename O::Acc horizontal(const typename O::V &v) {
+        typename O::Acc lanes[O::WIDTH], result = 0;
+        O::store(lanes, v);
+        for (size_t l = 0; l < O::WIDTH; ++l) {
+            result += lanes[l];
+        }
+        return result;
+    }
+
+    // Four independent sums to hide the add latency.
+    template<class O, bool Dot>
+    __attribute__((always_inline)) inline typename O::Acc plainSum(const typename O::In *x, const typename O::In *y,
+                                                                   size_t n) {
+        using V = typename O::V;
+        using Acc = typename O::Acc;
+        const size_t W = O::WIDTH;
+        V s0 = O::zero(), s1 = O::zero(), s2 = O::zero(), s3 = O::zero();
+        size_t i = 0;
+        for (; i + 4 * W <= n; i += 4 * W) {
+            accumulate<O, Dot>(s0, x + i, y + i);
+            accumulate<O, Dot>(s1, x + i + W, y + i + W);
+            accumulate<O, Dot>(s2, x + i + 2 * W, y + i + 2 * W);
+            accumulate<O, Dot>(s3, x + i + 3 * W, y + i + 3 * W);
+        }
+        for (; i + W <= n; i += W) {
+            accumulate<O, Dot>(s0, x + i, y + i);
+        }
+        s0 = O::add(O::add(s0, s1), O::add(s2, s3));
+        Acc result = horizontal<O>(s0);
+        for (; i < n; ++i) {
+            result += Dot ? Acc(x[i]) * Acc(y[i]) : Acc(x[i]);
+        }
+        return result;
+    }
+
+    // Block sums merged like a binary counter, so every level adds two sums of equal length.
+    template<class O, bool Dot>
+    __attribute__((always_inline)) inline typename O::Acc pairwiseSum(const typename O::In *x, const typename O::In *y,
+                                                                      size_t n) {
+        using Acc = typename O::Acc;
+        Acc stack[64];
+        size_t depth = 0, blocks = 0;
+        for (size_t i = 0; i < n; i += SUM_BLOCK) {
+            size_t len = std::min(SUM_BLOCK, n - i);
+            Acc value = plainSum<O, Dot>(x + i, Dot ? y + i : y, len);
+            for (size_t count = ++blocks; count % 2 == 0; count /= 2) {
+                value = stack[--depth] + value;
+            }
+            stack[depth++] = value;
+        }
+        Acc result = 0;
+        while (depth > 0) {
+            result = stack[--depth] + result;
+        }
+        return result;
+    }
+
+    // s + value = sum + error exactly (Knuth's TwoSum); the error goes to the compensation c.
+    template<class O>
+    __attribute__((always_inline)) inline void twoSum(typename O::V &s, typename O::V &c, const typename O::V &value) {
+        typename O::V t = O::add(s, value), z = O::sub(t, s);
+        c = O::add(c, O::add(O::sub(s, O::sub(t, z)), O::sub(value, z)));
+        s = t;
+    }
+
+    template<class O, bool Dot>
+    __attribute__((always_inline)) inline void compensatedStep(typename O::V &s, typename O::V &c,
+                                                               const typename O::In *x, const typename O::In *y) {
+        if (Dot) {
+            typename O::V a = O::load(x), b = O::load(y), p = O::mul(a, b);
+            c = O::add(c, O::fms(a, b, p));
+            twoSum<O>(s, c, p);
+        } else {
+            twoSum<O>(s, c, O::load(x));
+        }
+    }
+
+    template<class O, bool Dot>
+    __attribute__((always_inline)) inline typename O::Acc compensatedSum(const typename O::In *x,
+                                                                         const typename O::In *y, size_t n) {
+        using Acc = typename O::Acc;
+        using Scalar = ScalarOps<Acc, Acc>;
+        const size_t W = O::WIDTH;
+        typename O::V s0 = O::zero(), s1 = O::zero(), c0 = O::zero(), c1 = O::zero();
+        size_t i = 0;
+        for (; i + 2 * W <= n; i += 2 * W) {
+            compensatedStep<O, Dot>(s0, c0, x + i, y + i);
+            compensatedStep<O, Dot>(s1, c1, x + i + W, y + i + W);
+        }
+        for (; i + W <= n; i += W) {
+            compensatedStep<O, Dot>(s0, c0, x + i, y + i);
+        }
+        c0 = O::add(c0, c1);
+        Acc lanes[2 * W], s = 0, c = horizontal<O>(c0);
+        O::store(lanes, s0);
+        O::store(lanes + W, s1);
+        for (size_t l = 0; l < 2 * W; ++l) {
+            twoSum<Scalar>(s, c, lanes[l]);
+        }
+        for (; i < n; ++i) {
+            Acc a = x[i], b = Dot ? Acc(y[i]) : Acc(1);
+            compensatedStep<Scalar, Dot>(s, c, &a, &b);
+        }
+        return s + c;
+    }
+
+    template<class O, class Wide, bool Dot>
+    __attribute__((always_inline)) inline typename O::In reduceWith(const typename O::In *x, const typename O::In *y,
+                                                                    size_t n, Summation mode) {
+        using T = typename O::In;
+        switch (mode) {
+            case Summation::PAIRWISE:
+                return pairwiseSum<O, Dot>(x, y, n);
+            case Summation::COMPENSATED:
+                return compensatedSum<O, Dot>(x, y, n);
+            case Summation::WIDE:
+                if (std::is_same<T, float>::value) {
+                    return T(plainSum<Wide, Dot>(x, y, n));
+                }
+                return compensatedSum<O, Dot>(x, y, n);
+            default:
+                return plainSum<O, Dot>(x, y, n);
+        }
+    }
+
+    template<bool Dot, class T>
+    T reduceScalar(const T *x, const T *y, size_t n, Summation mode) {
+        return reduceWith<ScalarOps<T, T>, ScalarOps<T, double>, Dot>(x, y, n, mode);
+    }
+
+#ifdef MATRIX_X86
+    template<bool Dot>
+    __attribute__((target("avx2,fma"), flatten)) double reduceAvx2(const double *x, const double *y, size_t n, Summation mode) {
+        return reduceWith<Avx2Double, Avx2Double, Dot>(x, y, n, mode);
+    }
+
+    template<bool Dot>
+    __attribute__((target("avx2,fma"), flatten)) float reduceAvx2(const float *x, const float *y, size_t n, Summation mode) {
+        return reduceWith<Avx2Float, Avx2Wide, Dot>(x, y, n, mode);
+    }
+
+    template<bool Dot>
+    __attribute__((target("avx512f,avx2,fma"), flatten)) double reduceAvx512(const double *x, const double *y, size_t n,
+                                                                     Summation mode) {
+        return reduceWith<Avx512Double, Avx512Double, Dot>(x, y, n, mode);
+    }
+
+    template<bool Dot>
+    __attribute__((target("avx512f,avx2,fma"), flatten)) float reduceAvx512(const float *x, const float *y, size_t n,
+                                                                    Summation mode) {
+        return reduceWith<Avx512Float, Avx512Wide, Dot>(x, y, n, mode);
+    }
+#endif
+
+    template<bool Dot, class T>
+    T reduce(const T *x, const T *y, size_t n, Summation mode) {
+#ifdef MATRIX_X86
+        switch (simdLevel()) {
+            case SimdLevel::AVX512:
+                return reduceAvx512<Dot>(x, y, n, mode);
+            case SimdLevel::AVX2:
+                return reduceAvx2<Dot>(x, y, n, mode);
+            default:
+                break;
+        }
+#endif
+        return reduceScalar<Dot>(x, y, n, mode);
+    }
+
+}// namespace
+
+void task::setSummation(Summation mode) {
+    currentMode = mode;
+}
+
+Summation task::summation() {
+    return currentMode;
+}
+
+const char *task::summationName(Summation mode) {
+    switch (mode) {
+        case Summation::PAIRWISE:
+            return "pairwise";
+        case Summation::COMPENSATED:
+            return "compensated";
+        case Summation::WIDE:
+            return "wide";
+        default:
+            return "plain";
+    }
+}
+
+template<class T>
+T task::sum(const T *x, size_t n, size_t stride, Summation mode) {
+    if (stride != 1) {
+        std::vector<T> packed(n);
+        for (size_t i = 0; i < n; ++i) {
+            packed[i] = x[i * stride];
+        }
+        return reduce<false>(packed.data(), packed.data(), n, mode);
+    }
+    return reduce<false>(x, x, n, mode);
+}
+
+template<class T>
+T task::dot(const T *x, const T *y, size_t n, Summation mode) {
+    return reduce<true>(x, y, n, mode);
+}
+
+template float task::sum(const float *, size_t, size_t, Summation);
+template double task::sum(const double *, size_t, size_t, Summation);
+template float task::dot(const float *, const float *, size_t, Summation);
+template double task::dot(const double *, const double *, size_t, Summation);
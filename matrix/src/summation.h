@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+
+
+namespace task {
+
+    enum class Summation {
+        // One running sum per vector lane, what the gemm micro-kernels do.
+        PLAIN,
+        // Plain sums of SUM_BLOCK elements, then the block sums added pairwise.
+        PAIRWISE,
+        // Neumaier/TwoSum per lane with the rounding error of every product kept through FMA
+        // (Ogita, Rump and Oishi's Dot2): as accurate as summing in twice the working precision.
+        COMPENSATED,
+        // float values accumulated in double, where products of two floats are exact.
+        // double has no wider hardware type and takes the COMPENSATED path.
+        WIDE
+    };
+
+    const size_t SUM_BLOCK = 128;
+
+    // Used by sum() and dot() by default, by trace(), and by gemm: with a mode other than PLAIN, float
+    // and double products are formed one dot product per element, so det() and the decompositions
+    // pick the mode up through their trailing updates. Process-wide; PLAIN until set.
+    void setSummation(Summation mode);
+
+    Summation summation();
+
+    const char *summationName(Summation mode);
+
+    // x[0] + x[stride] + ... + x[(n - 1) * stride], vectorized for stride 1.
+    // Instantiated for float and double.
+    template<class T>
+    T sum(const T *x, size_t n, size_t stride = 1, Summation mode = summation());
+
+    template<class T>
+    T dot(const T *x, const T *y, size_t n, Summation mode = summation());
+
+}// namespace task
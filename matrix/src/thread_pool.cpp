@@ -0,0 +1,182 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+
+using namespace task;
+
+namespace {
+
+    std::atomic<ExecutionPolicy> currentPolicy{ExecutionPolicy::SEQUENTIAL};
+
+    std::mutex poolMutex;
+    std::unique_ptr<ThreadPool> pool;
+    size_t requestedThreads = 0;
+
+    thread_local bool insidePool = false;
+
+    size_t resolveThreadCount(size_t count) {
+        if (count == 0) {
+            count = std::thread::hardware_concurrency();
+        }
+        return std::max<size_t>(count, 1);
+    }
+
+}// namespace
+
+void task::setExecutionPolicy(ExecutionPolicy policy) {
+    currentPolicy = policy;
+}
+
+ExecutionPolicy task::executionPolicy() {
+    return currentPolicy;
+}
+
+void task::setThreadCount(size_t count) {
+    std::lock_guard<std::mutex> lock(poolMutex);
+    requestedThreads = count;
+    pool.reset();
+}
+
+size_t task::threadCount() {
+    std::lock_guard<std::mutex> lock(poolMutex);
+    return resolveThreadCount(requestedThreads);
+}
+
+ThreadPool &task::threadPool() {
+    std::lock_guard<std::mutex> lock(poolMutex);
+    if (!pool) {
+        pool = std::make_unique<ThreadPool>(resolveThreadCount(requestedThreads));
+    }
+    return *pool;
+}
+
+ThreadPool::ThreadPool(size_t threads) {
+    threads = std::max<size_t>(threads, 1);
+    for (size_t i = 0; i < threads; ++i) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    for (size_t i = 1; i < threads; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
+
+size_t ThreadPool::size() const {
+    return queues.size();
+}
+
+void ThreadPool::run(size_t tasks, const std::function<void(size_t)> &task) {
+    if (insidePool || queues.size() == 1 || tasks <= 1) {
+        for (size_t i = 0; i < tasks; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> runLock(runMutex);
+    body = &task;
+    error = nullptr;
+    remaining = tasks;
+    size_t perQueue = (tasks + queues.size() - 1) / queues.size();
+    for (size_t q = 0; q < queues.size(); ++q) {
+        std::lock_guard<std::mutex> lock(queues[q]->mutex);
+        for (size_t i = q * perQueue; i < std::min(tasks, (q + 1) * perQueue); ++i) {
+            queues[q]->tasks.push_back(i);
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        ++generation;
+    }
+    wake.notify_all();
+
+    insidePool = true;
+    drain(0);
+    insidePool = false;
+
+    std::unique_lock<std::mutex> lock(stateMutex);
+    done.wait(lock, [this] { return remaining == 0; });
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    insidePool = true;
+    size_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(stateMutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+        }
+        drain(index);
+    }
+}
+
+bool ThreadPool::popTask(size_t index, size_t &task) {
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        if (!queues[index]->tasks.empty()) {
+            task = queues[index]->tasks.back();
+            queues[index]->tasks.pop_back();
+            return true;
+        }
+    }
+    for (size_t offset = 1; offset < queues.size(); ++offset) {
+        Queue &victim = *queues[(index + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::drain(size_t index) {
+    size_t task;
+    while (popTask(index, task)) {
+        try {
+            (*body)(task);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+        if (--remaining == 0) {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            done.notify_all();
+        }
+    }
+}
+
+void task::parallelFor(size_t n, size_t grain, const std::function<void(size_t, size_t)> &body) {
+    grain = std::max<size_t>(grain, 1);
+    if (currentPolicy == ExecutionPolicy::SEQUENTIAL || insidePool || n < 2 * grain) {
+        body(0, n);
+        return;
+    }
+    ThreadPool &workers = threadPool();
+    size_t chunks = std::min(n / grain, workers.size() * 4);
+    size_t chunk = (n + chunks - 1) / chunks;
+    chunks = (n + chunk - 1) / chunk;
+    workers.run(chunks, [&](size_t i) {
+        body(i * chunk, std::min(n, (i + 1) * chunk));
+    });
+}
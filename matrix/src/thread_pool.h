@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace task {
+
+    enum class ExecutionPolicy {
+        SEQUENTIAL,
+        PARALLEL
+    };
+
+    // Work smaller than this many elements (or multiply-adds for products) stays on the calling thread.
+    const size_t PARALLEL_THRESHOLD = 1 << 16;
+
+    void setExecutionPolicy(ExecutionPolicy policy);
+
+    ExecutionPolicy executionPolicy();
+
+    // Number of threads taking part in parallel work, the calling thread included.
+    // Zero means std::thread::hardware_concurrency(). Must not be called while parallel work is running.
+    void setThreadCount(size_t count);
+
+    size_t threadCount();
+
+
+    class ThreadPool {
+    public:
+        explicit ThreadPool(size_t threads);
+
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool &) = delete;
+
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        size_t size() const;
+
+        // Runs body(i) for every i in [0, tasks) and returns when all of them are done.
+        // The calling thread works too; idle threads steal tasks from the others' queues.
+        void run(size_t tasks, const std::function<void(size_t)> &body);
+
+    private:
+        struct Queue {
+            std::mutex mutex;
+            std::deque<size_t> tasks;
+        };
+
+        std::vector<std::thread> workers;
+        std::vector<std::unique_ptr<Queue>> queues;
+
+        std::mutex runMutex;
+        std::mutex stateMutex;
+        std::condition_variable wake;
+        std::condition_variable done;
+
+        const std::function<void(size_t)> *body = nullptr;
+        std::atomic<size_t> remaining{0};
+        std::exception_ptr error;
+        size_t generation = 0;
+        bool stopping = false;
+
+        void workerLoop(size_t index);
+
+        bool popTask(size_t index, size_t &task);
+
+        void drain(size_t index);
+    };
+
+    ThreadPool &threadPool();
+
+    // Splits [0, n) into contiguous chunks of at least grain elements and calls body(begin, end)
+    // for each of them, on the thread pool when the parallel policy is active.
+    void parallelFor(size_t n, size_t grain, const std::function<void(size_t, size_t)> &body);
+
+}// namespace task
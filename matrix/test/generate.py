@@ -26,6 +26,11 @@ def gen_tests():
     mat_sq = random_matrix(n, n)
     small = randint(1, 6)
     mat_sq_sm = random_matrix(small, small)
+    # Diagonally dominant, so the reference and the tested result agree to EPS.
+    mat_well = mat_sq + 10. * n * np.eye(n)
+    rhs = random_matrix(n, randint(1, 10))
+    mat_tall = random_matrix(n + randint(0, 5), n)
+    mat_tall[:n] += 10. * n * np.eye(n)
 
     print_matrix(mat1, mat2, mat1 + mat2)
     print_matrix(mat1 - mat2)
@@ -35,6 +40,11 @@ def gen_tests():
     print_matrix(mat1.T)
     print_matrix(mat_sq, np.trace(mat_sq))
     print_matrix(mat_sq_sm, np.linalg.det(mat_sq_sm))
+    print_matrix(mat_well, rhs, np.linalg.solve(mat_well, rhs))
+    print_matrix(np.linalg.inv(mat_well))
+    print_matrix(mat_tall, *np.linalg.qr(mat_tall))
+    mat_spd = mat_well @ mat_well.T
+    print_matrix(mat_spd, np.linalg.cholesky(mat_spd))
 
 
 for _ in range(int(sys.argv[1])):
@@ -2,9 +2,34 @@
 #include <string>
 #include <random>
 #include <algorithm>
+#include <atomic>
 #include <sstream>
 #include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory_resource>
+#include <set>
+#include <thread>
 #include "src/matrix.h"
+#include "src/lu.h"
+#include "src/qr.h"
+#include "src/cholesky.h"
+#include "src/gemm.h"
+#include "src/kernels.h"
+#include "src/thread_pool.h"
+#include "src/matrix_io.h"
+#include "src/matrix_view.h"
+#include "src/matrix_batch.h"
+#include "src/fixed_matrix.h"
+#include "src/sparse_matrix.h"
+#include "src/strassen.h"
+#include "src/matrix_memory.h"
+#include "src/summation.h"
+#include "src/matrix_counters.h"
+#include "bench/bench.h"
 
 
 using task::Matrix;
@@ -43,6 +68,59 @@ Matrix RandomMatrix(size_t rows, size_t cols) {
     return temp;
 }
 
+// Integer-valued, so that sums and products stay exact in every element type.
+template <class T>
+task::BasicMatrix<T> RandomIntMatrix(size_t rows, size_t cols, size_t max = 4) {
+    task::BasicMatrix<T> temp(rows, cols);
+    for (size_t i = 0; i < rows * cols; ++i) {
+        temp.data()[i] = T(double(RandomUInt(2 * max)) - double(max));
+    }
+    return temp;
+}
+
+// The textbook triple loop, as a reference for the blocked and vectorized products.
+template <class T>
+task::BasicMatrix<T> NaiveMultiply(const task::BasicMatrix<T>& a, const task::BasicMatrix<T>& b) {
+    task::BasicMatrix<T> temp(a.getRow(), b.getCol());
+    for (size_t i = 0; i < a.getRow(); ++i) {
+        for (size_t j = 0; j < b.getCol(); ++j) {
+            T sum = T(0);
+            for (size_t k = 0; k < a.getCol(); ++k) {
+                sum += a[i][k] * b[k][j];
+            }
+            temp[i][j] = sum;
+        }
+    }
+    return temp;
+}
+
+// Unblocked elimination with partial pivoting in long double, as a reference for det().
+long double NaiveDet(const Matrix& a) {
+    size_t n = a.getRow();
+    std::vector<long double> values(a.data(), a.data() + n * n);
+    long double det = 1;
+    for (size_t k = 0; k < n; ++k) {
+        size_t pivot = k;
+        for (size_t i = k + 1; i < n; ++i) {
+            if (std::fabs(values[i * n + k]) > std::fabs(values[pivot * n + k])) {
+                pivot = i;
+            }
+        }
+        if (pivot != k) {
+            std::swap_ranges(values.begin() + k * n, values.begin() + (k + 1) * n, values.begin() + pivot * n);
+            det = -det;
+        }
+        det *= values[k * n + k];
+        for (size_t i = k + 1; i < n; ++i) {
+            long double factor = values[i * n + k] / values[k * n + k];
+            for (size_t j = k; j < n; ++j) {
+                values[i * n + j] -= factor * values[k * n + j];
+            }
+        }
+    }
+    return det;
+}
+
 
 void FailWithMsg(const std::string& msg, int line) {
     std::cerr << "Test failed!\n";
@@ -68,6 +146,76 @@ void FailWithMsg(const std::string& msg, int line) {
 const double EPS = 1e-6;
 
 
+// sum() and dot() in every mode, against long double references: within the usual n u bound,
+// and for COMPENSATED and WIDE within a few ulps of the result plus a second-order term.
+template<class T>
+void TestSummation(task::Summation mode) {
+    const long double u = std::numeric_limits<T>::epsilon() / 2;
+    REPEAT(4)
+    {
+        size_t n = RandomUInt(1, 20 * task::SUM_BLOCK), stride = 1 + _iter % 3;
+        std::vector<T> x(n * stride), y(n);
+        for (T& value : x) {
+            value = T(RandomDouble());
+        }
+        for (T& value : y) {
+            value = T(RandomDouble());
+        }
+        long double sum = 0, sumAbs = 0, dot = 0, dotAbs = 0;
+        for (size_t i = 0; i < n; ++i) {
+            sum += x[i * stride];
+            sumAbs += fabsl(x[i * stride]);
+            dot += (long double)x[i] * y[i];
+            dotAbs += fabsl((long double)x[i] * y[i]);
+        }
+        long double sumError = fabsl(task::sum(x.data(), n, stride, mode) - sum);
+        long double dotError = fabsl(task::dot(x.data(), y.data(), n, mode) - dot);
+        if (mode == task::Summation::COMPENSATED || mode == task::Summation::WIDE) {
+            ASSERT_TRUE_MSG(sumError <= 2 * u * fabsl(sum) + 4 * n * u * u * sumAbs, task::summationName(mode))
+            ASSERT_TRUE_MSG(dotError <= 2 * u * fabsl(dot) + 4 * n * u * u * dotAbs, task::summationName(mode))
+        } else {
+            ASSERT_TRUE_MSG(sumError <= n * u * sumAbs, task::summationName(mode))
+            ASSERT_TRUE_MSG(dotError <= (n + 1) * u * dotAbs, task::summationName(mode))
+        }
+    }
+}
+
+// Closed-form det() and inverse() up to 4 x 4, Matrix above that: both against Matrix.
+template <size_t N>
+void TestFixedMatrix() {
+    using Fixed = task::FixedMatrix<double, N, N>;
+    REPEAT(20)
+    {
+        Matrix mat1 = RandomMatrix(N, N), mat2 = RandomMatrix(N, N);
+        for (size_t i = 0; i < N; ++i) {
+            mat1[i][i] += 10. * N;
+        }
+        Fixed fixed1(mat1), fixed2(mat2);
+        std::string name = "FixedMatrix<" + std::to_string(N) + ">";
+
+        ASSERT_TRUE_MSG(fabs(fixed1.det() - double(NaiveDet(mat1))) < EPS * fabs(double(NaiveDet(mat1))), name + " det()")
+        ASSERT_TRUE_MSG((fixed1 * fixed1.inverse()).toMatrix() == Matrix(N, N), name + " inverse()")
+        ASSERT_TRUE_MSG((fixed1 * fixed2).toMatrix() == mat1 * mat2, name + " product")
+        ASSERT_TRUE_MSG((fixed1 + fixed2).toMatrix() == mat1 + mat2 && (fixed1 - fixed2).toMatrix() == mat1 - mat2,
+                        name + " + and -")
+        ASSERT_TRUE_MSG((2. * fixed1).toMatrix() == 2. * mat1 && (-fixed1).toMatrix() == -mat1, name + " scaling")
+        ASSERT_TRUE_MSG(fixed1.transposed().toMatrix() == mat1.transposed(), name + " transposed()")
+        ASSERT_TRUE_MSG(fabs(fixed1.trace() - mat1.trace()) < EPS, name + " trace()")
+
+        Fixed product = fixed1;
+        product *= fixed2;
+        ASSERT_TRUE_MSG(product == fixed1 * fixed2 && Matrix(product) == mat1 * mat2, name + " *=")
+    }
+    ASSERT_EXCEPTION_MSG(Fixed(RandomMatrix(N, N + 1)), task::SizeMismatchException, "FixedMatrix from another shape")
+    ASSERT_EXCEPTION_MSG(Fixed({1., 2.}), task::SizeMismatchException, "FixedMatrix from a short list")
+    ASSERT_EXCEPTION_MSG(Fixed(Matrix(N, N) * 0.).inverse(), task::SingularMatrixException, "Singular FixedMatrix")
+
+    Fixed zero(Matrix(N, N)), withNan = zero;
+    withNan.data()[N - 1] = std::nan("");
+    ASSERT_TRUE_MSG(withNan != withNan && withNan != zero && !(withNan == zero), "FixedMatrix with NaN")
+}
+
+
 int main(int argc, char** argv) {
 
     {
@@ -208,6 +356,786 @@ int main(int argc, char** argv) {
     }
 
 
+    REPEAT(10)
+    {
+        const std::string path = "matrix_io_test.tmp";
+        auto rows = RandomUInt(1, 300), cols = RandomUInt(1, 300);
+        auto mat1 = RandomMatrix(rows, cols);
+
+        std::stringstream binary(std::ios::in | std::ios::out | std::ios::binary);
+        task::writeBinary(binary, mat1);
+        ASSERT_TRUE_MSG(task::readBinary(binary) == mat1, "Binary stream round trip")
+
+        task::saveBinary(path, mat1);
+        ASSERT_TRUE_MSG(task::loadBinary(path) == mat1, "Binary file round trip")
+        {
+            task::MappedMatrix mapped(path);
+            ASSERT_TRUE_MSG(mapped.getRow() == rows && mapped.getCol() == cols && mapped.toMatrix() == mat1,
+                            "Memory-mapped matrix")
+        }
+        ASSERT_EXCEPTION_MSG(task::loadBinary<float>(path), task::MatrixIOException, "Binary file of another dtype")
+        {
+            task::MatrixWriter writer(path, rows, cols);
+            for (size_t i = 0; i < rows; ++i) {
+                writer.writeRows(mat1.data() + i * cols, 1);
+            }
+            writer.close();
+        }
+        ASSERT_TRUE_MSG(task::MappedMatrix(path).toMatrix() == mat1, "Row-by-row writer")
+
+        task::saveText(path, mat1);
+        ASSERT_TRUE_MSG(task::loadText(path) == mat1, "Text file round trip")
+        std::stringstream text;
+        task::writeText(text, mat1);
+        std::stringstream stream(text.str());
+        Matrix mat2;
+        stream >> mat2;
+        ASSERT_TRUE_MSG(mat2 == mat1, "writeText read by operator>>")
+
+        mat2 = RandomMatrix(rows, cols);
+        for (size_t i = 0; i < rows; ++i) {
+            for (size_t j = 0; j < cols; ++j) {
+                if (TossCoin()) {
+                    mat2[i][j] = 0;
+                }
+            }
+        }
+        task::saveText(path, mat2);
+        ASSERT_TRUE_MSG(task::loadSparseText(path).toMatrix() == mat2, "Sparse text loading")
+
+        // Crafted headers: an offset inside the header, a misaligned offset, a payload past the
+        // end of the file and one whose size wraps around 2^64.
+        task::MatrixFileHeader header;
+        std::memcpy(&header, binary.str().data(), sizeof(header));
+        std::string payload = binary.str().substr(sizeof(header));
+        auto crafted = [&](uint64_t offset, uint64_t craftedRows, uint64_t craftedCols) {
+            task::MatrixFileHeader changed = header;
+            changed.payloadOffset = offset;
+            changed.rows = craftedRows;
+            changed.cols = craftedCols;
+            std::string content(reinterpret_cast<const char *>(&changed), sizeof(changed));
+            std::ofstream(path, std::ios::binary | std::ios::trunc) << content << payload;
+            std::stringstream input(content + payload, std::ios::in | std::ios::binary);
+            ASSERT_EXCEPTION_MSG(task::readBinary(input), task::MatrixIOException, "Binary stream with a bad header")
+            ASSERT_EXCEPTION_MSG(task::MappedMatrix{path}, task::MatrixIOException, "Mapped file with a bad header")
+        };
+        crafted(sizeof(header) - 8, rows, cols);
+        crafted(sizeof(header) + 4, rows, cols);
+        crafted(sizeof(header), rows + 1, cols);
+        crafted(sizeof(header), uint64_t(1) << 62, 4);
+        crafted(uint64_t(-8), 1, 1);
+        std::remove(path.c_str());
+    }
+
+    REPEAT(5)
+    {
+        // Above GEMM_THRESHOLD, with edges that leave partial GEMM_MR x GEMM_NR tiles and, every
+        // other time, an inner dimension past GEMM_KC.
+        size_t m = RandomUInt(33, 150), n = RandomUInt(33, 150);
+        size_t k = _iter % 2 == 0 ? RandomUInt(task::GEMM_KC + 1, 300) : RandomUInt(33, 150);
+        auto mat1 = RandomMatrix(m, k), mat2 = RandomMatrix(k, n);
+        Matrix expected = NaiveMultiply(mat1, mat2);
+
+        ASSERT_TRUE_MSG(mat1 * mat2 == expected, "Blocked matrix product")
+        Matrix res = mat1;
+        res *= mat2;
+        ASSERT_TRUE_MSG(res == expected, "Blocked operator *=")
+
+        // C = alpha A B + beta C on corners of the matrices, so every leading dimension is wider
+        // than the block it describes.
+        size_t rows = m - RandomUInt(0, 10), cols = n - RandomUInt(0, 10), inner = k - RandomUInt(0, 10);
+        double alpha = RandomDouble(), beta = TossCoin() ? 0. : RandomDouble();
+        Matrix c = RandomMatrix(m, n);
+        Matrix reference = c;
+        task::gemm(rows, cols, inner, alpha, mat1.data(), k, mat2.data(), n, beta, c.data(), n);
+        for (size_t i = 0; i < rows; ++i) {
+            for (size_t j = 0; j < cols; ++j) {
+                double sum = 0;
+                for (size_t l = 0; l < inner; ++l) {
+                    sum += mat1[i][l] * mat2[l][j];
+                }
+                reference[i][j] = alpha * sum + beta * reference[i][j];
+            }
+        }
+        ASSERT_TRUE_MSG(c == reference, "gemm with alpha, beta and leading dimensions")
+    }
+
+    for (auto level : {task::SimdLevel::SCALAR, task::SimdLevel::SSE2, task::SimdLevel::AVX2, task::SimdLevel::AVX512}) {
+        task::setSimdLevel(level);
+        if (task::simdLevel() != level) {
+            continue;
+        }
+        std::string name = task::simdLevelName(level);
+        REPEAT(3)
+        {
+            // Integer values keep every result exact, float included; the odd sizes leave tails
+            // after the last full vector.
+            size_t m = RandomUInt(40, 90), n = RandomUInt(40, 90), k = RandomUInt(40, 90);
+            auto mat1 = RandomIntMatrix<double>(m, k), mat2 = RandomIntMatrix<double>(m, k);
+            auto mat3 = RandomIntMatrix<double>(k, n);
+            task::BasicMatrix<float> float1(m, k), float2(m, k), float3(k, n);
+            for (size_t i = 0; i < m * k; ++i) {
+                float1.data()[i] = float(mat1.data()[i]);
+                float2.data()[i] = float(mat2.data()[i]);
+            }
+            for (size_t i = 0; i < k * n; ++i) {
+                float3.data()[i] = float(mat3.data()[i]);
+            }
+
+            Matrix sum = mat1, difference = mat1, scaled = mat1;
+            sum += mat2;
+            difference -= mat2;
+            scaled *= 3.;
+            task::BasicMatrix<float> floatSum = float1, floatDifference = float1, floatScaled = float1;
+            floatSum += float2;
+            floatDifference -= float2;
+            floatScaled *= 3.f;
+            for (size_t i = 0; i < m * k; ++i) {
+                double a = mat1.data()[i], b = mat2.data()[i];
+                ASSERT_TRUE_MSG(sum.data()[i] == a + b && floatSum.data()[i] == float(a + b), "Operator += at " + name)
+                ASSERT_TRUE_MSG(difference.data()[i] == a - b && floatDifference.data()[i] == float(a - b),
+                                "Operator -= at " + name)
+                ASSERT_TRUE_MSG(scaled.data()[i] == 3 * a && floatScaled.data()[i] == float(3 * a), "Scalar *= at " + name)
+            }
+
+            ASSERT_TRUE_MSG(mat1 * mat3 == NaiveMultiply(mat1, mat3), "Matrix product at " + name)
+            ASSERT_TRUE_MSG(float1 * float3 == NaiveMultiply(float1, float3), "float matrix product at " + name)
+
+            std::vector<double> x(m * k), y(m * k);
+            std::copy(mat1.data(), mat1.data() + m * k, x.begin());
+            std::copy(mat2.data(), mat2.data() + m * k, y.begin());
+            task::kernels<double>().axpy(y.data(), -2., x.data(), y.size());
+            for (size_t i = 0; i < m * k; ++i) {
+                ASSERT_TRUE_MSG(y[i] == mat2.data()[i] - 2 * mat1.data()[i], "axpy kernel at " + name)
+            }
+        }
+    }
+    task::setSimdLevel(task::detectSimdLevel());
+
+    {
+        task::ThreadPool pool(4);
+        std::vector<std::atomic<int>> hits(1000);
+        pool.run(hits.size(), [&](size_t i) { ++hits[i]; });
+        ASSERT_TRUE_MSG(std::all_of(hits.begin(), hits.end(), [](const std::atomic<int>& hit) { return hit == 1; }),
+                        "Thread pool runs every task once")
+        ASSERT_EXCEPTION_MSG(pool.run(100, [](size_t i) { if (i == 57) throw task::SingularMatrixException(); }),
+                             task::SingularMatrixException, "Thread pool passes exceptions on")
+
+        task::setExecutionPolicy(task::ExecutionPolicy::PARALLEL);
+        task::setThreadCount(4);
+        std::vector<std::atomic<int>> covered(100000);
+        std::atomic<bool> shortChunk{false};
+        task::parallelFor(covered.size(), 1000, [&](size_t begin, size_t end) {
+            if (end - begin < 1000 && end != covered.size()) {
+                shortChunk = true;
+            }
+            for (size_t i = begin; i < end; ++i) {
+                ++covered[i];
+            }
+        });
+        ASSERT_TRUE_MSG(!shortChunk && std::all_of(covered.begin(), covered.end(), [](const std::atomic<int>& hit) { return hit == 1; }),
+                        "parallelFor covers the range once, in chunks of at least grain")
+
+        REPEAT(3)
+        {
+            // Well above PARALLEL_THRESHOLD; integer values make the threaded results exact.
+            size_t n = RandomUInt(100, 160);
+            auto mat1 = RandomIntMatrix<double>(n, n + 7), mat2 = RandomIntMatrix<double>(n + 7, n - 5);
+            auto mat3 = RandomIntMatrix<double>(300, 300), mat4 = RandomIntMatrix<double>(300, 300);
+            Matrix product = mat1 * mat2, sum = mat3 + mat4, scaled = mat3;
+            scaled *= -2.;
+            ASSERT_TRUE_MSG(product == NaiveMultiply(mat1, mat2), "Parallel matrix product")
+            for (size_t i = 0; i < 300 * 300; ++i) {
+                ASSERT_TRUE_MSG(sum.data()[i] == mat3.data()[i] + mat4.data()[i] && scaled.data()[i] == -2 * mat3.data()[i],
+                                "Parallel element-wise operations")
+            }
+        }
+        task::setExecutionPolicy(task::ExecutionPolicy::SEQUENTIAL);
+        task::setThreadCount(0);
+    }
+
+    REPEAT(5)
+    {
+        // Several LU_BLOCK panels; I + R / n keeps det() near one whatever the size.
+        size_t n = RandomUInt(task::LU_BLOCK + 1, 3 * task::LU_BLOCK + 10);
+        Matrix mat1 = RandomMatrix(n, n);
+        mat1 *= 1. / double(n);
+        for (size_t i = 0; i < n; ++i) {
+            mat1[i][i] += 1.;
+        }
+        double expected = double(NaiveDet(mat1));
+        ASSERT_TRUE_MSG(fabs(mat1.det() - expected) < 1e-9 * fabs(expected), "Blocked LU determinant")
+
+        size_t i = RandomUInt(0, n - 1), j = (i + 1 + RandomUInt(0, n - 2)) % n;
+        Matrix swapped = mat1;
+        for (size_t col = 0; col < n; ++col) {
+            std::swap(swapped[i][col], swapped[j][col]);
+        }
+        ASSERT_TRUE_MSG(fabs(swapped.det() + expected) < 1e-9 * fabs(expected), "Determinant after a row swap")
+
+        task::LU lu(swapped);
+        const Matrix& factors = lu.factors();
+        const std::vector<size_t>& perm = lu.permutation();
+        Matrix lower(n, n), upper(n, n), permuted(n, n);
+        for (size_t row = 0; row < n; ++row) {
+            for (size_t col = 0; col < n; ++col) {
+                lower[row][col] = row > col ? factors[row][col] : row == col ? 1. : 0.;
+                upper[row][col] = row <= col ? factors[row][col] : 0.;
+                permuted[row][col] = swapped[perm[row]][col];
+            }
+        }
+        ASSERT_TRUE_MSG(NaiveMultiply(lower, upper) == permuted, "LU factors: PA = LU")
+
+        Matrix rhs = RandomMatrix(n, RandomUInt(1, 5));
+        ASSERT_TRUE_MSG(NaiveMultiply(swapped, lu.solve(rhs)) == rhs, "LU solve")
+
+        for (size_t row = 0; row < n; ++row) {
+            swapped[row][j] = 0.;
+        }
+        task::LU singular(swapped);
+        ASSERT_TRUE_MSG(singular.isSingular() && swapped.det() == 0., "Singular LU")
+        ASSERT_EXCEPTION_MSG(task::solve(swapped, rhs), task::SingularMatrixException, "Solve with a singular matrix")
+    }
+
+    {
+        // A NaN element makes a matrix unequal to everything, itself included.
+        size_t n = RandomUInt(1, 40);
+        Matrix identity(n, n), withNan(n, n);
+        for (size_t i = 0; i < n; ++i) {
+            identity[i][i] = 1.;
+            withNan[i][i] = 1.;
+        }
+        withNan[RandomUInt(n - 1)][RandomUInt(n - 1)] = std::nan("");
+        ASSERT_TRUE_MSG(withNan != withNan && !(withNan == withNan), "NaN matrix compared with itself")
+        ASSERT_TRUE_MSG(withNan != identity && identity != withNan, "NaN matrix compared with the identity")
+        ASSERT_TRUE_MSG(withNan + identity != identity * 2., "NaN in an expression")
+    }
+
+    REPEAT(6)
+    {
+        // Expressions that read the matrix they are assigned to, and a fused five-term chain, all
+        // rows wide enough for several EXPR_BLOCK spans; every other run under the parallel policy.
+        if (_iter % 2 == 1) {
+            task::setExecutionPolicy(task::ExecutionPolicy::PARALLEL);
+            task::setThreadCount(4);
+        }
+        size_t rows = RandomUInt(1, 300), cols = RandomUInt(1, 3 * task::EXPR_BLOCK);
+        Matrix a = RandomMatrix(rows, cols), b = RandomMatrix(rows, cols), c = RandomMatrix(rows, cols);
+        Matrix d = RandomMatrix(rows, cols), m = RandomMatrix(rows, cols);
+        Matrix original = m;
+        const double* buffer = m.data();
+
+        m = a - m;
+        for (size_t i = 0; i < rows * cols; ++i) {
+            ASSERT_TRUE_MSG(m.data()[i] == a.data()[i] - original.data()[i], "m = a - m")
+        }
+        original = m;
+        m = 2. * m + m;
+        for (size_t i = 0; i < rows * cols; ++i) {
+            ASSERT_TRUE_MSG(fabs(m.data()[i] - 3 * original.data()[i]) < EPS, "m = 2 * m + m")
+        }
+        original = m;
+        m = a + b - c + 2. * d - m;
+        for (size_t i = 0; i < rows * cols; ++i) {
+            double expected = a.data()[i] + b.data()[i] - c.data()[i] + 2 * d.data()[i] - original.data()[i];
+            ASSERT_TRUE_MSG(fabs(m.data()[i] - expected) < EPS, "Five-term chain reading its destination")
+        }
+        ASSERT_TRUE_MSG(m.data() == buffer, "Same-shape assignments keep the buffer")
+
+        Matrix chain = a - b + c - d + a * 0.5;
+        for (size_t i = 0; i < rows * cols; ++i) {
+            double expected = a.data()[i] - b.data()[i] + c.data()[i] - d.data()[i] + a.data()[i] * 0.5;
+            ASSERT_TRUE_MSG(fabs(chain.data()[i] - expected) < EPS, "Five-term chain")
+        }
+        task::setExecutionPolicy(task::ExecutionPolicy::SEQUENTIAL);
+        task::setThreadCount(0);
+    }
+
+    REPEAT(10)
+    {
+        // Rectangular shapes, single rows and columns included, go through the in-place cycle walk.
+        size_t rows = _iter % 3 == 0 ? 1 : RandomUInt(2, 250), cols = _iter % 3 == 1 ? 1 : RandomUInt(2, 250);
+        auto mat1 = RandomMatrix(rows, cols);
+        Matrix expected(cols, rows);
+        for (size_t i = 0; i < rows; ++i) {
+            for (size_t j = 0; j < cols; ++j) {
+                expected[j][i] = mat1[i][j];
+            }
+        }
+        ASSERT_TRUE_MSG(mat1.transposed() == expected, "transposed()")
+        Matrix res = mat1;
+        const double* buffer = res.data();
+        res.transpose();
+        ASSERT_TRUE_MSG(res.getRow() == cols && res.getCol() == rows && res == expected, "In-place transpose")
+        ASSERT_TRUE_MSG(res.data() == buffer, "In-place transpose keeps its buffer")
+        res.transpose();
+        ASSERT_TRUE_MSG(res == mat1, "Transposing twice")
+
+        Matrix moved(std::move(res));
+        ASSERT_TRUE_MSG(moved.data() == buffer && moved == mat1, "Move constructor takes the buffer")
+        ASSERT_TRUE_MSG(res.getRow() == 0 && res.getCol() == 0, "Moved-from matrix is empty")
+        res = std::move(moved);
+        ASSERT_TRUE_MSG(res.data() == buffer && moved.getRow() == 0, "Move assignment takes the buffer")
+
+        Matrix other = RandomMatrix(cols, rows);
+        const double* otherBuffer = other.data();
+        res.swap(other);
+        ASSERT_TRUE_MSG(res.data() == otherBuffer && other.data() == buffer && other == mat1, "swap()")
+        swap(res, other);
+        ASSERT_TRUE_MSG(res.data() == buffer && res == mat1 && other.getRow() == cols, "Free swap()")
+    }
+
+    REPEAT(3)
+    {
+        using Complex = std::complex<double>;
+        size_t m = RandomUInt(40, 80), n = RandomUInt(40, 80), k = RandomUInt(40, 80);
+
+        auto int1 = RandomIntMatrix<int64_t>(m, k, 1000), int2 = RandomIntMatrix<int64_t>(k, n, 1000);
+        auto intProduct = int1 * int2;
+        ASSERT_TRUE_MSG(intProduct == NaiveMultiply(int1, int2), "int64 matrix product")
+        auto intSum = int1;
+        intSum += int1;
+        ASSERT_TRUE_MSG(intSum == int1 * int64_t(2), "int64 operator += and scalar *")
+
+        // Small enough for every minor of the fraction-free elimination to fit in int64.
+        size_t small = RandomUInt(2, 10);
+        auto intSquare = RandomIntMatrix<int64_t>(small, small, 3);
+        Matrix asDouble(small, small);
+        for (size_t i = 0; i < small * small; ++i) {
+            asDouble.data()[i] = double(intSquare.data()[i]);
+        }
+        ASSERT_TRUE_MSG(intSquare.det() == int64_t(std::llround(NaiveDet(asDouble))), "Exact int64 determinant")
+
+        task::BasicMatrix<Complex> complex1(m, k), complex2(k, n);
+        for (size_t i = 0; i < m * k; ++i) {
+            complex1.data()[i] = Complex(RandomDouble(), RandomDouble());
+        }
+        for (size_t i = 0; i < k * n; ++i) {
+            complex2.data()[i] = Complex(RandomDouble(), RandomDouble());
+        }
+        ASSERT_TRUE_MSG(complex1 * complex2 == NaiveMultiply(complex1, complex2), "Complex matrix product")
+
+        task::BasicMatrix<Complex> complexSquare(n, n), identity(n, n);
+        for (size_t i = 0; i < n * n; ++i) {
+            complexSquare.data()[i] = Complex(RandomDouble(), RandomDouble()) / double(n);
+        }
+        for (size_t i = 0; i < n; ++i) {
+            complexSquare[i][i] += 1.;
+        }
+        ASSERT_TRUE_MSG(NaiveMultiply(complexSquare, task::inverse(complexSquare)) == identity, "Complex inverse")
+
+        task::BasicMatrix<float> floatSquare(n, n);
+        Matrix doubleSquare(n, n);
+        for (size_t i = 0; i < n * n; ++i) {
+            floatSquare.data()[i] = float(RandomDouble() / double(n));
+            doubleSquare.data()[i] = floatSquare.data()[i];
+        }
+        for (size_t i = 0; i < n; ++i) {
+            floatSquare[i][i] += 1.f;
+            doubleSquare[i][i] = floatSquare[i][i];
+        }
+        double expected = double(NaiveDet(doubleSquare));
+        ASSERT_TRUE_MSG(fabs(floatSquare.det() - expected) < 1e-4 * fabs(expected), "float determinant")
+    }
+
+    {
+        constexpr task::Matrix2 rotation{0., -1., 1., 0.};
+        static_assert(rotation.det() == 1. && (rotation * rotation).trace() == -2., "constexpr FixedMatrix");
+        TestFixedMatrix<2>();
+        TestFixedMatrix<3>();
+        TestFixedMatrix<4>();
+        TestFixedMatrix<5>();
+    }
+
+    REPEAT(4)
+    {
+        // About one element in twenty kept; every other run under the parallel policy.
+        if (_iter % 2 == 1) {
+            task::setExecutionPolicy(task::ExecutionPolicy::PARALLEL);
+            task::setThreadCount(4);
+        }
+        size_t rows = RandomUInt(100, 300), inner = RandomUInt(100, 300), cols = RandomUInt(100, 300);
+        Matrix dense1(rows, inner), dense2(inner, cols);
+        for (Matrix* dense : {&dense1, &dense2}) {
+            for (size_t i = 0; i < dense->getRow() * dense->getCol(); ++i) {
+                dense->data()[i] = RandomUInt(19) == 0 ? RandomDouble() : 0.;
+            }
+        }
+        task::SparseMatrix sparse1(dense1), sparse2(dense2);
+        size_t nonZeros = std::count_if(dense1.data(), dense1.data() + rows * inner, [](double x) { return x != 0.; });
+        ASSERT_TRUE_MSG(sparse1.nonZeros() == nonZeros && sparse1.toMatrix() == dense1, "CSR from a dense matrix")
+        ASSERT_TRUE_MSG(sparse1.get(rows - 1, inner - 1) == dense1[rows - 1][inner - 1], "CSR get()")
+        task::CscMatrix<double> csc1 = sparse1.toCsc();
+        ASSERT_TRUE_MSG(csc1.toMatrix() == dense1 && csc1.toCsr().toMatrix() == dense1, "CSC conversion")
+        ASSERT_TRUE_MSG(sparse1.transposed().toMatrix() == dense1.transposed(), "CSR transposed()")
+
+        std::vector<double> x(inner);
+        for (double& value : x) {
+            value = RandomDouble();
+        }
+        std::vector<double> y = task::multiply(sparse1, x), yCsc = task::multiply(csc1, x);
+        for (size_t i = 0; i < rows; ++i) {
+            double expected = 0;
+            for (size_t j = 0; j < inner; ++j) {
+                expected += dense1[i][j] * x[j];
+            }
+            ASSERT_TRUE_MSG(fabs(y[i] - expected) < EPS && fabs(yCsc[i] - expected) < EPS, "Sparse matrix-vector product")
+        }
+
+        Matrix expected = NaiveMultiply(dense1, dense2);
+        ASSERT_TRUE_MSG(task::multiply(sparse1, dense2) == expected, "Sparse times dense product")
+        ASSERT_TRUE_MSG(task::multiply(sparse1, sparse2).toMatrix() == expected, "Sparse times sparse product")
+
+        task::SparseBuilder<double> builder(rows, inner);
+        for (size_t i = 0; i < rows; ++i) {
+            for (size_t j = 0; j < inner; ++j) {
+                if (dense1[i][j] != 0.) {
+                    builder.add(i, j, dense1[i][j] / 2);
+                    builder.add(i, j, dense1[i][j] / 2);
+                }
+            }
+        }
+        ASSERT_TRUE_MSG(builder.toCsr().toMatrix() == dense1, "SparseBuilder sums duplicates")
+        ASSERT_EXCEPTION_MSG(task::SparseMatrix(2, 2, {0, 1, 1}, {2}, {1.}), task::SizeMismatchException,
+                             "CSR arrays with a column out of range")
+        ASSERT_EXCEPTION_MSG(task::SparseMatrix(2, 2, {0, 2, 1}, {0, 1}, {1., 2.}), task::SizeMismatchException,
+                             "CSR arrays with decreasing row starts")
+        task::setExecutionPolicy(task::ExecutionPolicy::SEQUENTIAL);
+        task::setThreadCount(0);
+    }
+
+    REPEAT(10)
+    {
+        // Blocks big enough for multiply() to take the blocked gemm path.
+        size_t rows = RandomUInt(80, 150), cols = RandomUInt(80, 150);
+        size_t m = RandomUInt(33, 70), n = RandomUInt(33, 70), k = RandomUInt(33, 70);
+        size_t r1 = RandomUInt(rows - m), c1 = RandomUInt(cols - k);
+        size_t r2 = RandomUInt(rows - k), c2 = RandomUInt(cols - n);
+        Matrix mat1 = RandomMatrix(rows, cols), mat2 = RandomMatrix(rows, cols), original = mat1;
+        const Matrix &constMat1 = mat1, &constMat2 = mat2;
+
+        task::ConstMatrixView a = constMat1.block(r1, c1, m, k), b = constMat2.block(r2, c2, k, n);
+        ASSERT_TRUE_MSG(a.getRow() == m && a.getCol() == k && a.getStride() == cols, "Block shape")
+        Matrix aCopy = a.toMatrix(), bCopy = b.toMatrix();
+        for (size_t i = 0; i < m; ++i) {
+            for (size_t j = 0; j < k; ++j) {
+                ASSERT_TRUE_MSG(a[i][j] == mat1[r1 + i][c1 + j] && aCopy[i][j] == mat1[r1 + i][c1 + j], "Block elements")
+            }
+        }
+        Matrix expected = NaiveMultiply(aCopy, bCopy);
+        ASSERT_TRUE_MSG(task::multiply(a, b) == expected, "Product of two blocks")
+        ASSERT_TRUE_MSG(task::multiply(a.block(1, 1, m - 1, k - 1), b.block(1, 0, k - 1, n)) ==
+                                NaiveMultiply(aCopy.block(1, 1, m - 1, k - 1).toMatrix(), bCopy.block(1, 0, k - 1, n).toMatrix()),
+                        "Product of nested blocks")
+
+        // Into a block of a third matrix, leaving the rest alone.
+        Matrix target = RandomMatrix(m + 5, n + 5), targetOriginal = target;
+        task::multiply<double>(a, b, target.block(2, 3, m, n));
+        for (size_t i = 0; i < m + 5; ++i) {
+            for (size_t j = 0; j < n + 5; ++j) {
+                bool inside = i >= 2 && i < m + 2 && j >= 3 && j < n + 3;
+                double want = inside ? expected[i - 2][j - 3] : targetOriginal[i][j];
+                ASSERT_TRUE_MSG(fabs(target[i][j] - want) < EPS, "Product into a block")
+            }
+        }
+
+        // Expressions assigned into and added to a block of mat1.
+        task::MatrixView dest = mat1.block(r2, c2, k, n);
+        dest = bCopy + bCopy;
+        dest += bCopy;
+        dest *= 2.;
+        dest -= bCopy;
+        for (size_t i = 0; i < rows; ++i) {
+            for (size_t j = 0; j < cols; ++j) {
+                bool inside = i >= r2 && i < r2 + k && j >= c2 && j < c2 + n;
+                double want = inside ? 5 * bCopy[i - r2][j - c2] : original[i][j];
+                ASSERT_TRUE_MSG(fabs(mat1[i][j] - want) < EPS, "Expressions assigned into a block")
+            }
+        }
+
+        size_t row = RandomUInt(rows - 1), col = RandomUInt(cols - 1);
+        task::RowView rowView = mat2.rowView(row);
+        task::ColView colView = mat2.colView(col);
+        ASSERT_TRUE_MSG(rowView.size() == cols && colView.size() == rows, "Row and column view sizes")
+        ASSERT_TRUE_MSG(std::equal(rowView.begin(), rowView.end(), mat2.data() + row * cols), "Row view elements")
+        for (size_t i = 0; i < rows; ++i) {
+            ASSERT_TRUE_MSG(colView[i] == mat2[i][col], "Column view elements")
+        }
+        Matrix mat2Original = mat2;
+        colView *= -1.;
+        for (size_t i = 0; i < rows; ++i) {
+            for (size_t j = 0; j < cols; ++j) {
+                ASSERT_TRUE_MSG(mat2[i][j] == (j == col ? -mat2Original[i][j] : mat2Original[i][j]), "Scaling a column view")
+            }
+        }
+
+        ASSERT_TRUE_MSG(task::overlaps(mat1.block(0, 0, 2, 2), mat1.block(1, 1, 2, 2)), "Overlapping blocks")
+        ASSERT_TRUE_MSG(!task::overlaps(mat1.block(0, 0, 2, 2), mat1.block(2, 0, 2, 2)), "Blocks one above the other")
+        ASSERT_TRUE_MSG(!task::overlaps(mat1.view(), mat2.view()), "Blocks of different matrices")
+        ASSERT_EXCEPTION_MSG(mat1.block(rows - m + 1, 0, m, 1), task::OutOfBoundsException, "Block past the last row")
+        ASSERT_EXCEPTION_MSG(a.block(0, 1, 1, k), task::OutOfBoundsException, "Nested block past the last column")
+    }
+
+    REPEAT(12)
+    {
+        // Counts that leave the last block partly filled, under each available SIMD level.
+        task::SimdLevel level = task::SimdLevel(_iter % 4);
+        task::setSimdLevel(level);
+        size_t count = RandomUInt(1, 4 * task::BATCH_LANES + 5), n = RandomUInt(1, 6), m = RandomUInt(1, 6);
+        task::MatrixBatch batch1(count, n, n), batch2(count, n, m);
+        task::BasicMatrixBatch<float> floatBatch(count, n, n);
+        std::vector<Matrix> mat1, mat2;
+        for (size_t i = 0; i < count; ++i) {
+            mat1.push_back(RandomMatrix(n, n));
+            mat1[i] *= 1. / double(n);
+            for (size_t j = 0; j < n; ++j) {
+                mat1[i][j][j] += 1.;
+            }
+            mat2.push_back(RandomMatrix(n, m));
+            batch1.setMatrix(i, mat1[i].view());
+            batch2.setMatrix(i, mat2[i].view());
+            task::BasicMatrix<float> floatMatrix(n, n);
+            for (size_t j = 0; j < n * n; ++j) {
+                floatMatrix.data()[j] = float(mat1[i].data()[j]);
+            }
+            floatBatch.setMatrix(i, floatMatrix.view());
+        }
+        ASSERT_TRUE_MSG(batch1.size() == count && batch1.blocks() == (count + task::BATCH_LANES - 1) / task::BATCH_LANES,
+                        "Batch size and blocks")
+
+        std::vector<double> det = batch1.det();
+        std::vector<float> floatDet = floatBatch.det();
+        task::MatrixBatch product = batch1 * batch2, transposed = batch2.transposed(), sum = batch1;
+        sum += batch1;
+        sum -= batch1;
+        sum += batch1;
+        ASSERT_TRUE_MSG(det.size() == count && product.getRow() == n && product.getCol() == m, "Batch result shapes")
+        for (size_t i = 0; i < count; ++i) {
+            // Rounding errors scale with the product of the row norms, which bounds |det| (Hadamard)
+            // and, unlike det, cannot cancel to nearly zero.
+            double expected = double(NaiveDet(mat1[i])), scale = 1;
+            for (size_t j = 0; j < n; ++j) {
+                double norm = 0;
+                for (size_t l = 0; l < n; ++l) {
+                    norm += mat1[i][j][l] * mat1[i][j][l];
+                }
+                scale *= sqrt(norm);
+            }
+            ASSERT_TRUE_MSG(fabs(det[i] - expected) < 1e-12 * scale, "Batch det")
+            ASSERT_TRUE_MSG(fabs(floatDet[i] - expected) < 1e-5 * scale, "Float batch det")
+            ASSERT_TRUE_MSG(product.getMatrix(i) == NaiveMultiply(mat1[i], mat2[i]), "Batch product")
+            ASSERT_TRUE_MSG(transposed.getMatrix(i) == mat2[i].transposed(), "Batch transposed()")
+            ASSERT_TRUE_MSG(sum.getMatrix(i) == mat1[i] * 2., "Batch += and -=")
+            ASSERT_TRUE_MSG(batch2.get(i, n - 1, m - 1) == mat2[i][n - 1][m - 1], "Batch get()")
+        }
+        ASSERT_EXCEPTION_MSG(batch1.get(count, 0, 0), task::OutOfBoundsException, "Batch index past the end")
+        ASSERT_EXCEPTION_MSG(batch1 * task::MatrixBatch(count + 1, n, m), task::SizeMismatchException,
+                             "Batch product of different sizes")
+        ASSERT_EXCEPTION_MSG(batch1.setMatrix(0, Matrix(n + 1, n).view()), task::SizeMismatchException, "Matrix of the wrong shape")
+    }
+    task::setSimdLevel(task::detectSimdLevel());
+
+    {
+        // The JSON the benchmark suite writes for tracking runs over time.
+        ASSERT_TRUE_MSG(bench::jsonString("a \"b\" \\ c\n\t\x01") == "\"a \\\"b\\\" \\\\ c\\n\\t\\u0001\"",
+                        "JSON string escaping")
+        std::ostringstream output;
+        bench::writeJson(output, {{"compiler", "g++\n12"}},
+                         {{"gemm", 512, 0.5, 2e9, 3e9, 7}, {"empty", 0, 0., 0., 1., 0}});
+        std::string expected = "{\n"
+                               "  \"context\": {\n"
+                               "    \"compiler\": \"g++\\n12\"\n"
+                               "  },\n"
+                               "  \"results\": [\n"
+                               "    {\"name\": \"gemm\", \"size\": 512, \"seconds\": 0.5, \"gflops\": 4, "
+                               "\"gbytes_per_second\": 6, \"allocations\": 7},\n"
+                               "    {\"name\": \"empty\", \"size\": 0, \"seconds\": 0, \"gflops\": null, "
+                               "\"gbytes_per_second\": null, \"allocations\": 0}\n"
+                               "  ]\n"
+                               "}\n";
+        ASSERT_TRUE_MSG(output.str() == expected, "Benchmark suite JSON")
+    }
+
+    REPEAT(6)
+    {
+        // A small crossover so that sizes the test can afford recurse several levels; odd sizes
+        // exercise the peeling. Every other run under the parallel policy.
+        if (_iter % 2 == 1) {
+            task::setExecutionPolicy(task::ExecutionPolicy::PARALLEL);
+            task::setThreadCount(4);
+        }
+        const size_t crossover = 32;
+        size_t m = RandomUInt(100, 200), n = RandomUInt(100, 200), k = RandomUInt(100, 200);
+        ASSERT_TRUE_MSG(task::strassenLevels(m, n, k, crossover) >= 2, "Strassen recursion depth")
+        Matrix mat1 = RandomMatrix(m, k), mat2 = RandomMatrix(k, n);
+        Matrix expected = NaiveMultiply(mat1, mat2), product = task::strassenMultiply(mat1, mat2, crossover);
+        // The normwise bound of strassenErrorBound(), with entries of at most 10.
+        double tolerance = task::strassenErrorBound(std::max({m, n, k}), crossover) * 1.2e-16 * 100;
+        double error = 0;
+        for (size_t i = 0; i < m * n; ++i) {
+            error = std::max(error, fabs(product.data()[i] - expected.data()[i]));
+        }
+        ASSERT_TRUE_MSG(product.getRow() == m && product.getCol() == n && error <= tolerance, "Strassen product")
+
+        auto int1 = RandomIntMatrix<int64_t>(m, k), int2 = RandomIntMatrix<int64_t>(k, n);
+        ASSERT_TRUE_MSG(task::strassenMultiply(int1, int2, crossover) == NaiveMultiply(int1, int2), "Exact int64 Strassen product")
+
+        // Into the middle of a wider matrix, through the leading dimensions.
+        Matrix wide1 = RandomMatrix(m, k + 3), wide2 = RandomMatrix(k, n + 5), target = RandomMatrix(m, n + 7);
+        Matrix targetOriginal = target;
+        task::strassen(m, n, k, wide1.data() + 1, k + 3, wide2.data() + 2, n + 5, target.data() + 3, n + 7, crossover);
+        expected = NaiveMultiply(wide1.block(0, 1, m, k).toMatrix(), wide2.block(0, 2, k, n).toMatrix());
+        for (size_t i = 0; i < m; ++i) {
+            for (size_t j = 0; j < n + 7; ++j) {
+                bool inside = j >= 3 && j < n + 3;
+                double want = inside ? expected[i][j - 3] : targetOriginal[i][j];
+                ASSERT_TRUE_MSG(fabs(target[i][j] - want) <= tolerance, "Strassen product with leading dimensions")
+            }
+        }
+        task::setExecutionPolicy(task::ExecutionPolicy::SEQUENTIAL);
+        task::setThreadCount(0);
+    }
+
+    REPEAT(5)
+    {
+        task::releaseMatrixPool();
+        std::pmr::memory_resource *previous = task::setMatrixResource(task::matrixPool());
+        ASSERT_TRUE_MSG(previous == std::pmr::new_delete_resource() && task::matrixResource() == task::matrixPool(),
+                        "Setting the matrix resource")
+        size_t rows = RandomUInt(50, 150), cols = RandomUInt(50, 150);
+        Matrix mat1 = RandomMatrix(rows, cols), mat2 = RandomMatrix(rows, cols);
+        Matrix expected = mat1;
+        for (size_t i = 0; i < rows * cols; ++i) {
+            expected.data()[i] += mat2.data()[i];
+        }
+
+        // Temporaries of one size go back to the cache and are handed out again.
+        task::MatrixPoolStats before = task::matrixPoolStats();
+        for (int i = 0; i < 4; ++i) {
+            Matrix sum = mat1 + mat2;
+            ASSERT_TRUE_MSG(sum == expected && sum.getResource() == task::matrixPool(), "Sum from the pool")
+        }
+        task::MatrixPoolStats after = task::matrixPoolStats();
+        ASSERT_TRUE_MSG(after.allocations - before.allocations == 4 && after.reused - before.reused >= 3 &&
+                                after.bytesReused - before.bytesReused >= 3 * rows * cols * sizeof(double),
+                        "Pool reuse")
+        ASSERT_TRUE_MSG(after.cachedBytes >= rows * cols * sizeof(double), "Freed buffers cached")
+
+        // An explicit resource stays with the matrix when it moves; copies take matrixResource().
+        std::pmr::unsynchronized_pool_resource local;
+        Matrix own(rows, cols, &local);
+        own = mat1;
+        ASSERT_TRUE_MSG(own.getResource() == &local && own == mat1, "Assignment keeps the resource")
+        Matrix copy = own;
+        ASSERT_TRUE_MSG(copy.getResource() == task::matrixPool() && copy == mat1, "Copies take matrixResource()")
+        Matrix reshaped(rows + 1, cols, &local);
+        reshaped = mat1 + mat2;
+        ASSERT_TRUE_MSG(reshaped.getResource() == &local && reshaped == expected,
+                        "Assigning an expression of another shape keeps the resource")
+        Matrix moved = std::move(own);
+        ASSERT_TRUE_MSG(moved.getResource() == &local && moved == mat1, "Moves carry the resource")
+        copy.swap(moved);
+        ASSERT_TRUE_MSG(copy.getResource() == &local && moved.getResource() == task::matrixPool(), "Swaps carry the resource")
+
+        // A buffer allocated on another thread joins the cache of the thread freeing it.
+        Matrix fromThread;
+        std::thread([&] { fromThread = mat1 + mat2; }).join();
+        size_t cached = task::matrixPoolStats().cachedBytes;
+        ASSERT_TRUE_MSG(fromThread == expected, "Sum on another thread")
+        fromThread = Matrix();
+        ASSERT_TRUE_MSG(task::matrixPoolStats().cachedBytes >= cached + rows * cols * sizeof(double),
+                        "Buffers freed across threads")
+
+        task::releaseMatrixPool();
+        ASSERT_TRUE_MSG(task::matrixPoolStats().cachedBytes == 0, "releaseMatrixPool()")
+        ASSERT_TRUE_MSG(task::setMatrixResource(nullptr) == task::matrixPool() &&
+                                task::matrixResource() == std::pmr::new_delete_resource(),
+                        "Restoring the default resource")
+    }
+
+    for (task::SimdLevel level : {task::SimdLevel::SCALAR, task::SimdLevel::SSE2, task::SimdLevel::AVX2, task::SimdLevel::AVX512}) {
+        task::setSimdLevel(level);
+        if (task::simdLevel() != level) {
+            continue;
+        }
+        for (task::Summation mode : {task::Summation::PLAIN, task::Summation::PAIRWISE, task::Summation::COMPENSATED,
+                                     task::Summation::WIDE}) {
+            TestSummation<float>(mode);
+            TestSummation<double>(mode);
+
+            // gemm picks the mode up: one dot product per element unless PLAIN.
+            task::setSummation(mode);
+            ASSERT_TRUE_MSG(task::summation() == mode, "setSummation()")
+            size_t m = RandomUInt(33, 80), n = RandomUInt(33, 80), k = RandomUInt(33, 80);
+            Matrix mat1 = RandomMatrix(m, k), mat2 = RandomMatrix(k, n), square = RandomMatrix(m, m);
+            ASSERT_TRUE_MSG(mat1 * mat2 == NaiveMultiply(mat1, mat2), "Product under each summation mode")
+            auto float1 = RandomIntMatrix<float>(m, k), float2 = RandomIntMatrix<float>(k, n);
+            ASSERT_TRUE_MSG(float1 * float2 == NaiveMultiply(float1, float2), "Float product under each summation mode")
+            square *= 1. / double(m);
+            long double trace = 0;
+            for (size_t i = 0; i < m; ++i) {
+                square[i][i] += 1.;
+                trace += square[i][i];
+            }
+            ASSERT_TRUE_MSG(fabsl(square.trace() - trace) < EPS, "trace() under each summation mode")
+            long double det = NaiveDet(square);
+            ASSERT_TRUE_MSG(fabsl(square.det() - det) < 1e-9 * fabsl(det), "det() under each summation mode")
+        }
+    }
+    task::setSummation(task::Summation::PLAIN);
+    task::setSimdLevel(task::detectSimdLevel());
+
+    {
+        // Only what is recorded here shows up unless the library is built with MATRIX_COUNTERS=1;
+        // then a product adds its 2 m n k flops too.
+        using task::Operation;
+        task::resetCounters();
+        task::MatrixCounters counters = task::readCounters();
+        ASSERT_TRUE_MSG(std::all_of(counters.begin(), counters.end(),
+                                    [](const task::OperationCounters& c) { return c.calls == 0 && c.flops == 0; }),
+                        "Counters after resetCounters()")
+        task::recordOperation(Operation::SOLVE, 10, 20, 30);
+        task::recordOperation(Operation::SOLVE, 1, 2, 3);
+        std::thread([] { task::recordOperation(Operation::FACTORIZE, 4, 5, 6); }).join();
+        size_t m = RandomUInt(33, 80), n = RandomUInt(33, 80), k = RandomUInt(33, 80);
+        Matrix product = RandomMatrix(m, k) * RandomMatrix(k, n);
+        counters = task::readCounters();
+        const task::OperationCounters &solve = counters[size_t(Operation::SOLVE)];
+        const task::OperationCounters &factorize = counters[size_t(Operation::FACTORIZE)];
+        const task::OperationCounters &multiply = counters[size_t(Operation::MULTIPLY)];
+        ASSERT_TRUE_MSG(solve.calls == 2 && solve.bytes == 11 && solve.flops == 22 && solve.cycles == 33,
+                        "Counts recorded on this thread")
+        ASSERT_TRUE_MSG(factorize.calls == 1 && factorize.bytes == 4 && factorize.flops == 5 && factorize.cycles == 6,
+                        "Counts of an exited thread")
+        ASSERT_TRUE_MSG(task::COUNTERS_ENABLED ? multiply.calls == 1 && multiply.flops == 2 * m * n * k
+                                               : multiply.calls == 0,
+                        "Counted product")
+
+        std::ostringstream dump;
+        dump.precision(3);
+        task::dumpCounters(dump);
+        const std::string note = "matrix counters disabled, build with -DMATRIX_COUNTERS=1\n";
+        ASSERT_TRUE_MSG(dump.str().find("solve") != std::string::npos && dump.str().find("factorize") != std::string::npos &&
+                                (dump.str().compare(0, note.size(), note) == 0) != task::COUNTERS_ENABLED &&
+                                dump.precision() == 3 && !(dump.flags() & std::ios_base::fixed),
+                        "dumpCounters() shows what readCounters() returns")
+        std::set<std::string> names;
+        for (size_t i = 0; i < task::OPERATION_COUNT; ++i) {
+            names.insert(task::operationName(Operation(i)));
+        }
+        ASSERT_TRUE_MSG(names.size() == task::OPERATION_COUNT && !names.count("unknown"), "operationName()")
+
+        task::resetCounters();
+        counters = task::readCounters();
+        ASSERT_TRUE_MSG(counters[size_t(Operation::SOLVE)].calls == 0 && counters[size_t(Operation::FACTORIZE)].calls == 0,
+                        "resetCounters() after recording")
+        if (!task::COUNTERS_ENABLED) {
+            std::ostringstream empty;
+            task::dumpCounters(empty);
+            ASSERT_TRUE_MSG(empty.str() == note, "dumpCounters() with nothing recorded")
+        }
+    }
+
     const int STRESS_TEST_COUNT = argc > 1 ? std::stoi(argv[1]) : 0;
 
     REPEAT(STRESS_TEST_COUNT)
@@ -286,6 +1214,23 @@ int main(int argc, char** argv) {
 
         std::cin >> mat2 >> scalar;
         ASSERT_TRUE_MSG(fabs(mat2.det() - scalar) < EPS * 10., "Determinant")
+
+
+        std::cin >> mat1 >> mat2 >> ans;
+        ASSERT_TRUE_MSG(task::solve(mat1, mat2) == ans, "Solve")
+
+        std::cin >> ans;
+        ASSERT_TRUE_MSG(task::inverse(mat1) == ans, "Inverse")
+
+
+        std::cin >> mat1 >> mat2 >> ans;
+        task::QR qr(mat1);
+        ASSERT_TRUE_MSG(qr.q() == mat2, "QR: Q")
+        ASSERT_TRUE_MSG(qr.r() == ans, "QR: R")
+
+
+        std::cin >> mat1 >> ans;
+        ASSERT_TRUE_MSG(task::Cholesky(mat1).factor() == ans, "Cholesky")
     }
 
 }
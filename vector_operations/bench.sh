@@ -0,0 +1,10 @@
+#!/bin/bash
+
+set -e
+
+BENCHMARK=${1:-vector_ops}
+
+g++ -std=c++17 -O2 -pthread $CXXFLAGS -I./ bench/$BENCHMARK.cpp -o vector_ops_bench
+./vector_ops_bench "${@:2}"
+
+rm vector_ops_bench
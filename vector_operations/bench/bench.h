@@ -0,0 +1,45 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+
+namespace bench {
+
+    template<class T>
+    void doNotOptimize(const T &value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    template<class F>
+    double secondsPerRun(F &&f, double minSeconds = 0.2, size_t minRuns = 3) {
+        using Clock = std::chrono::steady_clock;
+        f();
+        size_t runs = 0;
+        auto start = Clock::now();
+        double elapsed = 0;
+        while (runs < minRuns || elapsed < minSeconds) {
+            f();
+            ++runs;
+            elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        }
+        return elapsed / runs;
+    }
+
+    inline void printHeader(const std::string &title, const std::string &unit = "GB/s") {
+        std::printf("\n%s\n", title.c_str());
+        std::printf("%-28s %10s %14s %14s\n", "case", "size", "time, us", unit.c_str());
+    }
+
+    // amount is bytes or flops per run, reported in giga-units per second.
+    inline void printRow(const std::string &name, size_t n, double seconds, double amount) {
+        std::printf("%-28s %10zu %14.3f %14.3f\n", name.c_str(), n, seconds * 1e6, amount / seconds / 1e9);
+    }
+
+    // Reports the cost of a single operation when every run performs ops of them.
+    inline void printLatencyRow(const std::string &name, size_t n, double seconds, size_t ops) {
+        std::printf("%-28s %10zu %14.3f %14.3f\n", name.c_str(), n, seconds * 1e6, seconds / ops * 1e9);
+    }
+
+}// namespace bench
@@ -0,0 +1,82 @@
+#include "bench/bench.h"
+#include "src/bitset.h"
+#include "src/vector_ops.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+
+using namespace task;
+
+
+// The operator as it was before the SIMD kernels, for comparison.
+namespace legacy {
+
+    std::vector<int> bitOr(const std::vector<int> &a, const std::vector<int> &b) {
+        std::vector<int> c(a.size());
+        for (int i = 0; i < a.size(); ++i) {
+            c[i] = a[i] | b[i];
+        }
+        return c;
+    }
+
+}// namespace legacy
+
+
+// Filters with about one entry in four set.
+std::vector<int> randomFilter(size_t n) {
+    static std::mt19937 rand(42);
+    std::vector<int> filter(n);
+    for (int &value : filter) {
+        value = rand() % 4 == 0;
+    }
+    return filter;
+}
+
+void check(bool condition, const char *what) {
+    if (!condition) {
+        std::fprintf(stderr, "%s differs from the reference\n", what);
+        std::exit(EXIT_FAILURE);
+    }
+}
+
+void run(size_t n) {
+    std::vector<int> a = randomFilter(n), b = randomFilter(n), c;
+    double bytes = double(n) * sizeof(int);
+    std::vector<int> expected = legacy::bitOr(a, b);
+    bench::printRow("legacy a | b", n, bench::secondsPerRun([&] { bench::doNotOptimize(legacy::bitOr(a, b)); }), 3 * bytes);
+
+    for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        setSimdLevel(level);
+        if (simdLevel() != level) {
+            continue;
+        }
+        std::string name = simdLevelName(level);
+        c = a | b;
+        check(c == expected, "a | b");
+        check(Bitset(c).toInts() == expected, "Bitset conversion");
+
+        bench::printRow("a | b, " + name, n, bench::secondsPerRun([&] { bench::doNotOptimize(a | b); }), 3 * bytes);
+        bench::printRow("c |= b, " + name, n, bench::secondsPerRun([&] { bench::doNotOptimize(c |= b); }), 3 * bytes);
+        bench::printRow("c &= b, " + name, n, bench::secondsPerRun([&] { bench::doNotOptimize(c &= b); }), 3 * bytes);
+
+        Bitset x(a), y(b);
+        double bitBytes = double(x.words().size()) * sizeof(uint64_t);
+        bench::printRow("Bitset(ints), " + name, n, bench::secondsPerRun([&] { bench::doNotOptimize(Bitset(a)); }), bytes + bitBytes);
+        bench::printRow("toInts(), " + name, n, bench::secondsPerRun([&] { bench::doNotOptimize(x.toInts()); }), bytes + bitBytes);
+        bench::printRow("Bitset |=, " + name, n, bench::secondsPerRun([&] { bench::doNotOptimize(x |= y); }), 3 * bitBytes);
+        bench::printRow("Bitset count(), " + name, n, bench::secondsPerRun([&] { bench::doNotOptimize(x.count()); }), bitBytes);
+    }
+}
+
+
+int main() {
+    std::printf("%zu threads\n", vectorThreadCount());
+    bench::printHeader("Bitwise filter combination, bytes touched per second");
+    for (size_t n : {100000, 10000000, 100000000}) {
+        run(n);
+    }
+}
@@ -0,0 +1,92 @@
+#include "bench/bench.h"
+#include "src/vector_batch.h"
+#include "src/vector_ops.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+
+using namespace task;
+
+
+const size_t LEGACY_LIMIT = 1000000;
+
+
+struct Pairs {
+    std::vector<double> ax, ay, az, bx, by, bz;
+};
+
+// Every other pair is collinear, with a random factor of either sign.
+Pairs randomPairs(size_t n) {
+    static std::mt19937 rand(42);
+    std::uniform_real_distribution<double> dist{-10., 10.};
+    Pairs pairs;
+    for (size_t i = 0; i < n; ++i) {
+        double x = dist(rand), y = dist(rand), z = dist(rand), mult = dist(rand);
+        pairs.ax.push_back(x);
+        pairs.ay.push_back(y);
+        pairs.az.push_back(z);
+        pairs.bx.push_back(i % 2 == 0 ? x * mult : dist(rand));
+        pairs.by.push_back(i % 2 == 0 ? y * mult : dist(rand));
+        pairs.bz.push_back(i % 2 == 0 ? z * mult : dist(rand));
+    }
+    return pairs;
+}
+
+void run(size_t n) {
+    Pairs pairs = randomPairs(n);
+    auto a = vec3Arrays(pairs.ax, pairs.ay, pairs.az), b = vec3Arrays(pairs.bx, pairs.by, pairs.bz);
+    if (n <= LEGACY_LIMIT) {
+        std::vector<std::vector<double>> first, second;
+        for (size_t i = 0; i < n; ++i) {
+            first.push_back({pairs.ax[i], pairs.ay[i], pairs.az[i]});
+            second.push_back({pairs.bx[i], pairs.by[i], pairs.bz[i]});
+        }
+        bench::printRow("operator|| loop", n, bench::secondsPerRun([&] {
+                            std::vector<uint64_t> mask((n + 63) / 64);
+                            for (size_t i = 0; i < n; ++i) {
+                                if (first[i] || second[i]) {
+                                    mask[i / 64] |= uint64_t(1) << (i % 64);
+                                }
+                            }
+                            bench::doNotOptimize(mask.data());
+                        }),
+                        double(n));
+        bench::printRow("operator&& loop", n, bench::secondsPerRun([&] {
+                            std::vector<uint64_t> mask((n + 63) / 64);
+                            for (size_t i = 0; i < n; ++i) {
+                                if (first[i] && second[i]) {
+                                    mask[i / 64] |= uint64_t(1) << (i % 64);
+                                }
+                            }
+                            bench::doNotOptimize(mask.data());
+                        }),
+                        double(n));
+    }
+    for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        setSimdLevel(level);
+        if (simdLevel() != level) {
+            continue;
+        }
+        std::string name = simdLevelName(level);
+        bench::printRow("collinearMask, " + name, n, bench::secondsPerRun([&] {
+                            bench::doNotOptimize(collinearMask(a, b).data());
+                        }),
+                        double(n));
+        bench::printRow("codirectionalMask, " + name, n, bench::secondsPerRun([&] {
+                            bench::doNotOptimize(codirectionalMask(a, b).data());
+                        }),
+                        double(n));
+    }
+}
+
+
+int main() {
+    std::printf("%zu threads\n", vectorThreadCount());
+    bench::printHeader("Collinearity of 3D vector pairs, pairs per second", "Gpairs/s");
+    for (size_t n : {1000, 100000, 1000000, 10000000}) {
+        run(n);
+    }
+}
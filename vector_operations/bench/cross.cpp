@@ -0,0 +1,78 @@
+#include "bench/bench.h"
+#include "src/vec3.h"
+#include "src/vector_batch.h"
+#include "src/vector_ops.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+
+using namespace task;
+
+
+const size_t LEGACY_LIMIT = 1000000;
+
+
+std::vector<Vec3> randomVectors(size_t n) {
+    static std::mt19937 rand(42);
+    std::uniform_real_distribution<double> dist{-10., 10.};
+    std::vector<Vec3> vectors(n);
+    for (Vec3 &v : vectors) {
+        v = {dist(rand), dist(rand), dist(rand)};
+    }
+    return vectors;
+}
+
+void run(size_t n) {
+    std::vector<Vec3> a = randomVectors(n), b = randomVectors(n), out(n);
+    if (n <= LEGACY_LIMIT) {
+        std::vector<std::vector<double>> first(a.begin(), a.end()), second(b.begin(), b.end()), result(n);
+        bench::printRow("operator% loop", n, bench::secondsPerRun([&] {
+                            for (size_t i = 0; i < n; ++i) {
+                                result[i] = first[i] % second[i];
+                            }
+                            bench::doNotOptimize(result.data());
+                        }),
+                        double(n));
+    }
+    bench::printRow("Vec3 loop", n, bench::secondsPerRun([&] {
+                        for (size_t i = 0; i < n; ++i) {
+                            out[i] = a[i] % b[i];
+                        }
+                        bench::doNotOptimize(out.data());
+                    }),
+                    double(n));
+
+    std::vector<double> ax(n), ay(n), az(n), bx(n), by(n), bz(n), cx(n), cy(n), cz(n);
+    for (size_t i = 0; i < n; ++i) {
+        ax[i] = a[i].x, ay[i] = a[i].y, az[i] = a[i].z;
+        bx[i] = b[i].x, by[i] = b[i].y, bz[i] = b[i].z;
+    }
+    for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        setSimdLevel(level);
+        if (simdLevel() != level) {
+            continue;
+        }
+        std::string name = simdLevelName(level);
+        bench::printRow("cross AoS, " + name, n, bench::secondsPerRun([&] {
+                            cross(a.data(), b.data(), out.data(), n);
+                            bench::doNotOptimize(out.data());
+                        }),
+                        double(n));
+        bench::printRow("cross SoA, " + name, n, bench::secondsPerRun([&] {
+                            cross(vec3Arrays(ax, ay, az), vec3Arrays(bx, by, bz), vec3Arrays(cx, cy, cz));
+                            bench::doNotOptimize(cx.data());
+                        }),
+                        double(n));
+    }
+}
+
+
+int main() {
+    std::printf("%zu threads\n", vectorThreadCount());
+    bench::printHeader("Cross products of 3D vector pairs, products per second", "Gcross/s");
+    for (size_t n : {1000, 100000, 1000000, 10000000}) {
+        run(n);
+    }
+}
@@ -0,0 +1,145 @@
+#include "bench/bench.h"
+#include "src/vector_ops.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+using namespace task;
+
+
+// The operators as they were before the from_chars/to_chars versions, for comparison.
+namespace legacy {
+
+    std::istream &read(std::istream &stream, std::vector<double> &a) {
+        int n;
+        stream >> n;
+        a = std::vector<double>(n);
+        for (int i = 0; i < n; ++i) {
+            stream >> a[i];
+        }
+        return stream;
+    }
+
+    std::ostream &write(std::ostream &cout, const std::vector<double> &a) {
+        for (int i = 0; i < a.size(); ++i) {
+            cout << a[i] << " ";
+        }
+        cout << std::endl;
+        return cout;
+    }
+
+}// namespace legacy
+
+
+const char *FILE_NAME = "vector_io_bench.tmp";
+
+
+std::vector<double> randomVector(size_t n) {
+    static std::mt19937 rand(42);
+    std::uniform_real_distribution<double> dist{-1000., 1000.};
+    std::vector<double> vec(n);
+    for (double &value : vec) {
+        value = dist(rand);
+    }
+    return vec;
+}
+
+void check(bool condition, const char *what) {
+    if (!condition) {
+        std::fprintf(stderr, "%s differs from the reference\n", what);
+        std::exit(EXIT_FAILURE);
+    }
+}
+
+// Writes vectors of n numbers with the given precision and reads them back, reporting megabytes
+// of text per second (printRow() reports giga-units, hence bytes * 1e3).
+void run(size_t n, int precision) {
+    std::vector<double> a = randomVector(n), b;
+    std::string suffix = ", precision " + std::to_string(precision);
+
+    std::ostringstream sample;
+    sample.precision(precision);
+    sample << n << '\n';
+    legacy::write(sample, a);
+    std::string text = sample.str();
+    double bytes = double(text.size());
+
+    std::ostringstream current;
+    current.precision(precision);
+    current << n << '\n' << a;
+    check(current.str() == text, "operator<<");
+
+    bench::printRow("legacy <<" + suffix, n, bench::secondsPerRun([&] {
+                        std::ostringstream out;
+                        out.precision(precision);
+                        legacy::write(out, a);
+                        bench::doNotOptimize(out.str().size());
+                    }),
+                    bytes * 1e3);
+    bench::printRow("<<" + suffix, n, bench::secondsPerRun([&] {
+                        std::ostringstream out;
+                        out.precision(precision);
+                        out << a;
+                        bench::doNotOptimize(out.str().size());
+                    }),
+                    bytes * 1e3);
+    bench::printRow("legacy >>" + suffix, n, bench::secondsPerRun([&] {
+                        std::istringstream in(text);
+                        legacy::read(in, b);
+                        bench::doNotOptimize(b.data());
+                    }),
+                    bytes * 1e3);
+    bench::printRow(">>" + suffix, n, bench::secondsPerRun([&] {
+                        std::istringstream in(text);
+                        in >> b;
+                        bench::doNotOptimize(b.data());
+                    }),
+                    bytes * 1e3);
+
+    std::ofstream(FILE_NAME) << text;
+    bench::printRow(">> from a file" + suffix, n, bench::secondsPerRun([&] {
+                        std::ifstream in(FILE_NAME);
+                        in >> b;
+                        bench::doNotOptimize(b.data());
+                    }),
+                    bytes * 1e3);
+    std::vector<double> expected;
+    std::istringstream reference(text);
+    legacy::read(reference, expected);
+    check(b == expected, "operator>> from a file");
+}
+
+void runBinary(size_t n) {
+    std::vector<double> a = randomVector(n), b;
+    double bytes = double(n * sizeof(double));
+    bench::printRow("writeBinary to a file", n, bench::secondsPerRun([&] {
+                        std::ofstream out(FILE_NAME, std::ios::binary);
+                        writeBinary(out, a);
+                    }),
+                    bytes * 1e3);
+    bench::printRow("readBinary from a file", n, bench::secondsPerRun([&] {
+                        std::ifstream in(FILE_NAME, std::ios::binary);
+                        readBinary(in, b);
+                        bench::doNotOptimize(b.data());
+                    }),
+                    bytes * 1e3);
+    check(a == b, "readBinary");
+}
+
+
+int main() {
+    bench::printHeader("Text and binary I/O of std::vector<double>, megabytes per second", "MB/s");
+    for (size_t n : {1000, 1000000}) {
+        for (int precision : {6, 17}) {
+            run(n, precision);
+        }
+        runBinary(n);
+    }
+    std::remove(FILE_NAME);
+}
@@ -0,0 +1,144 @@
+#include "bench/bench.h"
+#include "src/vector_ops.h"
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+
+using namespace task;
+
+
+// The operators as they were before the SIMD kernels, for comparison.
+namespace legacy {
+
+    std::vector<double> &addAssign(std::vector<double> &a, const std::vector<double> &b) {
+        for (int i = 0; i < a.size(); ++i) {
+            a[i] += b[i];
+        }
+        return a;
+    }
+
+    std::vector<double> add(const std::vector<double> &a, const std::vector<double> &b) {
+        std::vector<double> c = a;
+        addAssign(c, b);
+        return c;
+    }
+
+    std::vector<double> sub(const std::vector<double> &a, const std::vector<double> &b) {
+        std::vector<double> c(a.size());
+        for (int i = 0; i < a.size(); ++i) {
+            c[i] = a[i] - b[i];
+        }
+        return c;
+    }
+
+    std::vector<double> negate(const std::vector<double> &a) {
+        std::vector<double> c(a.size());
+        for (int i = 0; i < a.size(); ++i) {
+            c[i] = -a[i];
+        }
+        return c;
+    }
+
+    double dot(const std::vector<double> &a, const std::vector<double> &b) {
+        double c = 0;
+        for (int i = 0; i < a.size(); ++i) {
+            c += a[i] * b[i];
+        }
+        return c;
+    }
+
+}// namespace legacy
+
+
+std::vector<double> randomVector(size_t n) {
+    static std::mt19937 rand(42);
+    std::uniform_real_distribution<double> dist{-10., 10.};
+    std::vector<double> vec(n);
+    for (double &value : vec) {
+        value = dist(rand);
+    }
+    return vec;
+}
+
+// Bytes are the ones the operation must move: 8 per element read or written, result included.
+void run(const std::string &version, size_t n) {
+    std::vector<double> a = randomVector(n), b = randomVector(n);
+    double bytes = 8. * n;
+    if (version == "legacy") {
+        bench::printRow(version + " a + b", n, bench::secondsPerRun([&] { bench::doNotOptimize(legacy::add(a, b)); }), 3 * bytes);
+        bench::printRow(version + " a - b", n, bench::secondsPerRun([&] { bench::doNotOptimize(legacy::sub(a, b)); }), 3 * bytes);
+        bench::printRow(version + " -a", n, bench::secondsPerRun([&] { bench::doNotOptimize(legacy::negate(a)); }), 2 * bytes);
+        bench::printRow(version + " a += b", n, bench::secondsPerRun([&] { bench::doNotOptimize(legacy::addAssign(a, b)); }), 3 * bytes);
+        bench::printRow(version + " a * b", n, bench::secondsPerRun([&] { bench::doNotOptimize(legacy::dot(a, b)); }), 2 * bytes);
+        return;
+    }
+    using Vector = std::vector<double>;
+    bench::printRow(version + " a + b", n, bench::secondsPerRun([&] { bench::doNotOptimize(Vector(a + b)); }), 3 * bytes);
+    bench::printRow(version + " a - b", n, bench::secondsPerRun([&] { bench::doNotOptimize(Vector(a - b)); }), 3 * bytes);
+    bench::printRow(version + " -a", n, bench::secondsPerRun([&] { bench::doNotOptimize(Vector(-a)); }), 2 * bytes);
+    bench::printRow(version + " a += b", n, bench::secondsPerRun([&] { bench::doNotOptimize(a += b); }), 3 * bytes);
+    bench::printRow(version + " a * b", n, bench::secondsPerRun([&] { bench::doNotOptimize(a * b); }), 2 * bytes);
+}
+
+// Chains of operators: the previous operators make a temporary per operator, expressions make
+// at most the result.
+void fused(size_t n) {
+    std::vector<double> a = randomVector(n), b = randomVector(n), c = randomVector(n), r(n);
+    double bytes = 8. * n;
+    bench::printRow("legacy r = a + b - c", n, bench::secondsPerRun([&] {
+                        r = legacy::sub(legacy::add(a, b), c);
+                    }),
+                    4 * bytes);
+    bench::printRow("expr r = a + b - c", n, bench::secondsPerRun([&] {
+                        r = a + b - c;
+                    }),
+                    4 * bytes);
+    bench::printRow("assign(r, a + b - c)", n, bench::secondsPerRun([&] {
+                        assign(r, a + b - c);
+                    }),
+                    4 * bytes);
+    bench::printRow("legacy loop r += 0.5 * a", n, bench::secondsPerRun([&] {
+                        for (int i = 0; i < r.size(); ++i) {
+                            r[i] += 0.5 * a[i];
+                        }
+                        bench::doNotOptimize(r);
+                    }),
+                    3 * bytes);
+    bench::printRow("expr r += 0.5 * a", n, bench::secondsPerRun([&] {
+                        r += 0.5 * a;
+                    }),
+                    3 * bytes);
+    bench::printRow("axpy(0.5, a, r)", n, bench::secondsPerRun([&] {
+                        axpy(0.5, a, r);
+                    }),
+                    3 * bytes);
+    bench::printRow("legacy r = a + b - c, dot d", n, bench::secondsPerRun([&] {
+                        bench::doNotOptimize(legacy::dot(legacy::sub(legacy::add(a, b), c), r));
+                    }),
+                    4 * bytes);
+    bench::printRow("expr (a + b - c) * d", n, bench::secondsPerRun([&] {
+                        bench::doNotOptimize((a + b - c) * r);
+                    }),
+                    4 * bytes);
+}
+
+
+int main(int argc, char **argv) {
+    size_t largest = argc > 1 ? std::stoul(argv[1]) : 100000000;
+    std::printf("simd %s, %zu threads\n", task::simdLevelName(task::simdLevel()), task::vectorThreadCount());
+    bench::printHeader("std::vector<double> operators, bytes moved per second");
+    for (size_t n = 100000; n <= largest; n *= 10) {
+        run("legacy", n);
+        run("simd", n);
+        task::setSimdLevel(task::SimdLevel::SCALAR);
+        run("scalar", n);
+        task::setSimdLevel(task::SimdLevel::AVX512);
+    }
+
+    bench::printHeader("Operator chains, bytes moved per second");
+    fused(100000);
+    fused(largest);
+}
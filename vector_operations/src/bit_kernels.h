@@ -0,0 +1,275 @@
+#pragma once
+
+#include "vector_kernels.h"
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace task {
+
+    enum class BitOp {
+        OR,
+        AND,
+        XOR,
+        // a & ~b: the bits of a that are not set in b.
+        AND_NOT
+    };
+
+    namespace detail {
+
+        template<BitOp Op, class T>
+        constexpr T applyBits(T a, T b) {
+            if constexpr (Op == BitOp::OR) {
+                return a | b;
+            } else if constexpr (Op == BitOp::AND) {
+                return a & b;
+            } else if constexpr (Op == BitOp::XOR) {
+                return a ^ b;
+            } else {
+                return a & ~b;
+            }
+        }
+
+        template<BitOp Op, class T>
+        void bitwiseScalar(T *dst, const T *a, const T *b, size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                dst[i] = applyBits<Op>(a[i], b[i]);
+            }
+        }
+
+        // Sets bit i % 64 of bits[i / 64] to values[i] != 0 for the words [first, last); the last
+        // word of the array may be partial.
+        inline void packScalar(const int *values, size_t n, uint64_t *bits, size_t first, size_t last) {
+            for (size_t w = first; w < last; ++w) {
+                uint64_t word = 0;
+                for (size_t i = w * 64; i < n && i < w * 64 + 64; ++i) {
+                    word |= uint64_t(values[i] != 0) << (i % 64);
+                }
+                bits[w] = word;
+            }
+        }
+
+        // values[i] = bit i of bits, as 0 or 1, for the words [first, last).
+        inline void unpackScalar(const uint64_t *bits, int *values, size_t n, size_t first, size_t last) {
+            for (size_t w = first; w < last; ++w) {
+                for (size_t i = w * 64; i < n && i < w * 64 + 64; ++i) {
+                    values[i] = int(bits[w] >> (i % 64) & 1);
+                }
+            }
+        }
+
+        inline size_t popcountScalar(const uint64_t *bits, size_t n) {
+            size_t count = 0;
+            for (size_t i = 0; i < n; ++i) {
+                count += __builtin_popcountll(bits[i]);
+            }
+            return count;
+        }
+
+#ifdef VECTOR_X86
+
+        template<BitOp Op>
+        __attribute__((target("avx2"))) inline __m256i applyBits(__m256i a, __m256i b) {
+            if constexpr (Op == BitOp::OR) {
+                return _mm256_or_si256(a, b);
+            } else if constexpr (Op == BitOp::AND) {
+                return _mm256_and_si256(a, b);
+            } else if constexpr (Op == BitOp::XOR) {
+                return _mm256_xor_si256(a, b);
+            } else {
+                return _mm256_andnot_si256(b, a);
+            }
+        }
+
+        template<BitOp Op>
+        __attribute__((target("avx512f"))) inline __m512i applyBits(__m512i a, __m512i b) {
+            if constexpr (Op == BitOp::OR) {
+                return _mm512_or_si512(a, b);
+            } else if constexpr (Op == BitOp::AND) {
+                return _mm512_and_si512(a, b);
+            } else if constexpr (Op == BitOp::XOR) {
+                return _mm512_xor_si512(a, b);
+            } else {
+                return _mm512_andnot_si512(b, a);
+            }
+        }
+
+        template<BitOp Op, class T>
+        __attribute__((target("avx2"))) void bitwiseAvx2(T *dst, const T *a, const T *b, size_t n) {
+            const size_t step = 32 / sizeof(T);
+            size_t i = 0;
+            for (; i + 2 * step <= n; i += 2 * step) {
+                __m256i x0 = applyBits<Op>(_mm256_loadu_si256((const __m256i *) (a + i)), _mm256_loadu_si256((const __m256i *) (b + i)));
+                __m256i x1 = applyBits<Op>(_mm256_loadu_si256((const __m256i *) (a + i + step)), _mm256_loadu_si256((const __m256i *) (b + i + step)));
+                _mm256_storeu_si256((__m256i *) (dst + i), x0);
+                _mm256_storeu_si256((__m256i *) (dst + i + step), x1);
+            }
+            bitwiseScalar<Op>(dst + i, a + i, b + i, n - i);
+        }
+
+        template<BitOp Op, class T>
+        __attribute__((target("avx512f"))) void bitwiseAvx512(T *dst, const T *a, const T *b, size_t n) {
+            const size_t step = 64 / sizeof(T);
+            size_t i = 0;
+            for (; i + 2 * step <= n; i += 2 * step) {
+                __m512i x0 = applyBits<Op>(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i));
+                __m512i x1 = applyBits<Op>(_mm512_loadu_si512(a + i + step), _mm512_loadu_si512(b + i + step));
+                _mm512_storeu_si512(dst + i, x0);
+                _mm512_storeu_si512(dst + i + step, x1);
+            }
+            bitwiseScalar<Op>(dst + i, a + i, b + i, n - i);
+        }
+
+        __attribute__((target("avx2"))) inline void packAvx2(const int *values, size_t n, uint64_t *bits, size_t first, size_t last) {
+            __m256i zero = _mm256_setzero_si256();
+            size_t w = first;
+            for (; w < last && w * 64 + 64 <= n; ++w) {
+                uint64_t word = 0;
+                for (size_t j = 0; j < 64; j += 8) {
+                    __m256i zeros = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *) (values + w * 64 + j)), zero);
+                    word |= uint64_t(~_mm256_movemask_ps(_mm256_castsi256_ps(zeros)) & 0xff) << j;
+                }
+                bits[w] = word;
+            }
+            packScalar(values, n, bits, w, last);
+        }
+
+        __attribute__((target("avx2"))) inline void unpackAvx2(const uint64_t *bits, int *values, size_t n, size_t first, size_t last) {
+            __m256i lanes = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+            size_t w = first;
+            for (; w < last && w * 64 + 64 <= n; ++w) {
+                for (size_t j = 0; j < 64; j += 8) {
+                    __m256i byte = _mm256_set1_epi32(int(bits[w] >> j & 0xff));
+                    __m256i set = _mm256_cmpeq_epi32(_mm256_and_si256(byte, lanes), lanes);
+                    _mm256_storeu_si256((__m256i *) (values + w * 64 + j), _mm256_srli_epi32(set, 31));
+                }
+            }
+            unpackScalar(bits, values, n, w, last);
+        }
+
+        __attribute__((target("avx512f"))) inline void packAvx512(const int *values, size_t n, uint64_t *bits, size_t first, size_t last) {
+            size_t w = first;
+            for (; w < last && w * 64 + 64 <= n; ++w) {
+                const int *p = values + w * 64;
+                uint64_t word = 0;
+                for (size_t j = 0; j < 64; j += 16) {
+                    __m512i v = _mm512_loadu_si512(p + j);
+                    word |= uint64_t(_mm512_test_epi32_mask(v, v)) << j;
+                }
+                bits[w] = word;
+            }
+            packScalar(values, n, bits, w, last);
+        }
+
+        __attribute__((target("avx512f"))) inline void unpackAvx512(const uint64_t *bits, int *values, size_t n, size_t first, size_t last) {
+            __m512i one = _mm512_set1_epi32(1);
+            size_t w = first;
+            for (; w < last && w * 64 + 64 <= n; ++w) {
+                int *p = values + w * 64;
+                for (size_t j = 0; j < 64; j += 16) {
+                    _mm512_storeu_si512(p + j, _mm512_maskz_mov_epi32(__mmask16(bits[w] >> j), one));
+                }
+            }
+            unpackScalar(bits, values, n, w, last);
+        }
+
+        __attribute__((target("popcnt"))) inline size_t popcountHardware(const uint64_t *bits, size_t n) {
+            size_t c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+            size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                c0 += __builtin_popcountll(bits[i]);
+                c1 += __builtin_popcountll(bits[i + 1]);
+                c2 += __builtin_popcountll(bits[i + 2]);
+                c3 += __builtin_popcountll(bits[i + 3]);
+            }
+            for (; i < n; ++i) {
+                c0 += __builtin_popcountll(bits[i]);
+            }
+            return c0 + c1 + c2 + c3;
+        }
+
+#endif
+
+        template<BitOp Op, class T>
+        void bitwiseSpan(T *dst, const T *a, const T *b, size_t n) {
+#ifdef VECTOR_X86
+            switch (simdLevel()) {
+                case SimdLevel::AVX2:
+                    bitwiseAvx2<Op>(dst, a, b, n);
+                    return;
+                case SimdLevel::AVX512:
+                    bitwiseAvx512<Op>(dst, a, b, n);
+                    return;
+                default:
+                    break;
+            }
+#endif
+            bitwiseScalar<Op>(dst, a, b, n);
+        }
+
+    }// namespace detail
+
+    // dst[i] = a[i] op b[i] for integer arrays; dst may be a or b.
+    template<class T>
+    void bitwise(BitOp op, T *dst, const T *a, const T *b, size_t n) {
+        switch (op) {
+            case BitOp::OR:
+                detail::bitwiseSpan<BitOp::OR>(dst, a, b, n);
+                break;
+            case BitOp::AND:
+                detail::bitwiseSpan<BitOp::AND>(dst, a, b, n);
+                break;
+            case BitOp::XOR:
+                detail::bitwiseSpan<BitOp::XOR>(dst, a, b, n);
+                break;
+            default:
+                detail::bitwiseSpan<BitOp::AND_NOT>(dst, a, b, n);
+                break;
+        }
+    }
+
+    // Packs values[i] != 0 into bit i % 64 of bits[i / 64] for the words [first, last).
+    inline void packBits(const int *values, size_t n, uint64_t *bits, size_t first, size_t last) {
+#ifdef VECTOR_X86
+        switch (simdLevel()) {
+            case SimdLevel::AVX2:
+                detail::packAvx2(values, n, bits, first, last);
+                return;
+            case SimdLevel::AVX512:
+                detail::packAvx512(values, n, bits, first, last);
+                return;
+            default:
+                break;
+        }
+#endif
+        detail::packScalar(values, n, bits, first, last);
+    }
+
+    // The inverse of packBits(): values[i] becomes 0 or 1.
+    inline void unpackBits(const uint64_t *bits, int *values, size_t n, size_t first, size_t last) {
+#ifdef VECTOR_X86
+        switch (simdLevel()) {
+            case SimdLevel::AVX2:
+                detail::unpackAvx2(bits, values, n, first, last);
+                return;
+            case SimdLevel::AVX512:
+                detail::unpackAvx512(bits, values, n, first, last);
+                return;
+            default:
+                break;
+        }
+#endif
+        detail::unpackScalar(bits, values, n, first, last);
+    }
+
+    inline size_t popcount(const uint64_t *bits, size_t n) {
+#ifdef VECTOR_X86
+        if (simdLevel() != SimdLevel::SCALAR) {
+            return detail::popcountHardware(bits, n);
+        }
+#endif
+        return detail::popcountScalar(bits, n);
+    }
+
+}// namespace task
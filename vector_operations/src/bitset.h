@@ -0,0 +1,130 @@
+#pragma once
+
+#include "bit_kernels.h"
+#include "vector_ops.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+
+namespace task {
+
+    // A filter of size() flags packed 64 to a word: bit i % 64 of word i / 64 is flag i, the same
+    // layout as collinearMask() returns. Bits past size() are always zero.
+    class Bitset {
+    public:
+        Bitset() = default;
+
+        explicit Bitset(size_t size) : bits((size + 63) / 64), length(size) {}
+
+        // Takes words in the layout above; bits past size are cleared.
+        Bitset(std::vector<uint64_t> words, size_t size) : bits(std::move(words)), length(size) {
+            if (bits.size() != (size + 63) / 64) {
+                throw SizeMismatchException();
+            }
+            clearTail();
+        }
+
+        // Flag i is set where values[i] != 0.
+        explicit Bitset(const std::vector<int> &values) : Bitset(values.size()) {
+            size_t n = values.size();
+            parallelFor(bits.size(), VECTOR_CHUNK / 64, [&](size_t begin, size_t end) {
+                packBits(values.data(), n, bits.data(), begin, end);
+            });
+        }
+
+        // One 0 or 1 per flag.
+        std::vector<int> toInts() const {
+            std::vector<int> values(length);
+            parallelFor(bits.size(), VECTOR_CHUNK / 64, [&](size_t begin, size_t end) {
+                unpackBits(bits.data(), values.data(), length, begin, end);
+            });
+            return values;
+        }
+
+        size_t size() const {
+            return length;
+        }
+
+        bool test(size_t i) const {
+            return bits[i / 64] >> (i % 64) & 1;
+        }
+
+        void set(size_t i, bool value = true) {
+            uint64_t bit = uint64_t(1) << (i % 64);
+            bits[i / 64] = value ? bits[i / 64] | bit : bits[i / 64] & ~bit;
+        }
+
+        // Number of set flags.
+        size_t count() const {
+            return popcount(bits.data(), bits.size());
+        }
+
+        const std::vector<uint64_t> &words() const {
+            return bits;
+        }
+
+        Bitset &operator|=(const Bitset &other) {
+            return combine(BitOp::OR, other);
+        }
+
+        Bitset &operator&=(const Bitset &other) {
+            return combine(BitOp::AND, other);
+        }
+
+        Bitset &operator^=(const Bitset &other) {
+            return combine(BitOp::XOR, other);
+        }
+
+        // Clears the flags set in other.
+        Bitset &andNotAssign(const Bitset &other) {
+            return combine(BitOp::AND_NOT, other);
+        }
+
+        bool operator==(const Bitset &other) const {
+            return length == other.length && bits == other.bits;
+        }
+
+        bool operator!=(const Bitset &other) const {
+            return !(*this == other);
+        }
+
+    private:
+        std::vector<uint64_t> bits;
+        size_t length = 0;
+
+        Bitset &combine(BitOp op, const Bitset &other) {
+            if (length != other.length) {
+                throw SizeMismatchException();
+            }
+            parallelFor(bits.size(), VECTOR_CHUNK, [&](size_t begin, size_t end) {
+                bitwise(op, bits.data() + begin, bits.data() + begin, other.bits.data() + begin, end - begin);
+            });
+            return *this;
+        }
+
+        void clearTail() {
+            if (length % 64 != 0) {
+                bits.back() &= (uint64_t(1) << (length % 64)) - 1;
+            }
+        }
+    };
+
+    inline Bitset operator|(Bitset a, const Bitset &b) {
+        return a |= b;
+    }
+
+    inline Bitset operator&(Bitset a, const Bitset &b) {
+        return a &= b;
+    }
+
+    inline Bitset operator^(Bitset a, const Bitset &b) {
+        return a ^= b;
+    }
+
+    inline Bitset andNot(Bitset a, const Bitset &b) {
+        return a.andNotAssign(b);
+    }
+
+}// namespace task
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "vector_ops.h"
+
+#include <type_traits>
+#include <vector>
+
+
+namespace task {
+
+    // A 3D vector held by value, for code that would otherwise pass std::vector<double> of size 3
+    // around: no allocation, and arrays of Vec3 are plain interleaved x, y, z coordinates.
+    struct Vec3 {
+        double x = 0;
+        double y = 0;
+        double z = 0;
+
+        Vec3() = default;
+
+        constexpr Vec3(double x, double y, double z) : x(x), y(y), z(z) {}
+
+        // Throws SizeMismatchException unless vec has three elements.
+        explicit Vec3(const std::vector<double> &vec) {
+            if (vec.size() != 3) {
+                throw SizeMismatchException();
+            }
+            x = vec[0];
+            y = vec[1];
+            z = vec[2];
+        }
+
+        operator std::vector<double>() const {
+            return {x, y, z};
+        }
+
+        Vec3 &operator+=(const Vec3 &other) {
+            x += other.x;
+            y += other.y;
+            z += other.z;
+            return *this;
+        }
+
+        Vec3 &operator-=(const Vec3 &other) {
+            x -= other.x;
+            y -= other.y;
+            z -= other.z;
+            return *this;
+        }
+
+        Vec3 &operator+=(const std::vector<double> &other) {
+            return *this += Vec3(other);
+        }
+
+        Vec3 &operator-=(const std::vector<double> &other) {
+            return *this -= Vec3(other);
+        }
+    };
+
+    static_assert(std::is_trivially_copyable<Vec3>::value && sizeof(Vec3) == 3 * sizeof(double),
+                  "Vec3 arrays must be interleaved coordinates");
+
+    constexpr Vec3 operator+(const Vec3 &a, const Vec3 &b) {
+        return {a.x + b.x, a.y + b.y, a.z + b.z};
+    }
+
+    constexpr Vec3 operator-(const Vec3 &a, const Vec3 &b) {
+        return {a.x - b.x, a.y - b.y, a.z - b.z};
+    }
+
+    constexpr Vec3 operator+(const Vec3 &a) {
+        return a;
+    }
+
+    constexpr Vec3 operator-(const Vec3 &a) {
+        return {-a.x, -a.y, -a.z};
+    }
+
+    constexpr Vec3 operator*(double factor, const Vec3 &a) {
+        return {factor * a.x, factor * a.y, factor * a.z};
+    }
+
+    constexpr Vec3 operator*(const Vec3 &a, double factor) {
+        return factor * a;
+    }
+
+    // Dot product, like operator* of std::vector<double>.
+    constexpr double operator*(const Vec3 &a, const Vec3 &b) {
+        return a.x * b.x + a.y * b.y + a.z * b.z;
+    }
+
+    // Cross product, like operator% of std::vector<double>.
+    constexpr Vec3 operator%(const Vec3 &a, const Vec3 &b) {
+        return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+    }
+
+    // Mixed with std::vector<double>, which has to hold three elements (SizeMismatchException
+    // otherwise); the result is a Vec3 and converts back to a vector implicitly.
+    inline Vec3 operator+(const Vec3 &a, const std::vector<double> &b) {
+        return a + Vec3(b);
+    }
+
+    inline Vec3 operator+(const std::vector<double> &a, const Vec3 &b) {
+        return Vec3(a) + b;
+    }
+
+    inline Vec3 operator-(const Vec3 &a, const std::vector<double> &b) {
+        return a - Vec3(b);
+    }
+
+    inline Vec3 operator-(const std::vector<double> &a, const Vec3 &b) {
+        return Vec3(a) - b;
+    }
+
+    inline double operator*(const Vec3 &a, const std::vector<double> &b) {
+        return a * Vec3(b);
+    }
+
+    inline double operator*(const std::vector<double> &a, const Vec3 &b) {
+        return Vec3(a) * b;
+    }
+
+    inline Vec3 operator%(const Vec3 &a, const std::vector<double> &b) {
+        return a % Vec3(b);
+    }
+
+    inline Vec3 operator%(const std::vector<double> &a, const Vec3 &b) {
+        return Vec3(a) % b;
+    }
+
+    constexpr bool operator==(const Vec3 &a, const Vec3 &b) {
+        return a.x == b.x && a.y == b.y && a.z == b.z;
+    }
+
+    constexpr bool operator!=(const Vec3 &a, const Vec3 &b) {
+        return !(a == b);
+    }
+
+}// namespace task
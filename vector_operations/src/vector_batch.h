@@ -0,0 +1,300 @@
+#pragma once
+
+#include "vec3.h"
+#include "vector_ops.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+
+namespace task {
+
+    // Pairs whose angle has a sine at most this are collinear by default.
+    const double COLLINEAR_TOLERANCE = 1e-7;
+
+    // size 3-vectors stored as three coordinate arrays: vector i is (x[i], y[i], z[i]).
+    template<class T>
+    struct Vec3Arrays {
+        T *x;
+        T *y;
+        T *z;
+        size_t size;
+
+        // Writable arrays can be read wherever read-only ones are expected.
+        template<class U, class = std::enable_if_t<std::is_same<U, const T>::value && !std::is_same<U, T>::value>>
+        operator Vec3Arrays<U>() const {
+            return {x, y, z, size};
+        }
+    };
+
+    namespace detail {
+
+        using Vec3Input = Vec3Arrays<const double>;
+
+        // |a x b|^2 <= tolerance^2 |a|^2 |b|^2: no divisions, and pairs with a zero vector count as
+        // collinear like they do for operator||. Coordinates must stay below about 1e75 in magnitude
+        // for the product of squared norms not to overflow.
+        inline bool collinearPair(const Vec3Input &a, const Vec3Input &b, size_t i, double tolerance2,
+                                  bool codirectional) {
+            double cx = a.y[i] * b.z[i] - a.z[i] * b.y[i];
+            double cy = a.z[i] * b.x[i] - a.x[i] * b.z[i];
+            double cz = a.x[i] * b.y[i] - a.y[i] * b.x[i];
+            double na = a.x[i] * a.x[i] + a.y[i] * a.y[i] + a.z[i] * a.z[i];
+            double nb = b.x[i] * b.x[i] + b.y[i] * b.y[i] + b.z[i] * b.z[i];
+            if (cx * cx + cy * cy + cz * cz > tolerance2 * (na * nb)) {
+                return false;
+            }
+            return !codirectional || a.x[i] * b.x[i] + a.y[i] * b.y[i] + a.z[i] * b.z[i] >= 0;
+        }
+
+        // Sets bit i % 64 of mask[i / 64] for every matching pair i in [begin, end); begin is a
+        // multiple of 64, so ranges starting at different such offsets write different words.
+        inline void collinearScalar(const Vec3Input &a, const Vec3Input &b, size_t begin, size_t end,
+                                    double tolerance2, bool codirectional, uint64_t *mask) {
+            for (size_t i = begin; i < end; ++i) {
+                if (collinearPair(a, b, i, tolerance2, codirectional)) {
+                    mask[i / 64] |= uint64_t(1) << (i % 64);
+                }
+            }
+        }
+
+#ifdef VECTOR_X86
+
+        __attribute__((target("avx2,fma"))) inline void collinearAvx2(const Vec3Input &a, const Vec3Input &b, size_t begin, size_t end,
+                                                                       double tolerance2, bool codirectional, uint64_t *mask) {
+            __m256d t = _mm256_set1_pd(tolerance2);
+            size_t i = begin;
+            for (; i + 4 <= end; i += 4) {
+                __m256d ax = _mm256_loadu_pd(a.x + i), ay = _mm256_loadu_pd(a.y + i), az = _mm256_loadu_pd(a.z + i);
+                __m256d bx = _mm256_loadu_pd(b.x + i), by = _mm256_loadu_pd(b.y + i), bz = _mm256_loadu_pd(b.z + i);
+                __m256d cx = _mm256_fmsub_pd(ay, bz, _mm256_mul_pd(az, by));
+                __m256d cy = _mm256_fmsub_pd(az, bx, _mm256_mul_pd(ax, bz));
+                __m256d cz = _mm256_fmsub_pd(ax, by, _mm256_mul_pd(ay, bx));
+                __m256d c2 = _mm256_fmadd_pd(cx, cx, _mm256_fmadd_pd(cy, cy, _mm256_mul_pd(cz, cz)));
+                __m256d na = _mm256_fmadd_pd(ax, ax, _mm256_fmadd_pd(ay, ay, _mm256_mul_pd(az, az)));
+                __m256d nb = _mm256_fmadd_pd(bx, bx, _mm256_fmadd_pd(by, by, _mm256_mul_pd(bz, bz)));
+                __m256d hit = _mm256_cmp_pd(c2, _mm256_mul_pd(t, _mm256_mul_pd(na, nb)), _CMP_LE_OQ);
+                if (codirectional) {
+                    __m256d dot = _mm256_fmadd_pd(ax, bx, _mm256_fmadd_pd(ay, by, _mm256_mul_pd(az, bz)));
+                    hit = _mm256_and_pd(hit, _mm256_cmp_pd(dot, _mm256_setzero_pd(), _CMP_GE_OQ));
+                }
+                mask[i / 64] |= uint64_t(_mm256_movemask_pd(hit)) << (i % 64);
+            }
+            collinearScalar(a, b, i, end, tolerance2, codirectional, mask);
+        }
+
+        __attribute__((target("avx512f"))) inline void collinearAvx512(const Vec3Input &a, const Vec3Input &b, size_t begin, size_t end,
+                                                                       double tolerance2, bool codirectional, uint64_t *mask) {
+            __m512d t = _mm512_set1_pd(tolerance2);
+            size_t i = begin;
+            for (; i + 8 <= end; i += 8) {
+                __m512d ax = _mm512_loadu_pd(a.x + i), ay = _mm512_loadu_pd(a.y + i), az = _mm512_loadu_pd(a.z + i);
+                __m512d bx = _mm512_loadu_pd(b.x + i), by = _mm512_loadu_pd(b.y + i), bz = _mm512_loadu_pd(b.z + i);
+                __m512d cx = _mm512_fmsub_pd(ay, bz, _mm512_mul_pd(az, by));
+                __m512d cy = _mm512_fmsub_pd(az, bx, _mm512_mul_pd(ax, bz));
+                __m512d cz = _mm512_fmsub_pd(ax, by, _mm512_mul_pd(ay, bx));
+                __m512d c2 = _mm512_fmadd_pd(cx, cx, _mm512_fmadd_pd(cy, cy, _mm512_mul_pd(cz, cz)));
+                __m512d na = _mm512_fmadd_pd(ax, ax, _mm512_fmadd_pd(ay, ay, _mm512_mul_pd(az, az)));
+                __m512d nb = _mm512_fmadd_pd(bx, bx, _mm512_fmadd_pd(by, by, _mm512_mul_pd(bz, bz)));
+                __mmask8 hit = _mm512_cmp_pd_mask(c2, _mm512_mul_pd(t, _mm512_mul_pd(na, nb)), _CMP_LE_OQ);
+                if (codirectional) {
+                    __m512d dot = _mm512_fmadd_pd(ax, bx, _mm512_fmadd_pd(ay, by, _mm512_mul_pd(az, bz)));
+                    hit &= _mm512_cmp_pd_mask(dot, _mm512_setzero_pd(), _CMP_GE_OQ);
+                }
+                mask[i / 64] |= uint64_t(hit) << (i % 64);
+            }
+            collinearScalar(a, b, i, end, tolerance2, codirectional, mask);
+        }
+
+#endif
+
+        inline std::vector<uint64_t> collinearMask(const Vec3Input &a, const Vec3Input &b, double tolerance,
+                                                   bool codirectional) {
+            if (a.size != b.size) {
+                throw SizeMismatchException();
+            }
+            std::vector<uint64_t> mask((a.size + 63) / 64);
+            auto kernel = collinearScalar;
+#ifdef VECTOR_X86
+            if (simdLevel() == SimdLevel::AVX512) {
+                kernel = collinearAvx512;
+            } else if (simdLevel() == SimdLevel::AVX2) {
+                kernel = collinearAvx2;
+            }
+#endif
+            parallelFor(a.size, VECTOR_CHUNK, [&](size_t begin, size_t end) {
+                kernel(a, b, begin, end, tolerance * tolerance, codirectional, mask.data());
+            });
+            return mask;
+        }
+
+        inline void crossScalar(const Vec3 *a, const Vec3 *b, Vec3 *out, size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                out[i] = a[i] % b[i];
+            }
+        }
+
+        inline void crossScalar(const Vec3Input &a, const Vec3Input &b, const Vec3Arrays<double> &out,
+                                size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                Vec3 c = Vec3(a.x[i], a.y[i], a.z[i]) % Vec3(b.x[i], b.y[i], b.z[i]);
+                out.x[i] = c.x;
+                out.y[i] = c.y;
+                out.z[i] = c.z;
+            }
+        }
+
+#ifdef VECTOR_X86
+
+        __attribute__((target("avx2,fma"))) inline void crossAvx2(const Vec3Input &a, const Vec3Input &b, const Vec3Arrays<double> &out,
+                                                                   size_t begin, size_t end) {
+            size_t i = begin;
+            for (; i + 4 <= end; i += 4) {
+                __m256d ax = _mm256_loadu_pd(a.x + i), ay = _mm256_loadu_pd(a.y + i), az = _mm256_loadu_pd(a.z + i);
+                __m256d bx = _mm256_loadu_pd(b.x + i), by = _mm256_loadu_pd(b.y + i), bz = _mm256_loadu_pd(b.z + i);
+                _mm256_storeu_pd(out.x + i, _mm256_fmsub_pd(ay, bz, _mm256_mul_pd(az, by)));
+                _mm256_storeu_pd(out.y + i, _mm256_fmsub_pd(az, bx, _mm256_mul_pd(ax, bz)));
+                _mm256_storeu_pd(out.z + i, _mm256_fmsub_pd(ax, by, _mm256_mul_pd(ay, bx)));
+            }
+            crossScalar(a, b, out, i, end);
+        }
+
+        __attribute__((target("avx512f"))) inline void crossAvx512(const Vec3Input &a, const Vec3Input &b, const Vec3Arrays<double> &out,
+                                                                   size_t begin, size_t end) {
+            size_t i = begin;
+            for (; i + 8 <= end; i += 8) {
+                __m512d ax = _mm512_loadu_pd(a.x + i), ay = _mm512_loadu_pd(a.y + i), az = _mm512_loadu_pd(a.z + i);
+                __m512d bx = _mm512_loadu_pd(b.x + i), by = _mm512_loadu_pd(b.y + i), bz = _mm512_loadu_pd(b.z + i);
+                _mm512_storeu_pd(out.x + i, _mm512_fmsub_pd(ay, bz, _mm512_mul_pd(az, by)));
+                _mm512_storeu_pd(out.y + i, _mm512_fmsub_pd(az, bx, _mm512_mul_pd(ax, bz)));
+                _mm512_storeu_pd(out.z + i, _mm512_fmsub_pd(ax, by, _mm512_mul_pd(ay, bx)));
+            }
+            crossScalar(a, b, out, i, end);
+        }
+
+        // Eight interleaved vectors fill three registers; two two-source permutes per coordinate
+        // gather them into x, y and z registers and back.
+        struct Deinterleave {
+            __m512i x0, x1, y0, y1, z0, z1;
+        };
+
+        __attribute__((target("avx512f"))) inline const Deinterleave &deinterleaveIndices() {
+            static const Deinterleave indices = {
+                    _mm512_setr_epi64(0, 3, 6, 9, 12, 15, 0, 0), _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 10, 13),
+                    _mm512_setr_epi64(1, 4, 7, 10, 13, 0, 0, 0), _mm512_setr_epi64(0, 1, 2, 3, 4, 8, 11, 14),
+                    _mm512_setr_epi64(2, 5, 8, 11, 14, 0, 0, 0), _mm512_setr_epi64(0, 1, 2, 3, 4, 9, 12, 15)};
+            return indices;
+        }
+
+        __attribute__((target("avx512f"))) inline const Deinterleave &interleaveIndices() {
+            // x0/x1 build the first output register, y0/y1 the second and z0/z1 the third.
+            static const Deinterleave indices = {
+                    _mm512_setr_epi64(0, 8, 0, 1, 9, 0, 2, 10), _mm512_setr_epi64(0, 1, 8, 3, 4, 9, 6, 7),
+                    _mm512_setr_epi64(0, 3, 11, 0, 4, 12, 0, 5), _mm512_setr_epi64(10, 1, 2, 11, 4, 5, 12, 7),
+                    _mm512_setr_epi64(13, 0, 6, 14, 0, 7, 15, 0), _mm512_setr_epi64(0, 13, 2, 3, 14, 5, 6, 15)};
+            return indices;
+        }
+
+        __attribute__((target("avx512f"))) inline void crossAvx512(const Vec3 *a, const Vec3 *b, Vec3 *out, size_t n) {
+            const Deinterleave &in = deinterleaveIndices();
+            const Deinterleave &back = interleaveIndices();
+            size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                const double *pa = &a[i].x, *pb = &b[i].x;
+                __m512d a0 = _mm512_loadu_pd(pa), a1 = _mm512_loadu_pd(pa + 8), a2 = _mm512_loadu_pd(pa + 16);
+                __m512d b0 = _mm512_loadu_pd(pb), b1 = _mm512_loadu_pd(pb + 8), b2 = _mm512_loadu_pd(pb + 16);
+                __m512d ax = _mm512_permutex2var_pd(_mm512_permutex2var_pd(a0, in.x0, a1), in.x1, a2);
+                __m512d ay = _mm512_permutex2var_pd(_mm512_permutex2var_pd(a0, in.y0, a1), in.y1, a2);
+                __m512d az = _mm512_permutex2var_pd(_mm512_permutex2var_pd(a0, in.z0, a1), in.z1, a2);
+                __m512d bx = _mm512_permutex2var_pd(_mm512_permutex2var_pd(b0, in.x0, b1), in.x1, b2);
+                __m512d by = _mm512_permutex2var_pd(_mm512_permutex2var_pd(b0, in.y0, b1), in.y1, b2);
+                __m512d bz = _mm512_permutex2var_pd(_mm512_permutex2var_pd(b0, in.z0, b1), in.z1, b2);
+                __m512d cx = _mm512_fmsub_pd(ay, bz, _mm512_mul_pd(az, by));
+                __m512d cy = _mm512_fmsub_pd(az, bx, _mm512_mul_pd(ax, bz));
+                __m512d cz = _mm512_fmsub_pd(ax, by, _mm512_mul_pd(ay, bx));
+                double *po = &out[i].x;
+                _mm512_storeu_pd(po, _mm512_permutex2var_pd(_mm512_permutex2var_pd(cx, back.x0, cy), back.x1, cz));
+                _mm512_storeu_pd(po + 8, _mm512_permutex2var_pd(_mm512_permutex2var_pd(cx, back.y0, cy), back.y1, cz));
+                _mm512_storeu_pd(po + 16, _mm512_permutex2var_pd(_mm512_permutex2var_pd(cx, back.z0, cy), back.z1, cz));
+            }
+            crossScalar(a + i, b + i, out + i, n - i);
+        }
+
+#endif
+
+    }// namespace detail
+
+    // out[i] = a[i] x b[i] for n interleaved vectors; out may be a or b.
+    inline void cross(const Vec3 *a, const Vec3 *b, Vec3 *out, size_t n) {
+        auto kernel = static_cast<void (*)(const Vec3 *, const Vec3 *, Vec3 *, size_t)>(detail::crossScalar);
+#ifdef VECTOR_X86
+        if (simdLevel() == SimdLevel::AVX512) {
+            kernel = detail::crossAvx512;
+        }
+#endif
+        parallelFor(n, VECTOR_CHUNK, [&](size_t begin, size_t end) {
+            kernel(a + begin, b + begin, out + begin, end - begin);
+        });
+    }
+
+    inline std::vector<Vec3> cross(const std::vector<Vec3> &a, const std::vector<Vec3> &b) {
+        if (a.size() != b.size()) {
+            throw SizeMismatchException();
+        }
+        std::vector<Vec3> out(a.size());
+        cross(a.data(), b.data(), out.data(), a.size());
+        return out;
+    }
+
+    // out[i] = a[i] x b[i] over coordinate arrays; out may share arrays with a or b.
+    inline void cross(const Vec3Arrays<const double> &a, const Vec3Arrays<const double> &b, const Vec3Arrays<double> &out) {
+        if (a.size != b.size || a.size != out.size) {
+            throw SizeMismatchException();
+        }
+        auto kernel = static_cast<void (*)(const detail::Vec3Input &, const detail::Vec3Input &, const Vec3Arrays<double> &,
+                                           size_t, size_t)>(detail::crossScalar);
+#ifdef VECTOR_X86
+        if (simdLevel() == SimdLevel::AVX512) {
+            kernel = detail::crossAvx512;
+        } else if (simdLevel() == SimdLevel::AVX2) {
+            kernel = detail::crossAvx2;
+        }
+#endif
+        parallelFor(a.size, VECTOR_CHUNK, [&](size_t begin, size_t end) {
+            kernel(a, b, out, begin, end);
+        });
+    }
+
+    // Views three equally long coordinate vectors as size 3-vectors.
+    inline Vec3Arrays<const double> vec3Arrays(const std::vector<double> &x, const std::vector<double> &y,
+                                               const std::vector<double> &z) {
+        if (x.size() != y.size() || x.size() != z.size()) {
+            throw SizeMismatchException();
+        }
+        return {x.data(), y.data(), z.data(), x.size()};
+    }
+
+    inline Vec3Arrays<double> vec3Arrays(std::vector<double> &x, std::vector<double> &y, std::vector<double> &z) {
+        if (x.size() != y.size() || x.size() != z.size()) {
+            throw SizeMismatchException();
+        }
+        return {x.data(), y.data(), z.data(), x.size()};
+    }
+
+    // Bit i % 64 of word i / 64 is set when a[i] and b[i] are collinear: the sine of the angle
+    // between them is at most tolerance, or one of them is zero. Scale-invariant, unlike the
+    // element ratios operator|| compares.
+    inline std::vector<uint64_t> collinearMask(const Vec3Arrays<const double> &a, const Vec3Arrays<const double> &b,
+                                               double tolerance = COLLINEAR_TOLERANCE) {
+        return detail::collinearMask(a, b, tolerance, false);
+    }
+
+    // As collinearMask(), for pairs that also point the same way (a[i] . b[i] >= 0).
+    inline std::vector<uint64_t> codirectionalMask(const Vec3Arrays<const double> &a, const Vec3Arrays<const double> &b,
+                                                   double tolerance = COLLINEAR_TOLERANCE) {
+        return detail::collinearMask(a, b, tolerance, true);
+    }
+
+}// namespace task
@@ -0,0 +1,216 @@
+#pragma once
+
+#include "vector_kernels.h"
+#include "vector_parallel.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+
+namespace task {
+
+    // Parallel passes split vectors into pieces of this many elements, and dot products sum them
+    // separately.
+    const size_t VECTOR_CHUNK = 1 << 14;
+
+    // Expressions are evaluated in spans of at most VECTOR_BLOCK elements, so intermediate results
+    // live in small stack buffers instead of full-size temporaries.
+    const size_t VECTOR_BLOCK = 256;
+
+    template<class E>
+    class VectorExpr {
+    public:
+        const E &self() const {
+            return static_cast<const E &>(*this);
+        }
+
+        size_t size() const {
+            return self().size();
+        }
+
+        // Pointer to elements [begin, begin + len), either stored in the operand itself or written
+        // into buffer, which holds at least len elements.
+        const double *span(size_t begin, size_t len, double *buffer) const {
+            return self().span(begin, len, buffer);
+        }
+
+        bool refersTo(const std::vector<double> &vec) const {
+            return self().refersTo(vec);
+        }
+
+        // Evaluates the whole expression in one pass into a new vector.
+        operator std::vector<double>() const;
+    };
+
+    // A std::vector<double> operand, captured by reference.
+    class VectorRef : public VectorExpr<VectorRef> {
+    public:
+        VectorRef(const std::vector<double> &vec) : vec(vec) {}
+
+        size_t size() const {
+            return vec.size();
+        }
+
+        const double *span(size_t begin, size_t, double *) const {
+            return vec.data() + begin;
+        }
+
+        bool refersTo(const std::vector<double> &other) const {
+            return &vec == &other;
+        }
+
+    private:
+        const std::vector<double> &vec;
+    };
+
+    template<class E>
+    class VectorScaled : public VectorExpr<VectorScaled<E>> {
+    public:
+        VectorScaled(const E &inner, double factor) : inner(inner), factor(factor) {}
+
+        size_t size() const {
+            return inner.size();
+        }
+
+        const double *span(size_t begin, size_t len, double *buffer) const {
+            vectorKernels().scale(buffer, inner.span(begin, len, buffer), factor, len);
+            return buffer;
+        }
+
+        bool refersTo(const std::vector<double> &vec) const {
+            return inner.refersTo(vec);
+        }
+
+        const E &operand() const {
+            return inner;
+        }
+
+        double getFactor() const {
+            return factor;
+        }
+
+    private:
+        E inner;
+        double factor;
+    };
+
+    template<class E>
+    struct IsScaled : std::false_type {};
+
+    template<class E>
+    struct IsScaled<VectorScaled<E>> : std::true_type {};
+
+
+    // a + b, or a single axpy pass when b is a scaled operand.
+    template<class L, class R>
+    class VectorSum : public VectorExpr<VectorSum<L, R>> {
+    public:
+        VectorSum(const L &left, const R &right) : left(left), right(right) {}
+
+        size_t size() const {
+            return left.size();
+        }
+
+        const double *span(size_t begin, size_t len, double *buffer) const {
+            double scratch[VECTOR_BLOCK];
+            const double *l = left.span(begin, len, buffer);
+            if constexpr (IsScaled<R>::value) {
+                const double *x = right.operand().span(begin, len, scratch);
+                vectorKernels().axpy(buffer, l, right.getFactor(), x, len);
+            } else {
+                vectorKernels().add(buffer, l, right.span(begin, len, scratch), len);
+            }
+            return buffer;
+        }
+
+        bool refersTo(const std::vector<double> &vec) const {
+            return left.refersTo(vec) || right.refersTo(vec);
+        }
+
+    private:
+        L left;
+        R right;
+    };
+
+    // a - b, or a single axpy pass when b is a scaled operand.
+    template<class L, class R>
+    class VectorDifference : public VectorExpr<VectorDifference<L, R>> {
+    public:
+        VectorDifference(const L &left, const R &right) : left(left), right(right) {}
+
+        size_t size() const {
+            return left.size();
+        }
+
+        const double *span(size_t begin, size_t len, double *buffer) const {
+            double scratch[VECTOR_BLOCK];
+            const double *l = left.span(begin, len, buffer);
+            if constexpr (IsScaled<R>::value) {
+                const double *x = right.operand().span(begin, len, scratch);
+                vectorKernels().axpy(buffer, l, -right.getFactor(), x, len);
+            } else {
+                vectorKernels().sub(buffer, l, right.span(begin, len, scratch), len);
+            }
+            return buffer;
+        }
+
+        bool refersTo(const std::vector<double> &vec) const {
+            return left.refersTo(vec) || right.refersTo(vec);
+        }
+
+    private:
+        L left;
+        R right;
+    };
+
+
+    // The expression node a vector or an expression takes part in other expressions as.
+    template<class T>
+    struct VectorOperand {
+        using type = T;
+    };
+
+    template<>
+    struct VectorOperand<std::vector<double>> {
+        using type = VectorRef;
+    };
+
+    template<class T>
+    constexpr bool isVectorExpr = std::is_base_of<VectorExpr<T>, T>::value;
+
+    template<class T>
+    constexpr bool isVectorOperand = isVectorExpr<T> || std::is_same<T, std::vector<double>>::value;
+
+    namespace detail {
+
+        // Calls store(dst + begin, values, len) for consecutive spans of expr, in parallel for long
+        // vectors. Spans are computed in dst itself when direct, in a stack buffer otherwise.
+        template<class E, class Store>
+        void evaluate(const VectorExpr<E> &expr, double *dst, bool direct, Store store) {
+            parallelFor(expr.size(), VECTOR_CHUNK, [&](size_t begin, size_t end) {
+                double buffer[VECTOR_BLOCK];
+                for (size_t i = begin; i < end; i += VECTOR_BLOCK) {
+                    size_t len = std::min(VECTOR_BLOCK, end - i);
+                    store(dst + i, expr.span(i, len, direct ? dst + i : buffer), len);
+                }
+            });
+        }
+
+        inline void copySpan(double *dst, const double *src, size_t len) {
+            if (src != dst) {
+                std::copy_n(src, len, dst);
+            }
+        }
+
+    }// namespace detail
+
+    template<class E>
+    VectorExpr<E>::operator std::vector<double>() const {
+        std::vector<double> result(size());
+        detail::evaluate(*this, result.data(), true, detail::copySpan);
+        return result;
+    }
+
+}// namespace task
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <ios>
+#include <istream>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+
+namespace task {
+
+    // Size of the buffer text output is formatted into before it is handed to the stream.
+    const size_t VECTOR_IO_BUFFER = 1 << 14;
+
+    namespace detail {
+
+        // The get area of a stream buffer, so that numbers are parsed where they lie instead of
+        // being extracted one character at a time.
+        struct GetArea : std::streambuf {
+            static const char *begin(std::streambuf *buf) {
+                return (buf->*&GetArea::gptr)();
+            }
+
+            static const char *end(std::streambuf *buf) {
+                return (buf->*&GetArea::egptr)();
+            }
+
+            static void advance(std::streambuf *buf, size_t count) {
+                (buf->*&GetArea::gbump)(int(count));
+            }
+        };
+
+        inline bool isSpace(int c) {
+            return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+        }
+
+        inline bool parseDouble(const char *begin, const char *end, double &value) {
+            if (begin != end && *begin == '+') {
+                ++begin;
+            }
+            auto [ptr, ec] = std::from_chars(begin, end, value);
+            return ec == std::errc() && ptr == end;
+        }
+
+        // Reads a number character by character, for one that runs past the end of the get area or
+        // a stream buffer without one.
+        inline bool readSplitDouble(std::streambuf *buf, double &value, std::ios_base::iostate &state) {
+            std::string token;
+            int c = buf->sgetc();
+            while (c != std::char_traits<char>::eof() && !isSpace(c)) {
+                token += char(c);
+                c = buf->snextc();
+            }
+            if (c == std::char_traits<char>::eof()) {
+                state |= std::ios_base::eofbit;
+            }
+            return parseDouble(token.data(), token.data() + token.size(), value);
+        }
+
+        // Reads count whitespace separated numbers into values. Returns the stream state to set:
+        // failbit if fewer numbers could be read, eofbit if the input ran out.
+        inline std::ios_base::iostate readDoubles(std::streambuf *buf, double *values, size_t count) {
+            std::ios_base::iostate state = std::ios_base::goodbit;
+            for (size_t i = 0; i < count;) {
+                const char *p = GetArea::begin(buf), *e = GetArea::end(buf);
+                if (p == e) {
+                    int c = buf->sgetc();
+                    if (c == std::char_traits<char>::eof()) {
+                        return state | std::ios_base::eofbit | std::ios_base::failbit;
+                    }
+                    if (GetArea::begin(buf) != GetArea::end(buf)) {
+                        continue;
+                    }
+                    // An unbuffered stream, such as std::cin synchronized with stdio, never fills
+                    // its get area: take its characters one by one.
+                    if (isSpace(c)) {
+                        buf->sbumpc();
+                        continue;
+                    }
+                    if (!readSplitDouble(buf, values[i], state)) {
+                        return state | std::ios_base::failbit;
+                    }
+                    ++i;
+                    continue;
+                }
+                const char *token = std::find_if(p, e, [](char c) { return !isSpace(c); });
+                const char *tokenEnd = std::find_if(token, e, isSpace);
+                if (token == e) {
+                    GetArea::advance(buf, e - p);
+                    continue;
+                }
+                GetArea::advance(buf, token - p);
+                if (tokenEnd == e) {
+                    if (!readSplitDouble(buf, values[i], state)) {
+                        return state | std::ios_base::failbit;
+                    }
+                } else {
+                    if (!parseDouble(token, tokenEnd, values[i])) {
+                        return state | std::ios_base::failbit;
+                    }
+                    GetArea::advance(buf, tokenEnd - token);
+                }
+                ++i;
+            }
+            return state;
+        }
+
+        // Whether to_chars() writes a double as the stream would: it has no hexfloat prefix, sign,
+        // case or padding options.
+        inline bool charsFormatMatches(const std::ostream &stream) {
+            std::ios_base::fmtflags flags = stream.flags();
+            return (flags & std::ios_base::floatfield) != std::ios_base::floatfield &&
+                   !(flags & (std::ios_base::showpos | std::ios_base::showpoint | std::ios_base::uppercase)) &&
+                   stream.width() == 0;
+        }
+
+        // Writes each value followed by a space, then a newline, as operator<< of the stream would
+        // format them, without flushing.
+        inline void writeDoubles(std::ostream &stream, const double *values, size_t count) {
+            if (!charsFormatMatches(stream)) {
+                for (size_t i = 0; i < count; ++i) {
+                    stream << values[i] << ' ';
+                }
+                stream << '\n';
+                return;
+            }
+            std::ios_base::fmtflags floatfield = stream.flags() & std::ios_base::floatfield;
+            std::chars_format format = floatfield == std::ios_base::fixed        ? std::chars_format::fixed
+                                       : floatfield == std::ios_base::scientific ? std::chars_format::scientific
+                                                                                 : std::chars_format::general;
+            int precision = int(stream.precision());
+            char buffer[VECTOR_IO_BUFFER];
+            size_t used = 0;
+            for (size_t i = 0; i < count;) {
+                auto [ptr, ec] = std::to_chars(buffer + used, buffer + VECTOR_IO_BUFFER - 1, values[i], format, precision);
+                if (ec != std::errc() && used == 0) {
+                    // Too long for the whole buffer, as at a very high precision: the stream
+                    // formats it instead.
+                    stream << values[i] << ' ';
+                    ++i;
+                    continue;
+                }
+                if (ec != std::errc()) {
+                    stream.write(buffer, used);
+                    used = 0;
+                    continue;
+                }
+                used = ptr - buffer;
+                buffer[used++] = ' ';
+                ++i;
+            }
+            if (used == VECTOR_IO_BUFFER) {
+                stream.write(buffer, used);
+                used = 0;
+            }
+            buffer[used++] = '\n';
+            stream.write(buffer, used);
+        }
+
+    }// namespace detail
+
+    // Writes the size and then the raw doubles, in the byte order of this machine. The stream
+    // should be opened in binary mode.
+    inline std::ostream &writeBinary(std::ostream &stream, const std::vector<double> &a) {
+        uint64_t size = a.size();
+        stream.write(reinterpret_cast<const char *>(&size), sizeof(size));
+        stream.write(reinterpret_cast<const char *>(a.data()), std::streamsize(a.size() * sizeof(double)));
+        return stream;
+    }
+
+    // Reads what writeBinary() wrote. The vector grows as data arrives, so a damaged size fails
+    // at the end of the stream instead of allocating it up front.
+    inline std::istream &readBinary(std::istream &stream, std::vector<double> &a) {
+        const size_t step = 1 << 16;
+        uint64_t size = 0;
+        if (!stream.read(reinterpret_cast<char *>(&size), sizeof(size))) {
+            return stream;
+        }
+        a.clear();
+        while (a.size() < size) {
+            size_t done = a.size(), count = std::min<uint64_t>(step, size - done);
+            a.resize(done + count);
+            if (!stream.read(reinterpret_cast<char *>(a.data() + done), std::streamsize(count * sizeof(double)))) {
+                a.resize(done + stream.gcount() / sizeof(double));
+                return stream;
+            }
+        }
+        return stream;
+    }
+
+}// namespace task
@@ -0,0 +1,300 @@
+#pragma once
+
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define VECTOR_X86 1
+#include <immintrin.h>
+#endif
+
+
+namespace task {
+
+    enum class SimdLevel {
+        SCALAR,
+        AVX2,
+        AVX512
+    };
+
+    struct VectorKernels {
+        // dst[i] = a[i] + b[i]; dst may be a or b.
+        void (*add)(double *dst, const double *a, const double *b, size_t n);
+
+        // dst[i] = a[i] - b[i]; dst may be a or b.
+        void (*sub)(double *dst, const double *a, const double *b, size_t n);
+
+        // dst[i] = factor * a[i]; dst may be a.
+        void (*scale)(double *dst, const double *a, double factor, size_t n);
+
+        // dst[i] = a[i] + alpha * x[i]; dst may be a or x.
+        void (*axpy)(double *dst, const double *a, double alpha, const double *x, size_t n);
+
+        // a[0] * b[0] + ... + a[n - 1] * b[n - 1], with a fixed summation order for a given n.
+        double (*dot)(const double *a, const double *b, size_t n);
+    };
+
+    namespace detail {
+
+        inline void addScalar(double *dst, const double *a, const double *b, size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                dst[i] = a[i] + b[i];
+            }
+        }
+
+        inline void subScalar(double *dst, const double *a, const double *b, size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                dst[i] = a[i] - b[i];
+            }
+        }
+
+        inline void scaleScalar(double *dst, const double *a, double factor, size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                dst[i] = factor * a[i];
+            }
+        }
+
+        inline void axpyScalar(double *dst, const double *a, double alpha, const double *x, size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                dst[i] = a[i] + alpha * x[i];
+            }
+        }
+
+        // Four independent sums hide the latency of the additions.
+        inline double dotScalar(const double *a, const double *b, size_t n) {
+            double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+            size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                s0 += a[i] * b[i];
+                s1 += a[i + 1] * b[i + 1];
+                s2 += a[i + 2] * b[i + 2];
+                s3 += a[i + 3] * b[i + 3];
+            }
+            for (; i < n; ++i) {
+                s0 += a[i] * b[i];
+            }
+            return (s0 + s2) + (s1 + s3);
+        }
+
+#ifdef VECTOR_X86
+
+        __attribute__((target("avx2"))) inline void addAvx2(double *dst, const double *a, const double *b, size_t n) {
+            size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                __m256d x0 = _mm256_add_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i));
+                __m256d x1 = _mm256_add_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4));
+                _mm256_storeu_pd(dst + i, x0);
+                _mm256_storeu_pd(dst + i + 4, x1);
+            }
+            for (; i < n; ++i) {
+                dst[i] = a[i] + b[i];
+            }
+        }
+
+        __attribute__((target("avx2"))) inline void subAvx2(double *dst, const double *a, const double *b, size_t n) {
+            size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                __m256d x0 = _mm256_sub_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i));
+                __m256d x1 = _mm256_sub_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4));
+                _mm256_storeu_pd(dst + i, x0);
+                _mm256_storeu_pd(dst + i + 4, x1);
+            }
+            for (; i < n; ++i) {
+                dst[i] = a[i] - b[i];
+            }
+        }
+
+        __attribute__((target("avx2"))) inline void scaleAvx2(double *dst, const double *a, double factor, size_t n) {
+            __m256d f = _mm256_set1_pd(factor);
+            size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                __m256d x0 = _mm256_mul_pd(_mm256_loadu_pd(a + i), f);
+                __m256d x1 = _mm256_mul_pd(_mm256_loadu_pd(a + i + 4), f);
+                _mm256_storeu_pd(dst + i, x0);
+                _mm256_storeu_pd(dst + i + 4, x1);
+            }
+            for (; i < n; ++i) {
+                dst[i] = factor * a[i];
+            }
+        }
+
+        __attribute__((target("avx2"))) inline void axpyAvx2(double *dst, const double *a, double alpha, const double *x, size_t n) {
+            __m256d f = _mm256_set1_pd(alpha);
+            size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                __m256d x0 = _mm256_add_pd(_mm256_loadu_pd(a + i), _mm256_mul_pd(f, _mm256_loadu_pd(x + i)));
+                __m256d x1 = _mm256_add_pd(_mm256_loadu_pd(a + i + 4), _mm256_mul_pd(f, _mm256_loadu_pd(x + i + 4)));
+                _mm256_storeu_pd(dst + i, x0);
+                _mm256_storeu_pd(dst + i + 4, x1);
+            }
+            for (; i < n; ++i) {
+                dst[i] = a[i] + alpha * x[i];
+            }
+        }
+
+        __attribute__((target("avx2,fma"))) inline double dotAvx2(const double *a, const double *b, size_t n) {
+            __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+            __m256d s2 = _mm256_setzero_pd(), s3 = _mm256_setzero_pd();
+            size_t i = 0;
+            for (; i + 16 <= n; i += 16) {
+                s0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), s0);
+                s1 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4), s1);
+                s2 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 8), _mm256_loadu_pd(b + i + 8), s2);
+                s3 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 12), _mm256_loadu_pd(b + i + 12), s3);
+            }
+            __m256d s = _mm256_add_pd(_mm256_add_pd(s0, s2), _mm256_add_pd(s1, s3));
+            __m128d h = _mm_add_pd(_mm256_castpd256_pd128(s), _mm256_extractf128_pd(s, 1));
+            double result = _mm_cvtsd_f64(_mm_add_sd(h, _mm_unpackhi_pd(h, h)));
+            for (; i < n; ++i) {
+                result += a[i] * b[i];
+            }
+            return result;
+        }
+
+        __attribute__((target("avx512f"))) inline void addAvx512(double *dst, const double *a, const double *b, size_t n) {
+            size_t i = 0;
+            for (; i + 16 <= n; i += 16) {
+                __m512d x0 = _mm512_add_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i));
+                __m512d x1 = _mm512_add_pd(_mm512_loadu_pd(a + i + 8), _mm512_loadu_pd(b + i + 8));
+                _mm512_storeu_pd(dst + i, x0);
+                _mm512_storeu_pd(dst + i + 8, x1);
+            }
+            for (; i + 8 <= n; i += 8) {
+                _mm512_storeu_pd(dst + i, _mm512_add_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i)));
+            }
+            if (i < n) {
+                __mmask8 tail = __mmask8((1u << (n - i)) - 1);
+                __m512d x = _mm512_add_pd(_mm512_maskz_loadu_pd(tail, a + i), _mm512_maskz_loadu_pd(tail, b + i));
+                _mm512_mask_storeu_pd(dst + i, tail, x);
+            }
+        }
+
+        __attribute__((target("avx512f"))) inline void subAvx512(double *dst, const double *a, const double *b, size_t n) {
+            size_t i = 0;
+            for (; i + 16 <= n; i += 16) {
+                __m512d x0 = _mm512_sub_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i));
+                __m512d x1 = _mm512_sub_pd(_mm512_loadu_pd(a + i + 8), _mm512_loadu_pd(b + i + 8));
+                _mm512_storeu_pd(dst + i, x0);
+                _mm512_storeu_pd(dst + i + 8, x1);
+            }
+            for (; i + 8 <= n; i += 8) {
+                _mm512_storeu_pd(dst + i, _mm512_sub_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i)));
+            }
+            if (i < n) {
+                __mmask8 tail = __mmask8((1u << (n - i)) - 1);
+                __m512d x = _mm512_sub_pd(_mm512_maskz_loadu_pd(tail, a + i), _mm512_maskz_loadu_pd(tail, b + i));
+                _mm512_mask_storeu_pd(dst + i, tail, x);
+            }
+        }
+
+        __attribute__((target("avx512f"))) inline void scaleAvx512(double *dst, const double *a, double factor, size_t n) {
+            __m512d f = _mm512_set1_pd(factor);
+            size_t i = 0;
+            for (; i + 16 <= n; i += 16) {
+                __m512d x0 = _mm512_mul_pd(_mm512_loadu_pd(a + i), f);
+                __m512d x1 = _mm512_mul_pd(_mm512_loadu_pd(a + i + 8), f);
+                _mm512_storeu_pd(dst + i, x0);
+                _mm512_storeu_pd(dst + i + 8, x1);
+            }
+            for (; i < n; ++i) {
+                dst[i] = factor * a[i];
+            }
+        }
+
+        __attribute__((target("avx512f"))) inline void axpyAvx512(double *dst, const double *a, double alpha, const double *x, size_t n) {
+            __m512d f = _mm512_set1_pd(alpha);
+            size_t i = 0;
+            for (; i + 16 <= n; i += 16) {
+                __m512d x0 = _mm512_add_pd(_mm512_loadu_pd(a + i), _mm512_mul_pd(f, _mm512_loadu_pd(x + i)));
+                __m512d x1 = _mm512_add_pd(_mm512_loadu_pd(a + i + 8), _mm512_mul_pd(f, _mm512_loadu_pd(x + i + 8)));
+                _mm512_storeu_pd(dst + i, x0);
+                _mm512_storeu_pd(dst + i + 8, x1);
+            }
+            for (; i < n; ++i) {
+                dst[i] = a[i] + alpha * x[i];
+            }
+        }
+
+        __attribute__((target("avx512f"))) inline double dotAvx512(const double *a, const double *b, size_t n) {
+            __m512d s0 = _mm512_setzero_pd(), s1 = _mm512_setzero_pd();
+            __m512d s2 = _mm512_setzero_pd(), s3 = _mm512_setzero_pd();
+            size_t i = 0;
+            for (; i + 32 <= n; i += 32) {
+                s0 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i), s0);
+                s1 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i + 8), _mm512_loadu_pd(b + i + 8), s1);
+                s2 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i + 16), _mm512_loadu_pd(b + i + 16), s2);
+                s3 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i + 24), _mm512_loadu_pd(b + i + 24), s3);
+            }
+            for (; i + 8 <= n; i += 8) {
+                s0 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i), s0);
+            }
+            if (i < n) {
+                __mmask8 tail = __mmask8((1u << (n - i)) - 1);
+                s1 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(tail, a + i), _mm512_maskz_loadu_pd(tail, b + i), s1);
+            }
+            return _mm512_reduce_add_pd(_mm512_add_pd(_mm512_add_pd(s0, s2), _mm512_add_pd(s1, s3)));
+        }
+
+#endif
+
+        inline SimdLevel detectSimdLevel() {
+#ifdef VECTOR_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f")) {
+                return SimdLevel::AVX512;
+            }
+            if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+                return SimdLevel::AVX2;
+            }
+#endif
+            return SimdLevel::SCALAR;
+        }
+
+        inline SimdLevel &currentLevel() {
+            static SimdLevel level = detectSimdLevel();
+            return level;
+        }
+
+    }// namespace detail
+
+    inline SimdLevel simdLevel() {
+        return detail::currentLevel();
+    }
+
+    // Selects the kernel set, clamped to what the CPU supports. Not thread-safe.
+    inline void setSimdLevel(SimdLevel level) {
+        SimdLevel supported = detail::detectSimdLevel();
+        detail::currentLevel() = (level > supported ? supported : level);
+    }
+
+    inline const char *simdLevelName(SimdLevel level) {
+        switch (level) {
+            case SimdLevel::AVX2:
+                return "avx2";
+            case SimdLevel::AVX512:
+                return "avx512";
+            default:
+                return "scalar";
+        }
+    }
+
+    inline const VectorKernels &vectorKernels() {
+        static const VectorKernels SCALAR = {detail::addScalar, detail::subScalar, detail::scaleScalar,
+                                             detail::axpyScalar, detail::dotScalar};
+#ifdef VECTOR_X86
+        static const VectorKernels AVX2 = {detail::addAvx2, detail::subAvx2, detail::scaleAvx2, detail::axpyAvx2,
+                                           detail::dotAvx2};
+        static const VectorKernels AVX512 = {detail::addAvx512, detail::subAvx512, detail::scaleAvx512,
+                                             detail::axpyAvx512, detail::dotAvx512};
+        switch (simdLevel()) {
+            case SimdLevel::AVX2:
+                return AVX2;
+            case SimdLevel::AVX512:
+                return AVX512;
+            default:
+                break;
+        }
+#endif
+        return SCALAR;
+    }
+
+}// namespace task
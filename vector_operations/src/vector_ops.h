@@ -1,11 +1,22 @@
 #pragma once
 
+#include "bit_kernels.h"
+#include "vector_expr.h"
+#include "vector_io.h"
+#include "vector_kernels.h"
+#include "vector_parallel.h"
+
+#include <algorithm>
+#include <exception>
 #include <iostream>
+#include <type_traits>
 #include <vector>
 
 
 namespace task {
 
+    class SizeMismatchException : public std::exception {};
+
     double abs(const double &a) {
         return (a >= 0 ? a : -a);
     }
@@ -14,64 +25,148 @@ namespace task {
         return abs(a - b) <= 1e-7;
     }
 
-    std::vector<double> &operator+=(std::vector<double> &a, const std::vector<double> &b) {
-        for (int i = 0; i < a.size(); ++i) {
-            a[i] += b[i];
+    template<class L, class R>
+    void checkSize(const L &a, const R &b) {
+        if (a.size() != b.size()) {
+            throw SizeMismatchException();
         }
-        return a;
     }
 
-    std::vector<double> operator+(const std::vector<double> &a, const std::vector<double> &b) {
-        std::vector<double> c = a;
-        c += b;
+    std::vector<double> &operator+=(std::vector<double> &a, const std::vector<double> &b) {
+        checkSize(a, b);
+        const VectorKernels &k = vectorKernels();
+        parallelFor(a.size(), VECTOR_CHUNK, [&](size_t begin, size_t end) {
+            k.add(a.data() + begin, a.data() + begin, b.data() + begin, end - begin);
+        });
+        return a;
+    }
 
-        return c;
+    std::vector<double> &operator-=(std::vector<double> &a, const std::vector<double> &b) {
+        checkSize(a, b);
+        const VectorKernels &k = vectorKernels();
+        parallelFor(a.size(), VECTOR_CHUNK, [&](size_t begin, size_t end) {
+            k.sub(a.data() + begin, a.data() + begin, b.data() + begin, end - begin);
+        });
+        return a;
     }
 
-    std::vector<double> operator+(const std::vector<double> &a) {
-        std::vector<double> c(a.size());
+    template<class E>
+    std::vector<double> &operator+=(std::vector<double> &a, const VectorExpr<E> &expr) {
+        checkSize(a, expr);
+        const VectorKernels &k = vectorKernels();
+        detail::evaluate(expr, a.data(), false, [&k](double *dst, const double *src, size_t len) {
+            k.add(dst, dst, src, len);
+        });
+        return a;
+    }
 
-        for (int i = 0; i < a.size(); ++i) {
-            c[i] = a[i];
-        }
+    template<class E>
+    std::vector<double> &operator-=(std::vector<double> &a, const VectorExpr<E> &expr) {
+        checkSize(a, expr);
+        const VectorKernels &k = vectorKernels();
+        detail::evaluate(expr, a.data(), false, [&k](double *dst, const double *src, size_t len) {
+            k.sub(dst, dst, src, len);
+        });
+        return a;
+    }
 
-        return c;
+    // +, - and scaling build lazy expressions over std::vector<double> operands, which are
+    // captured by reference and must outlive the expression. An expression is evaluated in a
+    // single pass when it is converted to std::vector<double>, assigned with assign(), or used
+    // in +=, -= or a dot product.
+    template<class L, class R, class = std::enable_if_t<isVectorOperand<L> && isVectorOperand<R>>>
+    VectorSum<typename VectorOperand<L>::type, typename VectorOperand<R>::type> operator+(const L &a, const R &b) {
+        checkSize(a, b);
+        return {a, b};
     }
 
-    std::vector<double> operator-(const std::vector<double> &a) {
-        std::vector<double> c(a.size());
+    template<class L, class R, class = std::enable_if_t<isVectorOperand<L> && isVectorOperand<R>>>
+    VectorDifference<typename VectorOperand<L>::type, typename VectorOperand<R>::type> operator-(const L &a, const R &b) {
+        checkSize(a, b);
+        return {a, b};
+    }
 
-        for (int i = 0; i < a.size(); ++i) {
-            c[i] = -a[i];
-        }
+    template<class E, class = std::enable_if_t<isVectorOperand<E>>>
+    typename VectorOperand<E>::type operator+(const E &a) {
+        return a;
+    }
 
-        return c;
+    template<class E, class = std::enable_if_t<isVectorOperand<E>>>
+    VectorScaled<typename VectorOperand<E>::type> operator-(const E &a) {
+        return {a, -1.};
     }
 
-    std::vector<double> operator-(const std::vector<double> &a, const std::vector<double> &b) {
-        std::vector<double> c(a.size());
+    template<class E, class = std::enable_if_t<isVectorOperand<E>>>
+    VectorScaled<typename VectorOperand<E>::type> operator*(double factor, const E &a) {
+        return {a, factor};
+    }
 
-        for (int i = 0; i < a.size(); ++i) {
-            c[i] = a[i] - b[i];
-        }
+    template<class E, class = std::enable_if_t<isVectorOperand<E>>>
+    VectorScaled<typename VectorOperand<E>::type> operator*(const E &a, double factor) {
+        return {a, factor};
+    }
 
-        return c;
+    // dst = expr without a temporary: dst's storage is reused, and written directly unless expr
+    // reads dst itself.
+    template<class E>
+    std::vector<double> &assign(std::vector<double> &dst, const VectorExpr<E> &expr) {
+        dst.resize(expr.size());
+        detail::evaluate(expr, dst.data(), !expr.refersTo(dst), detail::copySpan);
+        return dst;
     }
 
-    std::vector<double> &operator-=(std::vector<double> &a, const std::vector<double> &b) {
-        for (int i = 0; i < a.size(); ++i) {
-            a[i] -= b[i];
-        }
-        return a;
+    // y += alpha * x in one pass.
+    std::vector<double> &axpy(double alpha, const std::vector<double> &x, std::vector<double> &y) {
+        checkSize(x, y);
+        const VectorKernels &k = vectorKernels();
+        parallelFor(y.size(), VECTOR_CHUNK, [&](size_t begin, size_t end) {
+            k.axpy(y.data() + begin, y.data() + begin, alpha, x.data() + begin, end - begin);
+        });
+        return y;
     }
 
+    // Every VECTOR_CHUNK elements are summed on their own and the chunk sums added in order,
+    // so the result does not depend on the number of threads.
     double operator*(const std::vector<double> &a, const std::vector<double> &b) {
+        checkSize(a, b);
+        size_t chunks = (a.size() + VECTOR_CHUNK - 1) / VECTOR_CHUNK;
+        std::vector<double> partial(chunks);
+        const VectorKernels &k = vectorKernels();
+        parallelFor(a.size(), VECTOR_CHUNK, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i += VECTOR_CHUNK) {
+                partial[i / VECTOR_CHUNK] = k.dot(a.data() + i, b.data() + i, std::min(VECTOR_CHUNK, end - i));
+            }
+        });
         double c = 0;
-
-        for (int i = 0; i < a.size(); ++i) {
-            c += a[i] * b[i];
+        for (double s : partial) {
+            c += s;
         }
+        return c;
+    }
 
+    // Dot product with an expression operand, evaluated span by span without a temporary.
+    template<class L, class R, class = std::enable_if_t<isVectorOperand<L> && isVectorOperand<R> && (isVectorExpr<L> || isVectorExpr<R>)>>
+    double operator*(const L &a, const R &b) {
+        checkSize(a, b);
+        typename VectorOperand<L>::type left = a;
+        typename VectorOperand<R>::type right = b;
+        std::vector<double> partial((a.size() + VECTOR_CHUNK - 1) / VECTOR_CHUNK);
+        const VectorKernels &k = vectorKernels();
+        parallelFor(a.size(), VECTOR_CHUNK, [&](size_t begin, size_t end) {
+            double x[VECTOR_BLOCK], y[VECTOR_BLOCK];
+            for (size_t i = begin; i < end; i += VECTOR_CHUNK) {
+                double s = 0;
+                for (size_t j = i; j < std::min(end, i + VECTOR_CHUNK); j += VECTOR_BLOCK) {
+                    size_t len = std::min(VECTOR_BLOCK, end - j);
+                    s += k.dot(left.span(j, len, x), right.span(j, len, y), len);
+                }
+                partial[i / VECTOR_CHUNK] = s;
+            }
+        });
+        double c = 0;
+        for (double s : partial) {
+            c += s;
+        }
         return c;
     }
 
@@ -128,41 +223,79 @@ namespace task {
         }
     }
 
-    std::vector<int> operator|(const std::vector<int> &a, const std::vector<int> &b) {
-        std::vector<int> c(a.size());
+    namespace detail {
 
-        for (int i = 0; i < a.size(); ++i) {
-            c[i] = a[i] | b[i];
+        void combineBits(BitOp op, std::vector<int> &dst, const std::vector<int> &a, const std::vector<int> &b) {
+            checkSize(a, b);
+            dst.resize(a.size());
+            parallelFor(a.size(), VECTOR_CHUNK, [&](size_t begin, size_t end) {
+                bitwise(op, dst.data() + begin, a.data() + begin, b.data() + begin, end - begin);
+            });
         }
 
+    }// namespace detail
+
+    std::vector<int> &operator|=(std::vector<int> &a, const std::vector<int> &b) {
+        detail::combineBits(BitOp::OR, a, a, b);
+        return a;
+    }
+
+    std::vector<int> &operator&=(std::vector<int> &a, const std::vector<int> &b) {
+        detail::combineBits(BitOp::AND, a, a, b);
+        return a;
+    }
+
+    std::vector<int> &operator^=(std::vector<int> &a, const std::vector<int> &b) {
+        detail::combineBits(BitOp::XOR, a, a, b);
+        return a;
+    }
+
+    // a &= ~b: clears in a the bits set in b.
+    std::vector<int> &andNotAssign(std::vector<int> &a, const std::vector<int> &b) {
+        detail::combineBits(BitOp::AND_NOT, a, a, b);
+        return a;
+    }
+
+    std::vector<int> operator|(const std::vector<int> &a, const std::vector<int> &b) {
+        std::vector<int> c;
+        detail::combineBits(BitOp::OR, c, a, b);
         return c;
     }
 
     std::vector<int> operator&(const std::vector<int> &a, const std::vector<int> &b) {
-        std::vector<int> c(a.size());
+        std::vector<int> c;
+        detail::combineBits(BitOp::AND, c, a, b);
+        return c;
+    }
 
-        for (int i = 0; i < a.size(); ++i) {
-            c[i] = a[i] & b[i];
-        }
+    std::vector<int> operator^(const std::vector<int> &a, const std::vector<int> &b) {
+        std::vector<int> c;
+        detail::combineBits(BitOp::XOR, c, a, b);
+        return c;
+    }
 
+    std::vector<int> andNot(const std::vector<int> &a, const std::vector<int> &b) {
+        std::vector<int> c;
+        detail::combineBits(BitOp::AND_NOT, c, a, b);
         return c;
     }
 
+    // Reads the size and then that many numbers, parsing them straight from the stream buffer.
     std::istream &operator>>(std::istream &stream, std::vector<double> &a) {
         int n;
         stream >> n;
-        a = std::vector<double>(n);
-        for (int i = 0; i < n; ++i) {
-            stream >> a[i];
+        if (!stream || n < 0) {
+            stream.setstate(std::ios_base::failbit);
+            return stream;
         }
+        a.resize(n);
+        stream.setstate(detail::readDoubles(stream.rdbuf(), a.data(), a.size()));
         return stream;
     }
 
+    // Writes the numbers space separated on one line. The stream is not flushed.
     std::ostream &operator<<(std::ostream &cout, const std::vector<double> &a) {
-        for (int i = 0; i < a.size(); ++i) {
-            cout << a[i] << " ";
-        }
-        cout << std::endl;
+        detail::writeDoubles(cout, a.data(), a.size());
         return cout;
     }
 
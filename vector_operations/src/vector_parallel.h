@@ -0,0 +1,64 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+
+namespace task {
+
+    // Vectors shorter than this many elements are processed on the calling thread: below it,
+    // starting threads costs more than the pass itself.
+    const size_t VECTOR_PARALLEL_THRESHOLD = 1 << 20;
+
+    namespace detail {
+
+        inline std::atomic<size_t> &threadCountSetting() {
+            static std::atomic<size_t> count{0};
+            return count;
+        }
+
+    }// namespace detail
+
+    // Number of threads taking part in operations on long vectors, the calling thread included.
+    // Zero means std::thread::hardware_concurrency().
+    inline void setVectorThreadCount(size_t count) {
+        detail::threadCountSetting() = count;
+    }
+
+    inline size_t vectorThreadCount() {
+        // hardware_concurrency() reads sysfs on every call.
+        static const size_t hardware = std::max<size_t>(1, std::thread::hardware_concurrency());
+        size_t count = detail::threadCountSetting();
+        return count != 0 ? count : hardware;
+    }
+
+    // Splits [0, n) into one contiguous range per thread, each a multiple of grain elements except
+    // the last, and calls body(begin, end) for them. Short ranges run inline.
+    template<class F>
+    void parallelFor(size_t n, size_t grain, const F &body) {
+        if (n < VECTOR_PARALLEL_THRESHOLD) {
+            body(size_t(0), n);
+            return;
+        }
+        size_t threads = std::min(vectorThreadCount(), (n + grain - 1) / grain);
+        if (threads <= 1) {
+            body(size_t(0), n);
+            return;
+        }
+        size_t chunk = ((n + grain - 1) / grain + threads - 1) / threads * grain;
+        std::vector<std::thread> workers;
+        for (size_t begin = chunk; begin < n; begin += chunk) {
+            workers.emplace_back([&body, begin, end = std::min(n, begin + chunk)] {
+                body(begin, end);
+            });
+        }
+        body(size_t(0), std::min(n, chunk));
+        for (std::thread &worker : workers) {
+            worker.join();
+        }
+    }
+
+}// namespace task
@@ -5,7 +5,11 @@
 #include <vector>
 #include <valarray>
 #include <sstream>
+#include <iomanip>
 #include <cmath>
+#include "src/bitset.h"
+#include "src/vec3.h"
+#include "src/vector_batch.h"
 #include "src/vector_ops.h"
 
 
@@ -74,6 +78,27 @@ void FailWithMsg(const std::string& msg, int line) {
 const double EPS = 1e-7;
 
 
+// Hands out characters one at a time without ever setting a get area, like std::cin when it is
+// synchronized with stdio.
+class UnbufferedInput : public std::streambuf {
+public:
+    explicit UnbufferedInput(std::string text) : text(std::move(text)) {}
+
+protected:
+    int_type underflow() override {
+        return pos < text.size() ? traits_type::to_int_type(text[pos]) : traits_type::eof();
+    }
+
+    int_type uflow() override {
+        return pos < text.size() ? traits_type::to_int_type(text[pos++]) : traits_type::eof();
+    }
+
+private:
+    std::string text;
+    size_t pos = 0;
+};
+
+
 int main() {
 
     {
@@ -137,8 +162,74 @@ int main() {
         ASSERT_TRUE_MSG(fabs(res - res2) < EPS, "Dot product")
     }
 
+    REPEAT(3)
+    {
+        std::vector<double> vec, vec2;
+        RandomFillDouble(vec, VECTOR_PARALLEL_THRESHOLD + RandomUInt(VECTOR_CHUNK * 4));
+        RandomFillDouble(vec2, vec.size());
+        std::valarray<double> valarr(vec.data(), vec.size()), valarr2(vec2.data(), vec2.size());
+
+        setVectorThreadCount(4);
+        std::vector<double> sum = vec + vec2;
+        double res = vec * vec2;
+        setVectorThreadCount(1);
+
+        valarr += valarr2;
+        ASSERT_EQUAL_MSG(sum, valarr, "Binary + on threads")
+        ASSERT_TRUE_MSG(res == vec * vec2, "Dot product independent of thread count")
+        ASSERT_TRUE_MSG(fabs(res - (std::valarray<double>(vec.data(), vec.size()) * valarr2).sum()) < EPS * vec.size(),
+                        "Dot product on threads")
+
+        vec2.pop_back();
+        bool thrown = false;
+        try {
+            vec += vec2;
+        } catch (const SizeMismatchException &) {
+            thrown = true;
+        }
+        ASSERT_TRUE_MSG(thrown, "Size mismatch")
+    }
+    setVectorThreadCount(0);
+
+    REPEAT(100)
+    {
+        std::vector<double> vec, vec2, vec3;
+        RandomFillDouble(vec, 1000);
+        RandomFillDouble(vec2, vec.size());
+        RandomFillDouble(vec3, vec.size());
+        std::valarray<double> valarr(vec.data(), vec.size()), valarr2(vec2.data(), vec2.size());
+        std::valarray<double> valarr3(vec3.data(), vec3.size());
+
+        std::vector<double> chain = vec + vec2 - vec3;
+        std::valarray<double> expected = valarr + valarr2 - valarr3;
+        ASSERT_EQUAL_MSG(chain, expected, "Fused chain")
+
+        assign(vec, vec2 - vec);
+        valarr = valarr2 - valarr;
+        ASSERT_EQUAL_MSG(vec, valarr, "Assignment reading the destination")
+
+        auto mult = RandomDouble();
+        axpy(mult, vec2, vec);
+        valarr += mult * valarr2;
+        for (size_t i = 0; i < vec.size(); ++i) {
+            ASSERT_TRUE_MSG(fabs(vec[i] - valarr[i]) < EPS, "axpy")
+        }
+
+        vec -= -(vec3 * mult) + vec2;
+        valarr -= -(valarr3 * mult) + valarr2;
+        for (size_t i = 0; i < vec.size(); ++i) {
+            ASSERT_TRUE_MSG(fabs(vec[i] - valarr[i]) < EPS, "Compound assignment of a scaled chain")
+        }
+
+        double res = (vec + vec2) * vec3;
+        double res2 = ((valarr + valarr2) * valarr3).sum();
+        ASSERT_TRUE_MSG(fabs(res - res2) < EPS, "Dot product of an expression")
+    }
+
+    // The bitwise operators and Bitset at each SIMD level in turn.
     REPEAT(100)
     {
+        setSimdLevel(SimdLevel(_iter % 3));
         std::vector<int> vec, vec2;
         RandomFill(vec, 1000);
         std::valarray<int> valarr(vec.data(), vec.size());
@@ -159,6 +250,69 @@ int main() {
         ASSERT_EQUAL_MSG(vec, valarr, "Bitwise AND")
     }
 
+    REPEAT(100)
+    {
+        setSimdLevel(SimdLevel(_iter % 3));
+        size_t count = RandomUInt(0, 3000);
+        std::vector<int> vec, vec2, flags;
+        RandomFill(vec, count);
+        RandomFill(vec2, count);
+        for (size_t i = 0; i < count; ++i) {
+            flags.push_back(TossCoin() ? 0 : int(RandomUInt(1, 100)));
+        }
+        std::valarray<int> valarr(vec.data(), count), valarr2(vec2.data(), count);
+
+        vec ^= vec2;
+        valarr ^= valarr2;
+        ASSERT_EQUAL_MSG(vec, valarr, "Bitwise XOR")
+
+        std::vector<int> cleared = andNot(vec, vec2);
+        std::valarray<int> expected = valarr & ~valarr2;
+        ASSERT_EQUAL_MSG(cleared, expected, "Bitwise AND NOT")
+        andNotAssign(vec, vec2);
+        ASSERT_EQUAL_MSG(vec, expected, "Bitwise AND NOT")
+
+        vec |= vec2;
+        valarr = expected | valarr2;
+        ASSERT_EQUAL_MSG(vec, valarr, "Bitwise OR")
+        vec &= flags;
+        valarr &= std::valarray<int>(flags.data(), count);
+        ASSERT_EQUAL_MSG(vec, valarr, "Bitwise AND")
+
+        Bitset bits(flags), bits2(vec2);
+        ASSERT_TRUE(bits.size() == count)
+        std::vector<int> unpacked = bits.toInts();
+        for (size_t i = 0; i < count; ++i) {
+            ASSERT_TRUE_MSG(bits.test(i) == (flags[i] != 0) && unpacked[i] == (flags[i] != 0), "Bitset conversion")
+        }
+        size_t set = count - std::count(flags.begin(), flags.end(), 0);
+        ASSERT_TRUE_MSG(bits.count() == set, "Bitset popcount")
+
+        Bitset both = bits & bits2, either = bits | bits2, one = bits ^ bits2, only = andNot(bits, bits2);
+        for (size_t i = 0; i < count; ++i) {
+            bool a = flags[i] != 0, b = vec2[i] != 0;
+            ASSERT_TRUE_MSG(both.test(i) == (a && b) && either.test(i) == (a || b) && one.test(i) == (a != b) &&
+                                    only.test(i) == (a && !b),
+                            "Bitset operations")
+        }
+
+        if (count > 0) {
+            size_t i = RandomUInt(count - 1);
+            bits.set(i, !bits.test(i));
+            ASSERT_TRUE_MSG(bits.count() == (flags[i] != 0 ? set - 1 : set + 1), "Bitset set")
+        }
+
+        vec2.push_back(1);
+        bool thrown = false;
+        try {
+            vec |= vec2;
+        } catch (const SizeMismatchException &) {
+            thrown = true;
+        }
+        ASSERT_TRUE_MSG(thrown, "Bitwise operation on vectors of different sizes")
+    }
+    setSimdLevel(detail::detectSimdLevel());
+
     REPEAT(100)
     {
         std::vector<double> vec, vec2;
@@ -178,6 +332,64 @@ int main() {
         ASSERT_TRUE_MSG(fabs(cross * cross - vec[2] * vec[2] * vec2[0] * vec2[0]) < EPS, "Cross product")
     }
 
+    REPEAT(100)
+    {
+        // The batched cross products below at each SIMD level in turn.
+        setSimdLevel(SimdLevel(_iter % 3));
+        std::vector<double> vec, vec2;
+        RandomFillDouble(vec, 3);
+        RandomFillDouble(vec2, vec.size());
+
+        Vec3 a(vec), b(vec2);
+        std::vector<double> cross = a % b, cross2 = vec % vec2;
+        ASSERT_EQUAL_MSG(cross, cross2, "Vec3 cross product")
+        ASSERT_TRUE_MSG(fabs(a * b - vec * vec2) < EPS, "Vec3 dot product")
+
+        std::vector<double> sum = a + vec2, difference = vec - b, mixedCross = a % vec2;
+        std::vector<double> sum2 = vec + vec2, difference2 = vec - vec2;
+        ASSERT_EQUAL_MSG(sum, sum2, "Vec3 + std::vector<double>")
+        ASSERT_EQUAL_MSG(difference, difference2, "std::vector<double> - Vec3")
+        ASSERT_EQUAL_MSG(mixedCross, cross2, "Vec3 % std::vector<double>")
+        ASSERT_TRUE_MSG(fabs(vec * b - vec * vec2) < EPS, "std::vector<double> * Vec3")
+        Vec3 c = a;
+        c += vec2;
+        c -= vec;
+        std::vector<double> assigned;
+        assigned = c;
+        ASSERT_TRUE_MSG(fabs(assigned[0] - vec2[0]) + fabs(assigned[1] - vec2[1]) + fabs(assigned[2] - vec2[2]) < EPS,
+                        "Vec3 += std::vector<double> and assignment to a vector")
+
+        size_t count = RandomUInt(1, 100);
+        std::vector<Vec3> first, second;
+        std::vector<double> ax, ay, az, bx, by, bz, cx(count), cy(count), cz(count);
+        for (size_t i = 0; i < count; ++i) {
+            first.emplace_back(RandomDouble(), RandomDouble(), RandomDouble());
+            second.emplace_back(RandomDouble(), RandomDouble(), RandomDouble());
+            ax.push_back(first[i].x), ay.push_back(first[i].y), az.push_back(first[i].z);
+            bx.push_back(second[i].x), by.push_back(second[i].y), bz.push_back(second[i].z);
+        }
+        std::vector<Vec3> crosses = task::cross(first, second);
+        task::cross(vec3Arrays(ax, ay, az), vec3Arrays(bx, by, bz), vec3Arrays(cx, cy, cz));
+        for (size_t i = 0; i < count; ++i) {
+            Vec3 expected = first[i] % second[i];
+            ASSERT_TRUE_MSG(fabs(crosses[i].x - expected.x) + fabs(crosses[i].y - expected.y) +
+                                    fabs(crosses[i].z - expected.z) < EPS,
+                            "Batched cross product")
+            ASSERT_TRUE_MSG(fabs(cx[i] - expected.x) + fabs(cy[i] - expected.y) + fabs(cz[i] - expected.z) < EPS,
+                            "Batched cross product over coordinate arrays")
+        }
+
+        vec.pop_back();
+        bool thrown = false;
+        try {
+            Vec3 c(vec);
+        } catch (const SizeMismatchException &) {
+            thrown = true;
+        }
+        ASSERT_TRUE_MSG(thrown, "Vec3 from a vector of another size")
+    }
+    setSimdLevel(detail::detectSimdLevel());
+
     REPEAT(100)
     {
         std::vector<double> vec, vec2;
@@ -202,6 +414,41 @@ int main() {
         ASSERT_TRUE_MSG(!(vec && vec2), "Codirectionality operator")
     }
 
+    REPEAT(100)
+    {
+        // Each SIMD level in turn; setSimdLevel() clamps to what the CPU supports.
+        setSimdLevel(SimdLevel(_iter % 3));
+        size_t count = RandomUInt(1, 3000);
+        std::vector<double> ax, ay, az, bx, by, bz;
+        RandomFillDouble(ax, count);
+        RandomFillDouble(ay, count);
+        RandomFillDouble(az, count);
+        std::vector<bool> collinear(count), codirected(count);
+        for (size_t i = 0; i < count; ++i) {
+            if (TossCoin()) {
+                auto mult = RandomDouble();
+                bx.push_back(ax[i] * mult);
+                by.push_back(ay[i] * mult);
+                bz.push_back(az[i] * mult);
+                collinear[i] = true;
+                codirected[i] = mult >= 0;
+            } else {
+                bx.push_back(RandomDouble());
+                by.push_back(RandomDouble());
+                bz.push_back(RandomDouble());
+            }
+        }
+
+        auto a = vec3Arrays(ax, ay, az), b = vec3Arrays(bx, by, bz);
+        auto collinearBits = collinearMask(a, b), codirectedBits = codirectionalMask(a, b);
+        ASSERT_TRUE(collinearBits.size() == (count + 63) / 64)
+        for (size_t i = 0; i < count; ++i) {
+            ASSERT_TRUE_MSG(bool(collinearBits[i / 64] >> (i % 64) & 1) == collinear[i], "Batched collinearity")
+            ASSERT_TRUE_MSG(bool(codirectedBits[i / 64] >> (i % 64) & 1) == codirected[i], "Batched codirectionality")
+        }
+    }
+    setSimdLevel(detail::detectSimdLevel());
+
     REPEAT(100)
     {
         std::vector<double> vec, vec2;
@@ -235,4 +482,71 @@ int main() {
         ASSERT_EQUAL_MSG(vec, vec2, "reverse")
     }
 
+    REPEAT(100)
+    {
+        std::vector<double> vec, vec2;
+        // At least five numbers, more than the four in the tail of the short vector below.
+        RandomFillDouble(vec, RandomUInt(3, 3000));
+        vec.push_back(-1e300);
+        vec.push_back(1e-300);
+
+        std::ostringstream expected, out;
+        for (double value : vec) {
+            expected << value << ' ';
+        }
+        expected << '\n';
+        out << vec;
+        ASSERT_TRUE_MSG(out.str() == expected.str(), "Stream output format")
+
+        std::stringstream stream;
+        stream.precision(17);
+        stream << vec.size() << ' ' << vec << vec.size() << "\n\t+1.5 -2 3e-5";
+        stream.str(stream.str() + "  4.25\n");
+        stream >> vec2;
+        ASSERT_EQUAL_MSG(vec, vec2, "Stream round trip at full precision")
+        stream >> vec2;
+        ASSERT_TRUE_MSG(stream.fail() && stream.eof(), "Stream input of a short vector")
+
+        stream.clear();
+        stream.str("3 1 x 2");
+        stream >> vec2;
+        ASSERT_TRUE_MSG(stream.fail(), "Stream input of a malformed number")
+
+        stream.clear();
+        stream.precision(17);
+        stream.str("");
+        stream << vec;
+        UnbufferedInput unbuffered(std::to_string(vec.size()) + "\n" + stream.str() + "1 -0.5\t2 7");
+        std::istream input(&unbuffered);
+        input >> vec2;
+        ASSERT_EQUAL_MSG(vec, vec2, "Stream input without a get area")
+        input >> vec2;
+        ASSERT_TRUE_MSG(input && vec2.size() == 1 && vec2[0] == -0.5, "Stream input without a get area")
+        input >> vec2;
+        ASSERT_TRUE_MSG(input.fail() && input.eof(), "Stream input without a get area")
+
+        std::stringstream binary(std::ios::in | std::ios::out | std::ios::binary);
+        writeBinary(binary, vec);
+        writeBinary(binary, std::vector<double>());
+        readBinary(binary, vec2);
+        ASSERT_EQUAL_MSG(vec, vec2, "Binary round trip")
+        readBinary(binary, vec2);
+        ASSERT_TRUE_MSG(binary && vec2.empty(), "Binary round trip of an empty vector")
+    }
+
+    // Numbers longer than the output buffer go through the stream. At the lower precision only
+    // 1e300 is too long, the others fill the buffer one at a time.
+    for (int precision : {16100, 20000}) {
+        std::vector<double> vec = {1e300, -0.1, 2.5, 1e-300};
+        std::ostringstream expected, out;
+        expected << std::fixed << std::setprecision(precision);
+        out << std::fixed << std::setprecision(precision);
+        for (double value : vec) {
+            expected << value << ' ';
+        }
+        expected << '\n';
+        out << vec;
+        ASSERT_TRUE_MSG(out.str() == expected.str(), "Stream output longer than the buffer")
+    }
+
 }